@@ -55,11 +55,13 @@ class Id:
     EE_TERMINATED_TYPE = Literal["ee.terminated"]
     EE_USER_CANCEL_TYPE = Literal["ee.user_cancel"]
     EE_USER_DONE_TYPE = Literal["ee.user_done"]
+    EE_SUBSCRIBE_TYPE = Literal["ee.subscribe"]
     EE_SNAPSHOT: Final = "ee.snapshot"
     EE_SNAPSHOT_UPDATE: Final = "ee.snapshot_update"
     EE_TERMINATED: Final = "ee.terminated"
     EE_USER_CANCEL: Final = "ee.user_cancel"
     EE_USER_DONE: Final = "ee.user_done"
+    EE_SUBSCRIBE: Final = "ee.subscribe"
 
 
 class BaseEvent(BaseModel):
@@ -195,6 +197,16 @@ class EEUserDone(BaseEvent):
     monitor: str
 
 
+class EESubscribe(BaseEvent):
+    """Sent by a monitor to receive snapshot updates as compact deltas, see
+    ert.ensemble_evaluator.snapshot_delta, at most once every update_interval
+    seconds. Updates made in between are merged into the next delta."""
+
+    event_type: Id.EE_SUBSCRIBE_TYPE = Id.EE_SUBSCRIBE
+    monitor: str
+    update_interval: float = 0.0
+
+
 FMEvent = (
     ForwardModelStepStart
     | ForwardModelStepRunning
@@ -216,7 +228,14 @@ class EEUserDone(BaseEvent):
 
 EnsembleEvent = EnsembleStarted | EnsembleSucceeded | EnsembleFailed | EnsembleCancelled
 
-EEEvent = EESnapshot | EESnapshotUpdate | EETerminated | EEUserCancel | EEUserDone
+EEEvent = (
+    EESnapshot
+    | EESnapshotUpdate
+    | EETerminated
+    | EEUserCancel
+    | EEUserDone
+    | EESubscribe
+)
 
 Event = FMEvent | ForwardModelStepChecksum | RealizationEvent | EEEvent | EnsembleEvent
 
@@ -91,7 +91,7 @@ async def connect(self) -> None:
             self.term()
             raise
 
-    async def process_message(self, msg: str) -> None:
+    async def process_message(self, msg: bytes) -> None:
         raise NotImplementedError("Only monitor can receive messages!")
 
     async def _receiver(self) -> None:
@@ -113,7 +113,7 @@ async def _receiver(self) -> None:
                         )
                     last_heartbeat_time = asyncio.get_running_loop().time()
                 else:
-                    await self.process_message(raw_msg.decode("utf-8"))
+                    await self.process_message(raw_msg)
             except zmq.ZMQError as exc:
                 logger.debug(
                     f"{self.dealer_id} connection to evaluator went down, reconnecting: {exc}"
@@ -37,18 +37,20 @@ def _setup_reporters(
     dispatch_url,
     ee_token=None,
     experiment_id=None,
+    telemetry=reporting.TelemetryMode.FULL,
 ) -> list[reporting.Reporter]:
     reporters: list[reporting.Reporter] = []
+    dump_running_status = telemetry == reporting.TelemetryMode.FULL
     if is_interactive_run:
         reporters.append(reporting.Interactive())
     elif ens_id and experiment_id is None:
-        reporters.append(reporting.File())
+        reporters.append(reporting.File(dump_running_status))
         if dispatch_url is not None:
             reporters.append(
                 reporting.Event(evaluator_url=dispatch_url, token=ee_token)
             )
     else:
-        reporters.append(reporting.File())
+        reporters.append(reporting.File(dump_running_status))
     return reporters
 
 
@@ -178,6 +180,9 @@ def fm_dispatch(args):
     ens_id = fm_description.get("ens_id")
     ee_token = fm_description.get("ee_token")
     dispatch_url = fm_description.get("dispatch_url")
+    telemetry = reporting.TelemetryMode(
+        fm_description.get("telemetry") or reporting.TelemetryMode.FULL
+    )
 
     is_interactive_run = len(parsed_args.steps) > 0
     reporters = _setup_reporters(
@@ -186,6 +191,7 @@ def fm_dispatch(args):
         dispatch_url,
         ee_token,
         experiment_id,
+        telemetry,
     )
 
     fm_runner = ForwardModelRunner(fm_description)
@@ -197,7 +203,10 @@ def sigterm_handler(_signo, _stack_frame):
         _stop_reporters_and_sigkill(reporters, exited_event)
 
     signal.signal(signal.SIGTERM, sigterm_handler)
-    _report_all_messages(fm_runner.run(parsed_args.steps), reporters)
+    _report_all_messages(
+        reporting.filter_telemetry(fm_runner.run(parsed_args.steps), telemetry),
+        reporters,
+    )
 
 
 def main():
@@ -7,10 +7,13 @@
 from .event import Event
 from .file import File
 from .interactive import Interactive
+from .telemetry import TelemetryMode, filter_telemetry
 
 __all__ = [
     "Event",
     "File",
     "Interactive",
     "Reporter",
+    "TelemetryMode",
+    "filter_telemetry",
 ]
@@ -35,9 +35,12 @@
 
 
 class File(Reporter):
-    def __init__(self):
+    def __init__(self, dump_running_status: bool = True):
+        """If dump_running_status is False, status.json is only rewritten when
+        a step changes state, and not for each sample of a running step"""
         self.status_dict = {}
         self.node = socket.gethostname()
+        self._dump_running_status = dump_running_status
 
     def report(self, msg: Message):
         fm_step_status = {}
@@ -117,7 +120,8 @@ def report(self, msg: Message):
                     msg.timestamp
                 )
                 self._dump_ok_file()
-        self._dump_status_json()
+        if self._dump_running_status or not isinstance(msg, Running):
+            self._dump_status_json()
 
     @staticmethod
     def _delete_old_status_files():
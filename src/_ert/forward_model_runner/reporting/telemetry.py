@@ -0,0 +1,95 @@
+"""
+Control over how much the forward model steps report on their memory and CPU
+usage while they run.
+
+A running step is sampled every ``ForwardModelStep.MEMORY_POLL_PERIOD``
+seconds, and each sample is a :class:`Running` message. With
+``TelemetryMode.FULL`` every sample is sent to the evaluator and status.json
+is rewritten for each of them. The other modes send fewer samples, and only
+rewrite status.json when a step changes state:
+
+* ``CHANGES`` sends a sample when the peak memory usage has grown, the
+  current memory usage has changed by more than ``MEMORY_CHANGE_THRESHOLD``
+  since the last sample sent, or ``HEARTBEAT_INTERVAL`` seconds have passed
+  since the last sample sent.
+* ``PEAKS`` sends the first sample of a step, so that it is seen running,
+  and after that only the samples where the peak memory usage has grown. The
+  CPU time of the step is aggregated by the samples, and the last one is sent
+  when the step exits.
+
+In both modes the last sample of a step is always sent before it exits, so the
+reported peaks are the same as with ``FULL``.
+"""
+
+from __future__ import annotations
+
+from collections.abc import Generator, Iterable
+from enum import StrEnum
+from typing import Final
+
+from .message import Exited, Message, Running, Start
+
+MEMORY_CHANGE_THRESHOLD: Final = 0.1
+HEARTBEAT_INTERVAL: Final = 60.0
+
+
+class TelemetryMode(StrEnum):
+    FULL = "FULL"
+    CHANGES = "CHANGES"
+    PEAKS = "PEAKS"
+
+
+def _has_changed(sample: Running, last_sent: Running | None) -> bool:
+    if last_sent is None:
+        return True
+    status, sent_status = sample.memory_status, last_sent.memory_status
+    if (status.max_rss or 0) > (sent_status.max_rss or 0):
+        return True
+    rss, sent_rss = status.rss or 0, sent_status.rss or 0
+    if abs(rss - sent_rss) > MEMORY_CHANGE_THRESHOLD * sent_rss:
+        return True
+    return (
+        sample.timestamp - last_sent.timestamp
+    ).total_seconds() >= HEARTBEAT_INTERVAL
+
+
+def _peak_has_grown(sample: Running, last_sent: Running | None) -> bool:
+    if last_sent is None:
+        return True
+    return (sample.memory_status.max_rss or 0) > (
+        last_sent.memory_status.max_rss or 0
+    )
+
+
+def _should_send(
+    sample: Running, last_sent: Running | None, mode: TelemetryMode
+) -> bool:
+    if mode == TelemetryMode.CHANGES:
+        return _has_changed(sample, last_sent)
+    return _peak_has_grown(sample, last_sent)
+
+
+def filter_telemetry(
+    messages: Iterable[Message], mode: TelemetryMode
+) -> Generator[Message]:
+    """Drop the Running messages that should not be reported with the given
+    mode, passing all other messages through in order"""
+    if mode == TelemetryMode.FULL:
+        yield from messages
+        return
+
+    last_sent: Running | None = None
+    unsent: Running | None = None
+    for msg in messages:
+        if isinstance(msg, Running):
+            if _should_send(msg, last_sent, mode):
+                last_sent, unsent = msg, None
+                yield msg
+            else:
+                unsent = msg
+            continue
+        if isinstance(msg, Exited) and unsent is not None:
+            yield unsent
+        if isinstance(msg, Start | Exited):
+            last_sent, unsent = None, None
+        yield msg
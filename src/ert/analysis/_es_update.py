@@ -2,11 +2,23 @@
 
 import functools
 import logging
+import multiprocessing
+import tempfile
 import time
+from collections import deque
 from collections.abc import Callable, Iterable, Sequence
+from concurrent.futures import (
+    FIRST_COMPLETED,
+    Future,
+    ProcessPoolExecutor,
+    ThreadPoolExecutor,
+    wait,
+)
 from fnmatch import fnmatch
+from pathlib import Path
 from typing import (
     TYPE_CHECKING,
+    Any,
     Generic,
     Self,
     TypeVar,
@@ -19,7 +31,15 @@
 import scipy
 from iterative_ensemble_smoother.experimental import AdaptiveESMDA
 
-from ert.config import ESSettings, GenKwConfig, ObservationGroups, UpdateSettings
+from ert.config import (
+    AutoScaleMethod,
+    ESSettings,
+    GenKwConfig,
+    ObservationGroups,
+    ParameterConfig,
+    UpdateSettings,
+)
+from ert.trace import trace, tracer, with_current_context
 
 from . import misfit_preprocessor
 from .event import (
@@ -31,6 +51,12 @@
     AnalysisTimeEvent,
     DataSection,
 )
+from ._update_cache import (
+    CachedUpdate,
+    load_cached_update,
+    save_cached_update,
+    update_cache_key,
+)
 from .snapshots import (
     ObservationAndResponseSnapshot,
     SmootherSnapshot,
@@ -125,7 +151,7 @@ def _load_param_ensemble_array(
     ensemble: Ensemble,
     param_group: str,
     iens_active_index: npt.NDArray[np.int_],
-) -> npt.NDArray[np.float64]:
+) -> npt.NDArray[np.floating[Any]]:
     config_node = ensemble.experiment.parameter_configuration[param_group]
     return config_node.load_parameters(ensemble, iens_active_index)
 
@@ -161,6 +187,7 @@ def _load_observations_and_responses(
     selected_observations: Iterable[str],
     auto_scale_observations: list[ObservationGroups] | None,
     progress_callback: Callable[[AnalysisEvent], None],
+    auto_scale_method: AutoScaleMethod = "hierarchical",
 ) -> tuple[
     npt.NDArray[np.float64],
     tuple[
@@ -215,7 +242,7 @@ def _load_observations_and_responses(
                 logger.error(f"No observations active for group: {input_group}")
                 continue
             scaling_factors, clusters, nr_components = misfit_preprocessor.main(
-                S[obs_group_mask], scaled_errors[obs_group_mask]
+                S[obs_group_mask], scaled_errors[obs_group_mask], auto_scale_method
             )
             scaling[obs_group_mask] *= scaling_factors
 
@@ -424,6 +451,293 @@ def _copy_unupdated_parameters(
             target_ensemble.save_parameters(parameter_group, realization, ds)
 
 
+def _pipelined_update(
+    parameter_groups: Sequence[str],
+    load: Callable[[str], npt.NDArray[np.floating[Any]]],
+    update: Callable[
+        [str, npt.NDArray[np.floating[Any]]], npt.NDArray[np.floating[Any]]
+    ],
+    save: Callable[[str, npt.NDArray[np.floating[Any]]], None],
+    max_concurrent_groups: int,
+    progress_callback: Callable[[AnalysisEvent], None],
+) -> None:
+    """Updates the parameter groups one at a time, while the next group is
+    loaded and the previous groups are saved in background threads.
+
+    At most max_concurrent_groups groups are held in memory at once, counting
+    the group being updated, the one being prefetched and those being saved.
+    With max_concurrent_groups=1 the groups are loaded, updated and saved
+    strictly one after another.
+    """
+    prefetch = max_concurrent_groups > 1
+    with ThreadPoolExecutor(
+        max_workers=max(max_concurrent_groups - 1, 1),
+        thread_name_prefix="es_update",
+    ) as executor:
+        pending_saves: deque[Future[None]] = deque()
+        next_load: Future[npt.NDArray[np.floating[Any]]] | None = None
+        for i, param_group in enumerate(parameter_groups):
+            param_ensemble_array = (
+                next_load.result() if next_load is not None else load(param_group)
+            )
+            next_load = None
+            while pending_saves and (
+                len(pending_saves) + 1 + int(prefetch) > max_concurrent_groups
+            ):
+                pending_saves.popleft().result()
+            if prefetch and i + 1 < len(parameter_groups):
+                next_load = executor.submit(
+                    with_current_context(load), parameter_groups[i + 1]
+                )
+
+            param_ensemble_array = update(param_group, param_ensemble_array)
+
+            log_msg = f"Storing data for {param_group}.."
+            logger.info(log_msg)
+            progress_callback(AnalysisStatusEvent(msg=log_msg))
+            if prefetch:
+                pending_saves.append(
+                    executor.submit(
+                        with_current_context(save), param_group, param_ensemble_array
+                    )
+                )
+            else:
+                save(param_group, param_ensemble_array)
+            del param_ensemble_array
+
+        for pending_save in pending_saves:
+            pending_save.result()
+
+
+class _BatchAssimilator:
+    """Runs adaptive localization on one batch of parameters, and keeps only
+    the cross-correlations above the correlation threshold as (parameter,
+    response, correlation) triplets."""
+
+    ARRAYS = ("Y", "D", "cov_YY")
+
+    def __init__(
+        self,
+        smoother: AdaptiveESMDA,
+        Y: npt.NDArray[np.float64],
+        D: npt.NDArray[np.float64],
+        cov_YY: npt.NDArray[np.float64],
+        correlation_threshold: float,
+    ) -> None:
+        self._smoother = smoother
+        self._Y = Y
+        self._D = D
+        self._cov_YY = cov_YY
+        self._correlation_threshold = correlation_threshold
+
+    def save_arrays(self, directory: Path) -> tuple[AdaptiveESMDA, Path, float]:
+        """Saves the responses, perturbed observations and response covariance
+        to directory, and returns the arguments of
+        :func:`_init_localization_worker` that memory-map them, so that the
+        worker processes share the arrays instead of each receiving a pickled
+        copy."""
+        for name in self.ARRAYS:
+            np.save(directory / f"{name}.npy", getattr(self, f"_{name}"))
+        return self._smoother, directory, self._correlation_threshold
+
+    @classmethod
+    def load_arrays(
+        cls, smoother: AdaptiveESMDA, directory: Path, correlation_threshold: float
+    ) -> _BatchAssimilator:
+        Y, D, cov_YY = (
+            np.load(directory / f"{name}.npy", mmap_mode="r") for name in cls.ARRAYS
+        )
+        return cls(smoother, Y, D, cov_YY, correlation_threshold)
+
+    def __call__(
+        self,
+        X_local: npt.NDArray[np.floating[Any]],
+        progress_callback: Callable[[Sequence[Any]], Iterable[Any]] | None = None,
+    ) -> tuple[
+        npt.NDArray[np.floating[Any]],
+        npt.NDArray[np.int_],
+        npt.NDArray[np.int_],
+        npt.NDArray[np.float32],
+    ]:
+        correlations: list[npt.NDArray[np.float64]] = []
+        X_updated = self._smoother.assimilate(
+            X=X_local,
+            Y=self._Y,
+            D=self._D,
+            alpha=1.0,  # The user is responsible for scaling observation covariance (esmda usage)
+            correlation_threshold=self._correlation_threshold,
+            cov_YY=self._cov_YY,
+            progress_callback=progress_callback,
+            correlation_callback=correlations.append,
+        )
+        corr_XY = (
+            np.vstack(correlations)
+            if correlations
+            else np.empty((0, self._Y.shape[0]))
+        )
+        parameters, responses = np.nonzero(
+            np.abs(corr_XY) > self._correlation_threshold
+        )
+        return (
+            X_updated,
+            parameters,
+            responses,
+            corr_XY[parameters, responses].astype(np.float32),
+        )
+
+
+_worker_assimilator: _BatchAssimilator | None = None
+
+
+def _init_localization_worker(
+    smoother: AdaptiveESMDA, directory: Path, correlation_threshold: float
+) -> None:
+    global _worker_assimilator  # noqa: PLW0603
+    _worker_assimilator = _BatchAssimilator.load_arrays(
+        smoother, directory, correlation_threshold
+    )
+
+
+def _assimilate_in_worker(
+    X_local: npt.NDArray[np.floating[Any]],
+) -> tuple[
+    npt.NDArray[np.floating[Any]],
+    npt.NDArray[np.int_],
+    npt.NDArray[np.int_],
+    npt.NDArray[np.float32],
+]:
+    assert _worker_assimilator is not None
+    return _worker_assimilator(X_local)
+
+
+def _streaming_localization(
+    param_ensemble_array: npt.NDArray[np.floating[Any]],
+    batches: list[npt.NDArray[np.int_]],
+    assimilator: _BatchAssimilator,
+    processes: int,
+    save_batch: Callable[
+        [
+            int,
+            npt.NDArray[np.int_],
+            npt.NDArray[np.int_],
+            npt.NDArray[np.int_],
+            npt.NDArray[np.float32],
+        ],
+        None,
+    ],
+    progress_callback: Callable[[Sequence[Any]], Iterable[Any]] | None = None,
+) -> None:
+    """Updates param_ensemble_array in place batch by batch, and hands the
+    significant correlations of each batch to save_batch as soon as the batch
+    is done, so that the dense correlations are never held for more than one
+    batch per process.
+
+    With more than one process, the batches are assimilated in worker
+    processes, with at most two batches queued per process. The workers
+    memory-map the arrays shared by all batches from a temporary directory,
+    and progress_callback then times the batches rather than the parameters
+    within each batch.
+    """
+    if processes == 1:
+        for batch, param_batch_idx in enumerate(batches):
+            X_updated, parameters, responses, correlations = assimilator(
+                param_ensemble_array[param_batch_idx, :], progress_callback
+            )
+            param_ensemble_array[param_batch_idx, :] = X_updated
+            save_batch(batch, param_batch_idx, parameters, responses, correlations)
+        return
+
+    with (
+        tempfile.TemporaryDirectory(prefix="localization") as directory,
+        ProcessPoolExecutor(
+            max_workers=processes,
+            mp_context=multiprocessing.get_context("spawn"),
+            initializer=_init_localization_worker,
+            initargs=assimilator.save_arrays(Path(directory)),
+        ) as executor,
+    ):
+        pending: dict[Future[Any], tuple[int, npt.NDArray[np.int_]]] = {}
+
+        def collect(futures: Iterable[Future[Any]]) -> None:
+            for future in futures:
+                batch, param_batch_idx = pending.pop(future)
+                X_updated, parameters, responses, correlations = future.result()
+                param_ensemble_array[param_batch_idx, :] = X_updated
+                save_batch(
+                    batch, param_batch_idx, parameters, responses, correlations
+                )
+
+        # Submitting waits for a batch to finish once the queue is full, so
+        # timing the submissions follows the progress of the batches
+        timed_batches = (
+            progress_callback(batches) if progress_callback is not None else batches
+        )
+        for batch, param_batch_idx in enumerate(timed_batches):
+            if len(pending) >= 2 * processes:
+                done, _ = wait(pending, return_when=FIRST_COMPLETED)
+                collect(done)
+            future = executor.submit(
+                _assimilate_in_worker, param_ensemble_array[param_batch_idx, :]
+            )
+            pending[future] = (batch, param_batch_idx)
+        collect(list(pending))
+
+
+def _parameter_names(config_node: ParameterConfig) -> list[str] | None:
+    if isinstance(config_node, GenKwConfig):
+        return [
+            t["name"]  # type: ignore
+            for t in config_node.transform_function_definitions
+        ]
+    return None
+
+
+def _save_sparse_cross_correlations(
+    ensemble: Ensemble,
+    param_group: str,
+    parameter_names: list[str] | None,
+    observations: list[ObservationAndResponseSnapshot],
+    batch: int,
+    param_batch_idx: npt.NDArray[np.int_],
+    parameters: npt.NDArray[np.int_],
+    responses: npt.NDArray[np.int_],
+    correlations: npt.NDArray[np.float32],
+) -> None:
+    parameter_index = param_batch_idx[parameters]
+    ensemble.save_sparse_cross_correlations(
+        param_group,
+        batch,
+        pl.DataFrame(
+            {
+                "parameter_index": pl.Series(parameter_index, dtype=pl.UInt32),
+                "parameter": pl.Series(
+                    [parameter_names[i] for i in parameter_index]
+                    if parameter_names is not None
+                    else [None] * len(parameter_index),
+                    dtype=pl.String,
+                ),
+                "observation_key": pl.Series(
+                    [observations[i].obs_name for i in responses], dtype=pl.String
+                ),
+                "index": pl.Series(
+                    [observations[i].index for i in responses], dtype=pl.String
+                ),
+                "correlation": pl.Series(correlations, dtype=pl.Float32),
+            }
+        ),
+    )
+
+
+def _set_parameter_group_attributes(
+    param_group: str, param_ensemble_array: npt.NDArray[np.floating[Any]]
+) -> None:
+    current_span = trace.get_current_span()
+    current_span.set_attribute("ert.parameter_group", param_group)
+    current_span.set_attribute("ert.parameter_count", param_ensemble_array.shape[0])
+    current_span.set_attribute("ert.bytes", param_ensemble_array.nbytes)
+
+
+@tracer.start_as_current_span(f"{__name__}.analysis_ES")
 def analysis_ES(
     parameters: Iterable[str],
     observations: Iterable[str],
@@ -438,37 +752,76 @@ def analysis_ES(
     target_ensemble: Ensemble,
     progress_callback: Callable[[AnalysisEvent], None],
     auto_scale_observations: list[ObservationGroups] | None,
+    auto_scale_method: AutoScaleMethod = "hierarchical",
 ) -> None:
     iens_active_index = np.flatnonzero(ens_mask)
 
     ensemble_size = ens_mask.sum()
+    current_span = trace.get_current_span()
+    current_span.set_attribute("ert.realization_count", int(ensemble_size))
 
     def adaptive_localization_progress_callback(
         iterable: Sequence[T],
     ) -> TimedIterator[T]:
         return TimedIterator(iterable, progress_callback)
 
-    progress_callback(AnalysisStatusEvent(msg="Loading observations and responses.."))
-    (
-        S,
-        (
-            observation_values,
-            observation_errors,
-            update_snapshot,
-        ),
-    ) = _load_observations_and_responses(
+    observations = list(observations)
+    cache_key = update_cache_key(
         source_ensemble,
+        iens_active_index,
+        observations,
+        module,
         alpha,
         std_cutoff,
         global_scaling,
-        iens_active_index,
-        observations,
         auto_scale_observations,
-        progress_callback,
+        auto_scale_method,
+        rng,
     )
+    cached = (
+        load_cached_update(cache_key, source_ensemble)
+        if module.cache_update
+        else None
+    )
+    if cached is not None:
+        progress_callback(
+            AnalysisStatusEvent(msg="Reusing cached observations and responses..")
+        )
+        S = cached.S
+        observation_values = cached.observation_values
+        observation_errors = cached.observation_errors
+        update_snapshot = cached.update_snapshot
+    else:
+        progress_callback(
+            AnalysisStatusEvent(msg="Loading observations and responses..")
+        )
+        (
+            S,
+            (
+                observation_values,
+                observation_errors,
+                update_snapshot,
+            ),
+        ) = _load_observations_and_responses(
+            source_ensemble,
+            alpha,
+            std_cutoff,
+            global_scaling,
+            iens_active_index,
+            observations,
+            auto_scale_observations,
+            progress_callback,
+            auto_scale_method,
+        )
     num_obs = len(observation_values)
+    current_span.set_attribute("ert.observation_count", num_obs)
 
     smoother_snapshot.update_step_snapshots = update_snapshot
+    active_observations = [
+        snapshot
+        for snapshot in update_snapshot
+        if snapshot.response_mean_mask and snapshot.response_std_mask
+    ]
 
     if num_obs == 0:
         msg = "No active observations for update step"
@@ -500,13 +853,21 @@ def adaptive_localization_progress_callback(
             seed=rng,
         )
 
-        # Pre-calculate cov_YY
-        cov_YY = np.atleast_2d(np.cov(S))
+        if cached is not None:
+            assert cached.cov_YY is not None
+            assert cached.D is not None
+            cov_YY, D = cached.cov_YY, cached.D
+        else:
+            # Pre-calculate cov_YY
+            cov_YY = np.atleast_2d(np.cov(S))
 
-        D = smoother_adaptive_es.perturb_observations(
-            ensemble_size=ensemble_size, alpha=1.0
-        )
+            D = smoother_adaptive_es.perturb_observations(
+                ensemble_size=ensemble_size, alpha=1.0
+            )
 
+    elif cached is not None:
+        assert cached.T is not None
+        T = cached.T
     else:
         # Compute transition matrix so that
         # X_posterior = X_prior @ T
@@ -533,22 +894,48 @@ def adaptive_localization_progress_callback(
         # Add identity in place for fast computation
         np.fill_diagonal(T, T.diagonal() + 1)
 
+    if cached is None:
+        cached = CachedUpdate(
+            S=S,
+            observation_values=observation_values,
+            observation_errors=observation_errors,
+            update_snapshot=update_snapshot,
+            rng_state=rng.bit_generator.state,
+            **({"cov_YY": cov_YY, "D": D} if module.localization else {"T": T}),
+        )
+    else:
+        rng.bit_generator.state = cached.rng_state
+    if module.cache_update:
+        save_cached_update(cache_key, cached, target_ensemble)
+
     def correlation_callback(
         cross_correlations_of_batch: npt.NDArray[np.float64],
         cross_correlations_accumulator: list[npt.NDArray[np.float64]],
     ) -> None:
         cross_correlations_accumulator.append(cross_correlations_of_batch)
 
-    for param_group in parameters:
+    @tracer.start_as_current_span(f"{__name__}.load_group")
+    def load_group(param_group: str) -> npt.NDArray[np.floating[Any]]:
         param_ensemble_array = _load_param_ensemble_array(
             source_ensemble, param_group, iens_active_index
         )
+        _set_parameter_group_attributes(param_group, param_ensemble_array)
+        return param_ensemble_array
+
+    @tracer.start_as_current_span(f"{__name__}.update_group")
+    def update_group(
+        param_group: str, param_ensemble_array: npt.NDArray[np.floating[Any]]
+    ) -> npt.NDArray[np.floating[Any]]:
+        _set_parameter_group_attributes(param_group, param_ensemble_array)
         if module.localization:
             config_node = source_ensemble.experiment.parameter_configuration[
                 param_group
             ]
             num_params = param_ensemble_array.shape[0]
             batch_size = _calculate_adaptive_batch_size(num_params, num_obs)
+            if module.streaming_localization:
+                # Every process holds the dense correlations of its own batch
+                batch_size = max(batch_size // module.localization_processes, 1)
             batches = _split_by_batchsize(np.arange(0, num_params), batch_size)
 
             log_msg = f"Running localization on {num_params} parameters, {num_obs} responses, {ensemble_size} realizations and {len(batches)} batches"
@@ -556,42 +943,68 @@ def correlation_callback(
             progress_callback(AnalysisStatusEvent(msg=log_msg))
 
             start = time.time()
-            cross_correlations: list[npt.NDArray[np.float64]] = []
-            for param_batch_idx in batches:
-                X_local = param_ensemble_array[param_batch_idx, :]
-                if isinstance(config_node, GenKwConfig):
-                    correlation_batch_callback = functools.partial(
-                        correlation_callback,
-                        cross_correlations_accumulator=cross_correlations,
-                    )
-                else:
-                    correlation_batch_callback = None
-                param_ensemble_array[param_batch_idx, :] = (
-                    smoother_adaptive_es.assimilate(
-                        X=X_local,
-                        Y=S,
-                        D=D,
-                        alpha=1.0,  # The user is responsible for scaling observation covariance (esmda usage)
-                        correlation_threshold=module.correlation_threshold,
-                        cov_YY=cov_YY,
-                        progress_callback=adaptive_localization_progress_callback,
-                        correlation_callback=correlation_batch_callback,
-                    )
-                )
-
-            if cross_correlations:
-                assert isinstance(config_node, GenKwConfig)
-                parameter_names = [
-                    t["name"]  # type: ignore
-                    for t in config_node.transform_function_definitions
-                ]
-                cross_correlations_ = np.vstack(cross_correlations)
-                if cross_correlations_.size != 0:
-                    source_ensemble.save_cross_correlations(
-                        cross_correlations_,
+            if not param_ensemble_array.flags.writeable:
+                # Memory-mapped parameters are read-only, and localization
+                # updates the batches in place
+                param_ensemble_array = np.array(param_ensemble_array)
+            if module.streaming_localization:
+                _streaming_localization(
+                    param_ensemble_array,
+                    batches,
+                    _BatchAssimilator(
+                        smoother_adaptive_es,
+                        S,
+                        D,
+                        cov_YY,
+                        module.correlation_threshold(ensemble_size),
+                    ),
+                    module.localization_processes,
+                    functools.partial(
+                        _save_sparse_cross_correlations,
+                        source_ensemble,
                         param_group,
-                        parameter_names[: cross_correlations_.shape[0]],
+                        _parameter_names(config_node),
+                        active_observations,
+                    ),
+                    adaptive_localization_progress_callback,
+                )
+            else:
+                cross_correlations: list[npt.NDArray[np.float64]] = []
+                for param_batch_idx in batches:
+                    X_local = param_ensemble_array[param_batch_idx, :]
+                    if isinstance(config_node, GenKwConfig):
+                        correlation_batch_callback = functools.partial(
+                            correlation_callback,
+                            cross_correlations_accumulator=cross_correlations,
+                        )
+                    else:
+                        correlation_batch_callback = None
+                    param_ensemble_array[param_batch_idx, :] = (
+                        smoother_adaptive_es.assimilate(
+                            X=X_local,
+                            Y=S,
+                            D=D,
+                            alpha=1.0,  # The user is responsible for scaling observation covariance (esmda usage)
+                            correlation_threshold=module.correlation_threshold,
+                            cov_YY=cov_YY,
+                            progress_callback=adaptive_localization_progress_callback,
+                            correlation_callback=correlation_batch_callback,
+                        )
                     )
+
+                if cross_correlations:
+                    assert isinstance(config_node, GenKwConfig)
+                    parameter_names = [
+                        t["name"]  # type: ignore
+                        for t in config_node.transform_function_definitions
+                    ]
+                    cross_correlations_ = np.vstack(cross_correlations)
+                    if cross_correlations_.size != 0:
+                        source_ensemble.save_cross_correlations(
+                            cross_correlations_,
+                            param_group,
+                            parameter_names[: cross_correlations_.shape[0]],
+                        )
             logger.info(
                 f"Adaptive Localization of {param_group} completed in {(time.time() - start) / 60} minutes"
             )
@@ -601,12 +1014,14 @@ def correlation_callback(
             param_ensemble_array = param_ensemble_array @ T.astype(  # noqa: PLR6104
                 param_ensemble_array.dtype
             )
+        return param_ensemble_array
 
-        log_msg = f"Storing data for {param_group}.."
-        logger.info(log_msg)
-        progress_callback(AnalysisStatusEvent(msg=log_msg))
+    @tracer.start_as_current_span(f"{__name__}.save_group")
+    def save_group(
+        param_group: str, param_ensemble_array: npt.NDArray[np.floating[Any]]
+    ) -> None:
+        _set_parameter_group_attributes(param_group, param_ensemble_array)
         start = time.time()
-
         _save_param_ensemble_array_to_disk(
             target_ensemble, param_ensemble_array, param_group, iens_active_index
         )
@@ -614,13 +1029,24 @@ def correlation_callback(
             f"Storing data for {param_group} completed in {(time.time() - start) / 60} minutes"
         )
 
-        _copy_unupdated_parameters(
-            list(source_ensemble.experiment.parameter_configuration.keys()),
-            parameters,
-            iens_active_index,
-            source_ensemble,
-            target_ensemble,
-        )
+    parameters = list(parameters)
+    current_span.set_attribute("ert.parameter_group_count", len(parameters))
+    _pipelined_update(
+        parameters,
+        load_group,
+        update_group,
+        save_group,
+        module.max_concurrent_param_groups,
+        progress_callback,
+    )
+
+    _copy_unupdated_parameters(
+        list(source_ensemble.experiment.parameter_configuration.keys()),
+        parameters,
+        iens_active_index,
+        source_ensemble,
+        target_ensemble,
+    )
 
 
 def _create_smoother_snapshot(
@@ -679,6 +1105,7 @@ def smoother_update(
             posterior_storage,
             progress_callback,
             update_settings.auto_scale_observations,
+            update_settings.auto_scale_method,
         )
     except Exception as e:
         progress_callback(
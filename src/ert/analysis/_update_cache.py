@@ -0,0 +1,140 @@
+"""
+Cache of the observation-dependent parts of the update.
+
+The responses and observations loaded by the update, and the matrices derived
+from them (the covariance of the responses, the perturbed observations and
+the transition matrix), only depend on the prior ensemble, the active
+realizations, the selected observations, the update settings and the state of
+the random generator. With CACHE_UPDATE they are persisted in the posterior
+ensemble, so that re-running an update from the same prior, for instance with
+a different set of parameters, skips loading the responses and inverting.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import json
+import logging
+from dataclasses import dataclass
+from typing import TYPE_CHECKING, Any
+
+import numpy as np
+from pydantic import TypeAdapter
+
+from .snapshots import ObservationAndResponseSnapshot
+
+if TYPE_CHECKING:
+    from collections.abc import Iterable
+
+    import numpy.typing as npt
+
+    from ert.config import AutoScaleMethod, ESSettings, ObservationGroups
+    from ert.storage import Ensemble
+
+logger = logging.getLogger(__name__)
+
+_snapshots_adapter = TypeAdapter(list[ObservationAndResponseSnapshot])
+
+
+@dataclass
+class CachedUpdate:
+    S: npt.NDArray[np.float64]
+    observation_values: npt.NDArray[np.float64]
+    observation_errors: npt.NDArray[np.float64]
+    update_snapshot: list[ObservationAndResponseSnapshot]
+    rng_state: dict[str, Any]
+    """State of the random generator after the update, restored on a cache hit
+    so that the generator is left as if the update had been computed."""
+    T: npt.NDArray[np.float64] | None = None
+    cov_YY: npt.NDArray[np.float64] | None = None
+    D: npt.NDArray[np.float64] | None = None
+
+    def to_arrays(self) -> dict[str, npt.NDArray[Any]]:
+        arrays: dict[str, npt.NDArray[Any]] = {
+            "S": self.S,
+            "observation_values": self.observation_values,
+            "observation_errors": self.observation_errors,
+            "update_snapshot": np.array(
+                _snapshots_adapter.dump_json(self.update_snapshot).decode("utf-8")
+            ),
+            "rng_state": np.array(json.dumps(self.rng_state, default=_to_list)),
+        }
+        for name in ("T", "cov_YY", "D"):
+            if (value := getattr(self, name)) is not None:
+                arrays[name] = value
+        return arrays
+
+    @classmethod
+    def from_arrays(cls, arrays: dict[str, npt.NDArray[Any]]) -> CachedUpdate:
+        return cls(
+            S=arrays["S"],
+            observation_values=arrays["observation_values"],
+            observation_errors=arrays["observation_errors"],
+            update_snapshot=_snapshots_adapter.validate_json(
+                str(arrays["update_snapshot"])
+            ),
+            rng_state=json.loads(str(arrays["rng_state"])),
+            T=arrays.get("T"),
+            cov_YY=arrays.get("cov_YY"),
+            D=arrays.get("D"),
+        )
+
+
+def _to_list(value: Any) -> Any:
+    if isinstance(value, np.ndarray):
+        return value.tolist()
+    raise TypeError(f"Cannot serialize {type(value).__name__}")
+
+
+def update_cache_key(
+    source_ensemble: Ensemble,
+    iens_active_index: npt.NDArray[np.int_],
+    observations: Iterable[str],
+    module: ESSettings,
+    alpha: float,
+    std_cutoff: float,
+    global_scaling: float,
+    auto_scale_observations: list[ObservationGroups] | None,
+    auto_scale_method: AutoScaleMethod,
+    rng: np.random.Generator,
+) -> str:
+    key = {
+        "ensemble": str(source_ensemble.id),
+        "realizations": [int(i) for i in iens_active_index],
+        "observations": sorted(observations),
+        "alpha": alpha,
+        "std_cutoff": std_cutoff,
+        "global_scaling": global_scaling,
+        "auto_scale_observations": auto_scale_observations,
+        "auto_scale_method": auto_scale_method,
+        "localization": module.localization,
+        "inversion": module.inversion,
+        "enkf_truncation": module.enkf_truncation,
+        "rng": rng.bit_generator.state,
+    }
+    return hashlib.sha256(
+        json.dumps(key, sort_keys=True, default=_to_list).encode("utf-8")
+    ).hexdigest()
+
+
+def load_cached_update(key: str, source_ensemble: Ensemble) -> CachedUpdate | None:
+    """Look up the update in the ensembles that have previously been updated
+    from source_ensemble."""
+    for ensemble in source_ensemble.experiment.ensembles:
+        if ensemble.parent != source_ensemble.id:
+            continue
+        try:
+            arrays = ensemble.load_update_cache(key)
+        except (OSError, ValueError) as err:
+            logger.warning(f"Ignoring unreadable update cache in {ensemble.name}: {err}")
+            continue
+        if arrays is not None:
+            logger.info(f"Reusing update cached in ensemble {ensemble.name}")
+            return CachedUpdate.from_arrays(arrays)
+    return None
+
+
+def save_cached_update(
+    key: str, cached: CachedUpdate, target_ensemble: Ensemble
+) -> None:
+    target_ensemble.save_update_cache(key, cached.to_arrays())
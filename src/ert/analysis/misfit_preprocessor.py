@@ -3,7 +3,10 @@
 import numpy as np
 import numpy.typing as npt
 from scipy.cluster.hierarchy import fcluster, linkage
-from scipy.stats import spearmanr
+from scipy.cluster.vq import kmeans2
+from scipy.stats import rankdata, spearmanr
+
+from ert.config import AutoScaleMethod
 
 logger = logging.getLogger(__name__)
 
@@ -47,6 +50,98 @@ def get_nr_primary_components(
     return len([1 for i in variance_ratio[:-1] if i < threshold])
 
 
+def _leading_components(
+    data_matrix: npt.NDArray[np.float64],
+) -> tuple[npt.NDArray[np.float64], npt.NDArray[np.float64]]:
+    """
+    Thin SVD of data_matrix through the eigendecomposition of its Gram
+    matrix. data_matrix should be on form (n_realizations, n_observations),
+    and as there are usually far fewer realizations than observations, the
+    cost is linear in the number of observations, and no
+    (n_observations, n_observations) matrix is formed.
+
+    Returns the squared singular values in descending order and the
+    corresponding left singular vectors, omitting null components.
+    """
+    if data_matrix.shape[0] > data_matrix.shape[1]:
+        left, singulars, _ = np.linalg.svd(data_matrix, full_matrices=False)
+        return singulars**2, left
+    eigenvalues, eigenvectors = np.linalg.eigh(data_matrix @ data_matrix.T)
+    order = np.argsort(eigenvalues)[::-1]
+    eigenvalues = eigenvalues[order]
+    keep = eigenvalues > max(eigenvalues[0], 0.0) * np.finfo(np.float64).eps * len(
+        eigenvalues
+    )
+    return eigenvalues[keep], eigenvectors[:, order[keep]]
+
+
+def get_nr_primary_components_scalable(
+    responses: npt.NDArray[np.float64], threshold: float
+) -> int:
+    """
+    Same as get_nr_primary_components, but the variance explained by each
+    principal component is computed from the (n_realizations, n_realizations)
+    Gram matrix, see _leading_components.
+
+    responses should be on form (n_realizations, n_observations)
+    """
+    data_matrix = (responses - responses.mean(axis=0)).astype(float)
+    variances, _ = _leading_components(data_matrix)
+    if len(variances) == 0:
+        return 0
+    variance_ratio = np.cumsum(variances) / np.sum(variances)
+    # Null components all have a cumulative ratio of 1, and are never counted
+    return len([1 for i in variance_ratio[:-1] if i < threshold])
+
+
+def _spearman_embedding(
+    responses: npt.NDArray[np.float64],
+) -> npt.NDArray[np.float64]:
+    """
+    Rows of the Spearman correlation matrix of responses, projected onto the
+    n_realizations directions they span.
+
+    With Z = U S V.T the ranked and normalized responses, the correlation
+    matrix is Z.T @ Z = V S² V.T, and as V has orthonormal columns its rows
+    are as far apart as the rows of V S² = Z.T @ U S.
+    """
+    ranks = rankdata(responses, axis=0)
+    ranks -= ranks.mean(axis=0)
+    norms = np.linalg.norm(ranks, axis=0)
+    normalized = np.divide(ranks, norms, out=np.zeros_like(ranks), where=norms > 0)
+    variances, left = _leading_components(normalized)
+    return normalized.T @ (left * np.sqrt(variances))
+
+
+def cluster_responses_scalable(
+    responses: npt.NDArray[np.float64],
+    nr_clusters: int,
+) -> npt.NDArray[np.int_]:
+    """
+    Cluster responses with k-means on their Spearman correlation profiles.
+
+    cluster_responses clusters the rows of the (n_observations, n_observations)
+    Spearman correlation matrix by euclidean distance. The rows of that
+    matrix have an (n_observations, n_realizations) embedding with the same
+    euclidean distances between observations, see _spearman_embedding, and
+    k-means on this embedding is linear in the number of observations.
+
+    responses should be on form (n_realizations, n_observations), clusters
+    are numbered from 1 as with cluster_responses.
+    """
+    embedding = _spearman_embedding(responses)
+
+    nr_clusters = min(max(nr_clusters, 1), responses.shape[1])
+    if nr_clusters == 1 or embedding.shape[1] == 0:
+        return np.ones(responses.shape[1], dtype=int)
+    _, labels = kmeans2(embedding, nr_clusters, minit="++", seed=0)
+    # Renumber the clusters in order of appearance, dropping empty ones
+    _, first_index, inverse = np.unique(
+        labels, return_index=True, return_inverse=True
+    )
+    return np.argsort(np.argsort(first_index))[inverse] + 1
+
+
 def cluster_responses(
     responses: npt.NDArray[np.float64],
     nr_clusters: int,
@@ -65,6 +160,7 @@ def cluster_responses(
 def main(
     responses: npt.NDArray[np.float64],
     obs_errors: npt.NDArray[np.float64],
+    method: AutoScaleMethod = "hierarchical",
 ) -> tuple[npt.NDArray[np.float64], npt.NDArray[np.int_], npt.NDArray[np.int_]]:
     """
     Perform 'Auto Scaling' to mitigate issues with correlated observations in ensemble smoothers.
@@ -122,6 +218,12 @@ def main(
         2D array of response data. Shape: (n_observations, n_realizations)
     obs_errors : npt.NDArray[np.float_]
         1D array of observation errors. Length: n_observations
+    method : AutoScaleMethod
+        "hierarchical" to cluster the full correlation matrix as described
+        above, or "scalable" which replaces the hierarchical clustering with
+        k-means on an embedding of the correlation matrix, and computes the
+        principal components from the Gram matrix of the realizations. Time and
+        memory of "scalable" are linear in the number of observations.
 
     Returns:
     --------
@@ -141,9 +243,16 @@ def main(
         # each other
         return scale_factors, np.ones(len(obs_errors), dtype=int), nr_components
 
-    prim_components = get_nr_primary_components(scaled_responses.T, threshold=0.95)
+    if method == "scalable":
+        nr_primary_components = get_nr_primary_components_scalable
+        clusters_of = cluster_responses_scalable
+    else:
+        nr_primary_components = get_nr_primary_components
+        clusters_of = cluster_responses
+
+    prim_components = nr_primary_components(scaled_responses.T, threshold=0.95)
 
-    clusters = cluster_responses(scaled_responses.T, nr_clusters=prim_components)
+    clusters = clusters_of(scaled_responses.T, nr_clusters=prim_components)
 
     for cluster in np.unique(clusters):
         index = np.where(clusters == cluster)[0]
@@ -151,7 +260,7 @@ def main(
             # Not correlated to anything
             components = 1
         else:
-            components = get_nr_primary_components(
+            components = nr_primary_components(
                 scaled_responses[index].T, threshold=0.95
             )
             components = 1 if components == 0 else components
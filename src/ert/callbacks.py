@@ -3,11 +3,14 @@
 import asyncio
 import logging
 import time
+from concurrent.futures import Executor
+from functools import partial
 from pathlib import Path
 
 from ert.config import InvalidResponseFile
 from ert.storage import Ensemble
 from ert.storage.realization_storage_state import RealizationStorageState
+from ert.trace import trace, tracer, with_current_context
 
 from .load_status import LoadResult, LoadStatus
 
@@ -19,7 +22,9 @@ async def _read_parameters(
     realization: int,
     iteration: int,
     ensemble: Ensemble,
+    executor: Executor | None = None,
 ) -> LoadResult:
+    loop = asyncio.get_running_loop()
     result = LoadResult(LoadStatus.LOAD_SUCCESSFUL, "")
     error_msg = ""
     parameter_configuration = ensemble.experiment.parameter_configuration.values()
@@ -29,15 +34,25 @@ async def _read_parameters(
         try:
             start_time = time.perf_counter()
             logger.debug(f"Starting to load parameter: {config.name}")
-            ds = config.read_from_runpath(Path(run_path), realization, iteration)
-            await asyncio.sleep(0)
+            ds = await loop.run_in_executor(
+                executor,
+                with_current_context(config.read_from_runpath),
+                Path(run_path),
+                realization,
+                iteration,
+            )
             logger.debug(
                 f"Loaded {config.name}",
                 extra={"Time": f"{(time.perf_counter() - start_time):.4f}s"},
             )
             start_time = time.perf_counter()
-            ensemble.save_parameters(config.name, realization, ds)
-            await asyncio.sleep(0)
+            await loop.run_in_executor(
+                executor,
+                with_current_context(ensemble.save_parameters),
+                config.name,
+                realization,
+                ds,
+            )
             logger.debug(
                 f"Saved {config.name} to storage",
                 extra={"Time": f"{(time.perf_counter() - start_time):.4f}s"},
@@ -53,7 +68,9 @@ async def _write_responses_to_storage(
     run_path: str,
     realization: int,
     ensemble: Ensemble,
+    executor: Executor | None = None,
 ) -> LoadResult:
+    loop = asyncio.get_running_loop()
     errors = []
     response_configs = ensemble.experiment.response_configuration.values()
     for config in response_configs:
@@ -61,19 +78,30 @@ async def _write_responses_to_storage(
             start_time = time.perf_counter()
             logger.debug(f"Starting to load response: {config.response_type}")
             try:
-                ds = config.read_from_file(run_path, realization, ensemble.iteration)
+                ds = await loop.run_in_executor(
+                    executor,
+                    with_current_context(config.read_from_file),
+                    run_path,
+                    realization,
+                    ensemble.iteration,
+                )
             except (FileNotFoundError, InvalidResponseFile) as err:
                 errors.append(str(err))
                 logger.warning(f"Failed to write: {realization}: {err}")
                 continue
-            await asyncio.sleep(0)
             logger.debug(
                 f"Loaded {config.response_type}",
                 extra={"Time": f"{(time.perf_counter() - start_time):.4f}s"},
             )
             start_time = time.perf_counter()
-            ensemble.save_response(config.response_type, ds, realization)
-            await asyncio.sleep(0)
+            await loop.run_in_executor(
+                executor,
+                with_current_context(
+                    partial(
+                        ensemble.save_response, config.response_type, ds, realization
+                    )
+                ),
+            )
             logger.debug(
                 f"Saved {config.response_type} to storage",
                 extra={"Time": f"{(time.perf_counter() - start_time):.4f}s"},
@@ -91,12 +119,23 @@ async def _write_responses_to_storage(
     return LoadResult(LoadStatus.LOAD_SUCCESSFUL, "")
 
 
+@tracer.start_as_current_span(f"{__name__}.forward_model_ok")
 async def forward_model_ok(
     run_path: str,
     realization: int,
     iter: int,
     ensemble: Ensemble,
+    executor: Executor | None = None,
 ) -> LoadResult:
+    """Load the parameters (for the prior) and responses of a finished
+    realization into storage.
+
+    Reading and saving is blocking, and is done in executor, or the default
+    executor of the event loop if None, so that the event loop is kept free
+    while results are internalized."""
+    current_span = trace.get_current_span()
+    current_span.set_attribute("ert.realization_number", realization)
+    current_span.set_attribute("ert.iteration", iter)
     parameters_result = LoadResult(LoadStatus.LOAD_SUCCESSFUL, "")
     response_result = LoadResult(LoadStatus.LOAD_SUCCESSFUL, "")
     try:
@@ -108,6 +147,7 @@ async def forward_model_ok(
                 realization,
                 iter,
                 ensemble,
+                executor,
             )
 
         if parameters_result.status == LoadStatus.LOAD_SUCCESSFUL:
@@ -115,6 +155,7 @@ async def forward_model_ok(
                 run_path,
                 realization,
                 ensemble,
+                executor,
             )
 
     except Exception as err:
@@ -136,4 +177,5 @@ async def forward_model_ok(
     elif ensemble.has_failure(realization):
         ensemble.unset_failure(realization)
 
+    current_span.set_attribute("ert.load_status", str(final_result.status))
     return final_result
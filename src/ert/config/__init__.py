@@ -1,4 +1,9 @@
-from .analysis_config import AnalysisConfig, ObservationGroups, UpdateSettings
+from .analysis_config import (
+    AnalysisConfig,
+    AutoScaleMethod,
+    ObservationGroups,
+    UpdateSettings,
+)
 from .analysis_module import AnalysisModule, ESSettings
 from .capture_validation import capture_validation
 from .design_matrix import DESIGN_MATRIX_GROUP, DesignMatrix
@@ -41,6 +46,7 @@
     "DESIGN_MATRIX_GROUP",
     "AnalysisConfig",
     "AnalysisModule",
+    "AutoScaleMethod",
     "ConfigValidationError",
     "ConfigValidationError",
     "ConfigWarning",
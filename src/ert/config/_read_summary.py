@@ -7,9 +7,12 @@
 from __future__ import annotations
 
 import fnmatch
+import logging
+import mmap
 import os
 import os.path
 import re
+import struct
 from collections.abc import Callable, Sequence
 from datetime import datetime, timedelta
 from enum import Enum, auto
@@ -27,6 +30,8 @@
 
 from .response_config import InvalidResponseFile
 
+logger = logging.getLogger(__name__)
+
 
 def read_summary(
     summary_basename: str, select_keys: Sequence[str]
@@ -446,6 +451,23 @@ def _read_summary(
     unit: DateUnit,
     indices: npt.NDArray[np.int64],
     date_index: int,
+) -> tuple[npt.NDArray[np.float32], list[datetime]]:
+    if not summary.lower().endswith("funsmry"):
+        try:
+            return _read_unformatted_summary(
+                summary, start_date, unit, indices, date_index
+            )
+        except _UnsupportedLayoutError as err:
+            logger.debug(f"Reading {summary} record by record: {err}")
+    return _read_summary_records(summary, start_date, unit, indices, date_index)
+
+
+def _read_summary_records(
+    summary: str,
+    start_date: datetime,
+    unit: DateUnit,
+    indices: npt.NDArray[np.int64],
+    date_index: int,
 ) -> tuple[npt.NDArray[np.float32], list[datetime]]:
     if summary.lower().endswith("funsmry"):
         mode = "rt"
@@ -484,3 +506,152 @@ def read_params() -> None:
                 read_params()
         read_params()
     return np.array(values, dtype=np.float32).T, dates
+
+
+class _UnsupportedLayoutError(Exception):
+    """The unformatted summary file is not laid out as _read_unformatted_summary
+    expects, and has to be read record by record"""
+
+
+# Item size in bytes and number of items per fortran block of the data types
+_UNFORMATTED_TYPES = {
+    b"INTE": (4, 1000),
+    b"REAL": (4, 1000),
+    b"LOGI": (4, 1000),
+    b"DOUB": (8, 1000),
+    b"CHAR": (8, 105),
+    b"MESS": (0, 1000),
+}
+_HEADER = struct.Struct(">i8si4si")
+_BLOCK_SIZE = 1000
+_STEPS_PER_GATHER = 1024
+
+
+def _params_records(summary: mmap.mmap) -> tuple[npt.NDArray[np.int64], int]:
+    """Returns the byte offsets of the data of the PARAMS records to read, the
+    last PARAMS before each SEQHDR, and the number of values per PARAMS."""
+    offsets: list[int] = []
+    lengths: set[int] = set()
+    last_params: tuple[int, int] | None = None
+    position = 0
+    while position < len(summary):
+        if position + _HEADER.size > len(summary):
+            raise _UnsupportedLayoutError("Truncated record header")
+        head, keyword, length, data_type, tail = _HEADER.unpack_from(
+            summary, position
+        )
+        if head != 16 or tail != 16 or length < 0:
+            raise _UnsupportedLayoutError(f"Invalid record header at {position}")
+        position += _HEADER.size
+        if data_type in _UNFORMATTED_TYPES:
+            item_size, block_size = _UNFORMATTED_TYPES[data_type]
+        elif data_type.startswith(b"C0") and data_type[2:].isdigit():
+            item_size, block_size = int(data_type[2:]), 105
+        else:
+            raise _UnsupportedLayoutError(f"Unknown type {data_type!r}")
+
+        if keyword == b"PARAMS  ":
+            if data_type != b"REAL":
+                raise _UnsupportedLayoutError(f"PARAMS has type {data_type!r}")
+            last_params = (position, length)
+        elif keyword == b"SEQHDR  " and last_params is not None:
+            offsets.append(last_params[0])
+            lengths.add(last_params[1])
+            last_params = None
+        if length > 0 and item_size > 0:
+            position += length * item_size + -(-length // block_size) * 8
+    if last_params is not None:
+        offsets.append(last_params[0])
+        lengths.add(last_params[1])
+
+    if not offsets:
+        raise _UnsupportedLayoutError("No PARAMS")
+    if len(lengths) != 1:
+        raise _UnsupportedLayoutError("PARAMS differ in length")
+    if any(offset % 4 for offset in offsets):
+        raise _UnsupportedLayoutError("Unaligned PARAMS")
+    return np.array(offsets, dtype=np.int64), lengths.pop()
+
+
+def _read_unformatted_summary(
+    summary: str,
+    start_date: datetime,
+    unit: DateUnit,
+    indices: npt.NDArray[np.int64],
+    date_index: int,
+) -> tuple[npt.NDArray[np.float32], list[datetime]]:
+    """Reads the selected values of an unformatted summary file by memory
+    mapping it, and gathering the values straight from the PARAMS records.
+
+    The values of a PARAMS record are stored in fortran blocks of 1000 values,
+    each surrounded by 4 byte markers, so the position of a value within a
+    record only depends on its index, and is computed once for all records.
+    """
+    if os.path.getsize(summary) == 0:
+        raise _UnsupportedLayoutError("Empty file")
+    with (
+        open(summary, "rb") as fp,
+        mmap.mmap(fp.fileno(), 0, access=mmap.ACCESS_READ) as mapped,
+    ):
+        offsets, nr_params = _params_records(mapped)
+        if len(indices) and (indices.max() >= nr_params or indices.min() < 0):
+            raise _UnsupportedLayoutError("Index out of bounds")
+        # Everything is 4 byte aligned, so the file is viewed as 4 byte words
+        words = np.frombuffer(mapped, dtype=">i4", count=len(mapped) // 4)
+        try:
+            _check_block_markers(words, offsets // 4, nr_params)
+            values_view = words.view(">f4")
+
+            def word_offsets(index: npt.NDArray[np.int64]) -> npt.NDArray[np.int64]:
+                return (index // _BLOCK_SIZE) * (_BLOCK_SIZE + 2) + 1 + (
+                    index % _BLOCK_SIZE
+                )
+
+            columns = word_offsets(np.asarray(indices, dtype=np.int64))
+            record_words = offsets // 4
+            values = np.empty((len(indices), len(offsets)), dtype=np.float32)
+            for start in range(0, len(offsets), _STEPS_PER_GATHER):
+                steps = slice(start, start + _STEPS_PER_GATHER)
+                values[:, steps] = values_view[
+                    record_words[steps, np.newaxis] + columns[np.newaxis, :]
+                ].T
+            times = values_view[
+                record_words + word_offsets(np.array(date_index, dtype=np.int64))
+            ].astype(np.float64)
+        finally:
+            del words
+            values_view = None
+    return values, _make_dates(start_date, unit, times)
+
+
+def _check_block_markers(
+    words: npt.NDArray[np.int32], record_words: npt.NDArray[np.int64], length: int
+) -> None:
+    block_lengths = np.minimum(
+        _BLOCK_SIZE, length - _BLOCK_SIZE * np.arange(-(-length // _BLOCK_SIZE))
+    )
+    block_starts = np.concatenate([[0], np.cumsum(block_lengths + 2)[:-1]])
+    heads = record_words[:, np.newaxis] + block_starts[np.newaxis, :]
+    tails = heads + 1 + block_lengths[np.newaxis, :]
+    if tails.max(initial=0) >= len(words):
+        raise _UnsupportedLayoutError("Truncated PARAMS")
+    markers = 4 * block_lengths[np.newaxis, :]
+    if not (np.all(words[heads] == markers) and np.all(words[tails] == markers)):
+        raise _UnsupportedLayoutError("PARAMS are not in blocks of 1000 values")
+
+
+def _make_dates(
+    start_date: datetime, unit: DateUnit, times: npt.NDArray[np.float64]
+) -> list[datetime]:
+    """Vectorized start_date + unit.make_delta(time), rounded to whole seconds
+    as with _round_to_seconds"""
+    microseconds_per_unit = {DateUnit.HOURS: 3600 * 10**6, DateUnit.DAYS: 86400 * 10**6}
+    if unit not in microseconds_per_unit:
+        raise InvalidResponseFile(f"Unknown date unit {unit}")
+    microseconds = np.datetime64(start_date, "us").astype(np.int64) + np.rint(
+        times * microseconds_per_unit[unit]
+    ).astype(np.int64)
+    seconds, remainder = np.divmod(microseconds, 10**6)
+    # round() rounds half to even, so exactly half a second is rounded down
+    seconds += remainder > 500000
+    return seconds.astype("datetime64[s]").tolist()
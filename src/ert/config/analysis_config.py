@@ -5,7 +5,7 @@
 from math import ceil
 from os.path import realpath
 from pathlib import Path
-from typing import Any, Final, no_type_check
+from typing import Any, Final, Literal, no_type_check
 
 from pydantic import PositiveFloat, ValidationError
 
@@ -21,6 +21,7 @@
 logger = logging.getLogger(__name__)
 
 ObservationGroups = list[str]
+AutoScaleMethod = Literal["hierarchical", "scalable"]
 
 
 @dataclass
@@ -28,6 +29,7 @@ class UpdateSettings:
     std_cutoff: PositiveFloat = 1e-6
     alpha: float = 3.0
     auto_scale_observations: list[ObservationGroups] = field(default_factory=list)
+    auto_scale_method: AutoScaleMethod = "hierarchical"
 
 
 @dataclass
@@ -111,11 +113,22 @@ def from_dict(cls, config_dict: ConfigDict) -> AnalysisConfig:
                     observation_settings["auto_scale_observations"].append(
                         value.split(",")
                     )
+                elif var_name == "AUTO_SCALE_METHOD":
+                    if value.lower() in {"hierarchical", "scalable"}:
+                        observation_settings["auto_scale_method"] = value.lower()
+                    else:
+                        all_errors.append(
+                            ConfigValidationError.with_context(
+                                f"Invalid AUTO_SCALE_METHOD {value!r}, valid "
+                                "options: HIERARCHICAL, SCALABLE",
+                                value,
+                            )
+                        )
                 else:
                     all_errors.append(
                         ConfigValidationError(
                             f"Unknown variable: {var_name} for: ANALYSIS_SET_VAR OBSERVATIONS {var_name}"
-                            "Valid options: AUTO_SCALE"
+                            "Valid options: AUTO_SCALE, AUTO_SCALE_METHOD"
                         )
                     )
                 continue
@@ -11,6 +11,7 @@
 
 DEFAULT_ENKF_TRUNCATION = 0.98
 DEFAULT_LOCALIZATION = False
+DEFAULT_MAX_CONCURRENT_PARAM_GROUPS = 3
 
 
 def _lower(v: str) -> str:
@@ -49,6 +50,32 @@ class ESSettings(BaseModel):
             title="Adaptive localization correlation threshold",
         ),
     ] = None
+    max_concurrent_param_groups: Annotated[
+        int,
+        Field(
+            ge=1,
+            title="Maximum number of parameter groups held in memory during update",
+        ),
+    ] = DEFAULT_MAX_CONCURRENT_PARAM_GROUPS
+    streaming_localization: Annotated[
+        bool,
+        Field(
+            title="Store only significant localization correlations, batch by batch",
+        ),
+    ] = False
+    localization_processes: Annotated[
+        int,
+        Field(
+            ge=1,
+            title="Number of processes running adaptive localization",
+        ),
+    ] = 1
+    cache_update: Annotated[
+        bool,
+        Field(
+            title="Reuse the responses and matrices of earlier updates",
+        ),
+    ] = False
 
     def correlation_threshold(self, ensemble_size: int) -> float:
         """Decides whether to use user-defined or default threshold.
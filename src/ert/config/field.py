@@ -19,6 +19,8 @@
 from .parsing import ConfigValidationError, ConfigWarning
 
 if TYPE_CHECKING:
+    from collections.abc import Mapping
+
     import numpy.typing as npt
 
     from ert.storage import Ensemble
@@ -143,40 +145,79 @@ def read_from_runpath(
         self, run_path: Path, real_nr: int, iteration: int
     ) -> xr.Dataset:
         file_name = substitute_runpath_name(self.forward_init_file, real_nr, iteration)
-        ds = xr.Dataset(
-            {
-                "values": (
-                    ["x", "y", "z"],
-                    field_transform(
-                        read_field(
-                            run_path / file_name,
-                            self.name,
-                            self.mask,
-                            Shape(self.nx, self.ny, self.nz),
-                        ),
-                        self.input_transformation,
-                    ),
-                )
-            }
+        values = field_transform(
+            read_field(
+                run_path / file_name,
+                self.name,
+                self.mask,
+                Shape(self.nx, self.ny, self.nz),
+            ),
+            self.input_transformation,
         )
-        return ds
+        return self._active_cells_dataset(np.ma.getdata(values)[~self.mask])
 
     @log_duration(_logger, custom_name="save_field")
     def write_to_runpath(
         self, run_path: Path, real_nr: int, ensemble: Ensemble
+    ) -> None:
+        self._save_to_runpath(
+            run_path,
+            real_nr,
+            ensemble.iteration,
+            self._transform_data(self._fetch_from_ensemble(real_nr, ensemble)),
+        )
+
+    def write_to_runpaths(
+        self, run_paths: Mapping[int, Path], ensemble: Ensemble
+    ) -> dict[int, dict[str, dict[str, float]]]:
+        """Loads the field for all the realizations at once, and transforms
+        and truncates the active cells of all of them in one operation"""
+        if not run_paths:
+            return {}
+        values = ensemble.load_parameters(self.name, np.array(list(run_paths)))[
+            "values"
+        ]
+        grids = self.to_grid(
+            np.asarray(
+                _field_truncate(
+                    field_transform(
+                        np.asarray(self._active_cells(values)),
+                        transform_name=self.output_transformation,
+                    ),
+                    self.truncation_min,
+                    self.truncation_max,
+                ),
+                dtype=np.float32,
+            )
+        )
+        for grid, (real_nr, run_path) in zip(grids, run_paths.items(), strict=True):
+            self._save_to_runpath(
+                run_path,
+                real_nr,
+                ensemble.iteration,
+                np.ma.MaskedArray(grid, self.mask, fill_value=np.nan),  # type: ignore
+            )
+        return {}
+
+    def _save_to_runpath(
+        self,
+        run_path: Path,
+        real_nr: int,
+        iteration: int,
+        data: np.ma.MaskedArray[Any, np.dtype[np.float32]],
     ) -> None:
         file_out = run_path.joinpath(
-            substitute_runpath_name(str(self.output_file), real_nr, ensemble.iteration)
+            substitute_runpath_name(str(self.output_file), real_nr, iteration)
         )
         if os.path.islink(file_out):
             os.unlink(file_out)
 
-        save_field(
-            self._transform_data(self._fetch_from_ensemble(real_nr, ensemble)),
-            self.name,
-            file_out,
-            self.file_format,
-        )
+        save_field(data, self.name, file_out, self.file_format)
+
+    def _active_cells_dataset(self, data: npt.ArrayLike) -> xr.Dataset:
+        """Fields are stored with the values of the active cells only, the
+        inactive cells are given by the shared mask in Field.mask"""
+        return xr.Dataset({"values": (["cells"], np.asarray(data, dtype=np.float32))})
 
     def save_parameters(
         self,
@@ -184,32 +225,42 @@ def save_parameters(
         realization: int,
         data: npt.NDArray[np.float64],
     ) -> None:
-        ma = np.ma.MaskedArray(  # type: ignore
-            data=np.zeros(self.mask.size),
-            mask=self.mask,
-            fill_value=np.nan,
+        ensemble.save_parameters(
+            self.name, realization, self._active_cells_dataset(data)
         )
-        ma[~ma.mask] = data
-        ma = ma.reshape(self.mask.shape)  # type: ignore
-        ds = xr.Dataset({"values": (["x", "y", "z"], ma.filled())})  # type: ignore
-        ensemble.save_parameters(self.name, realization, ds)
+
+    def _active_cells(self, values: xr.DataArray) -> npt.NDArray[np.float32]:
+        """Values of active cells as (realizations, cells). Fields stored before
+        the active cell layout have the full (realizations, x, y, z) grid."""
+        if "cells" in values.dims:
+            return values.values
+        return values.values.reshape(values.shape[0], -1)[:, ~self.mask.ravel()]
 
     def load_parameters(
         self, ensemble: Ensemble, realizations: npt.NDArray[np.int_]
-    ) -> npt.NDArray[np.float64]:
+    ) -> npt.NDArray[np.floating[Any]]:
+        """Returns the (active cells, realizations) matrix of the field. With
+        the ensemble parameter layout this is a read-only view into the memory
+        mapped store, and no copies are made."""
         ds = ensemble.load_parameters(self.name, realizations)
-        ensemble_size = len(ds.realizations)
-        da = xr.DataArray(
-            [
-                np.ma.MaskedArray(data=d, mask=self.mask).compressed()  # type: ignore
-                for d in ds["values"].values.reshape(ensemble_size, -1)
-            ]
+        return self._active_cells(ds["values"]).T
+
+    def to_grid(
+        self, active_values: npt.NDArray[np.float32]
+    ) -> npt.NDArray[np.float32]:
+        """Expands the active cell values of one or more realizations, as
+        (..., cells), into (..., nx, ny, nz) with nan in the inactive cells."""
+        grid = np.full(
+            (*active_values.shape[:-1], self.mask.size), np.nan, dtype=np.float32
         )
-        return da.T.to_numpy()
+        grid[..., ~self.mask.ravel()] = active_values
+        return grid.reshape(*active_values.shape[:-1], *self.mask.shape)
 
     def _fetch_from_ensemble(self, real_nr: int, ensemble: Ensemble) -> xr.DataArray:
         da = ensemble.load_parameters(self.name, real_nr)["values"]
         assert isinstance(da, xr.DataArray)
+        if "cells" in da.dims:
+            return xr.DataArray(self.to_grid(da.values), dims=["x", "y", "z"])
         return da
 
     def _transform_data(
@@ -280,13 +331,8 @@ def field_transform(
 
 
 def _field_truncate(data: npt.ArrayLike, min_: float | None, max_: float | None) -> Any:
-    if min_ is not None and max_ is not None:
-        vfunc = np.vectorize(lambda x: max(min(x, max_), min_))
-        return vfunc(data)
-    elif min_ is not None:
-        vfunc = np.vectorize(lambda x: max(x, min_))
-        return vfunc(data)
-    elif max_ is not None:
-        vfunc = np.vectorize(lambda x: min(x, max_))
-        return vfunc(data)
+    if max_ is not None:
+        data = np.minimum(data, max_)
+    if min_ is not None:
+        data = np.maximum(data, min_)
     return data
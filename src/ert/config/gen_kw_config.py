@@ -4,13 +4,14 @@
 import os
 import shutil
 import warnings
-from collections.abc import Callable
+from collections.abc import Callable, Mapping
 from dataclasses import dataclass
 from hashlib import sha256
 from pathlib import Path
 from typing import TYPE_CHECKING, Any, Self, cast, overload
 
 import numpy as np
+import numpy.typing as npt
 import pandas as pd
 import xarray as xr
 from scipy.stats import norm
@@ -23,8 +24,6 @@
 from .parsing import ConfigValidationError, ConfigWarning, ErrorInfo
 
 if TYPE_CHECKING:
-    import numpy.typing as npt
-
     from ert.storage import Ensemble
 
 
@@ -78,6 +77,7 @@ def __post_init__(self) -> None:
                     self._parse_transform_function_definition(e)
                 )
         self._validate()
+        self._transform_plan = _TransformPlan.build(self.transform_functions)
 
     def __contains__(self, item: str) -> bool:
         return item in [v.name for v in self.transform_function_definitions]
@@ -327,12 +327,64 @@ def write_to_runpath(
     ) -> dict[str, dict[str, float]]:
         array = ensemble.load_parameters(self.name, real_nr)["transformed_values"]
         assert isinstance(array, xr.DataArray)
-        if not array.size == len(self.transform_functions):
+        self._check_size(array.size)
+        return self._write_values_to_runpath(
+            run_path,
+            real_nr,
+            ensemble.iteration,
+            array["names"].values.tolist(),
+            array.values,
+            self._read_template(ensemble),
+        )
+
+    def write_to_runpaths(
+        self, run_paths: Mapping[int, Path], ensemble: Ensemble
+    ) -> dict[int, dict[str, dict[str, float]]]:
+        """Loads the parameters of all the realizations at once, and reads
+        the template once for all of them"""
+        if not run_paths:
+            return {}
+        array = ensemble.load_parameters(self.name, np.array(list(run_paths)))[
+            "transformed_values"
+        ]
+        assert isinstance(array, xr.DataArray)
+        self._check_size(array.shape[-1])
+        names = array["names"].values.tolist()
+        template = self._read_template(ensemble)
+        return {
+            real_nr: self._write_values_to_runpath(
+                run_path, real_nr, ensemble.iteration, names, values, template
+            )
+            for values, (real_nr, run_path) in zip(
+                array.values, run_paths.items(), strict=True
+            )
+        }
+
+    def _check_size(self, size: int) -> None:
+        if not size == len(self.transform_functions):
             raise ValueError(
                 f"The configuration of GEN_KW parameter {self.name}"
-                f" is of size {len(self.transform_functions)}, expected {array.size}"
+                f" is of size {len(self.transform_functions)}, expected {size}"
             )
 
+    def _read_template(self, ensemble: Ensemble) -> str | None:
+        if self.template_file is None or self.output_file is None:
+            return None
+        template_file_path = (
+            ensemble.experiment.mount_point / Path(self.template_file).name
+        )
+        with open(template_file_path, encoding="utf-8") as f:
+            return f.read()
+
+    def _write_values_to_runpath(
+        self,
+        run_path: Path,
+        real_nr: int,
+        iteration: int,
+        names: list[str],
+        values: npt.NDArray[Any],
+        template: str | None,
+    ) -> dict[str, dict[str, float]]:
         def parse_value(value: float | int | str) -> float | int | str:
             if isinstance(value, float | int):
                 return value
@@ -346,8 +398,8 @@ def parse_value(value: float | int | str) -> float | int | str:
 
         data = dict(
             zip(
-                array["names"].values.tolist(),
-                [parse_value(i) for i in array.values],
+                names,
+                [parse_value(i) for i in values],
                 strict=False,
             )
         )
@@ -358,17 +410,10 @@ def parse_value(value: float | int | str) -> float | int | str:
             if tf.use_log
         }
 
-        if self.template_file is not None and self.output_file is not None:
-            target_file = substitute_runpath_name(
-                self.output_file, real_nr, ensemble.iteration
-            )
+        if template is not None and self.output_file is not None:
+            target_file = substitute_runpath_name(self.output_file, real_nr, iteration)
             target_file = target_file.removeprefix("/")
             (run_path / target_file).parent.mkdir(exist_ok=True, parents=True)
-            template_file_path = (
-                ensemble.experiment.mount_point / Path(self.template_file).name
-            )
-            with open(template_file_path, encoding="utf-8") as f:
-                template = f.read()
             for key, value in data.items():
                 template = template.replace(f"<{key}>", f"{value:.6g}")
             with open(run_path / target_file, "w", encoding="utf-8") as f:
@@ -424,15 +469,16 @@ def transform(self, array: npt.ArrayLike) -> npt.NDArray[np.float64]:
         """Transform the input array in accordance with priors
 
         Parameters:
-            array: An array of standard normal values
+            array: An array of standard normal values, of shape (n_parameters,)
+                or (n_parameters, n_realizations)
 
         Returns: Transformed array, where each element has been transformed from
             a standard normal distribution to the distribution set by the user
         """
         array = np.array(array)
-        for index, tf in enumerate(self.transform_functions):
-            array[index] = tf.calc_func(array[index], list(tf.parameter_list.values()))
-        return array
+        if not np.issubdtype(array.dtype, np.floating):
+            array = array.astype(np.float64)
+        return self._transform_plan(array)
 
     @staticmethod
     def _values_from_file(file_name: str, keys: list[str]) -> npt.NDArray[np.double]:
@@ -551,6 +597,55 @@ def save_experiment_data(self, experiment_path: Path) -> None:
             shutil.copyfile(incoming_template_file_path, template_file_path)
 
 
+@dataclass
+class _TransformStep:
+    kernel: Kernel
+    indices: npt.NDArray[np.int_]
+    arguments: npt.NDArray[np.float64]
+    """Distribution parameters of shape (n_arguments, len(indices))"""
+
+
+@dataclass
+class _TransformPlan:
+    """
+    Evaluation plan for the transforms of a GEN_KW group, where all parameters
+    sharing a distribution are transformed with one call to its kernel.
+    """
+
+    steps: list[_TransformStep]
+
+    @classmethod
+    def build(cls, transform_functions: list[TransformFunction]) -> _TransformPlan:
+        by_distribution: dict[str, list[int]] = {}
+        for index, tf in enumerate(transform_functions):
+            by_distribution.setdefault(tf.transform_function_name, []).append(index)
+        return cls(
+            [
+                _TransformStep(
+                    kernel=PRIOR_KERNELS[distribution],
+                    indices=np.array(indices, dtype=np.int_),
+                    arguments=np.array(
+                        [
+                            list(transform_functions[i].parameter_list.values())
+                            for i in indices
+                        ],
+                        dtype=np.float64,
+                    ).T,
+                )
+                for distribution, indices in by_distribution.items()
+            ]
+        )
+
+    def __call__(self, array: npt.NDArray[np.floating[Any]]) -> Any:
+        """Transforms array in place, the first axis of array is the parameters"""
+        for step in self.steps:
+            arguments = step.arguments.reshape(
+                step.arguments.shape + (1,) * (array.ndim - 1)
+            )
+            array[step.indices] = step.kernel(array[step.indices], arguments)
+        return array
+
+
 @dataclass
 class TransformFunction:
     name: str
@@ -565,111 +660,47 @@ def __post_init__(self) -> None:
 
     @staticmethod
     def trans_errf(x: float, arg: list[float]) -> float:
-        """
-        Width  = 1 => uniform
-        Width  > 1 => unimodal peaked
-        Width  < 1 => bimodal peaks
-        Skewness < 0 => shifts towards the left
-        Skewness = 0 => symmetric
-        Skewness > 0 => Shifts towards the right
-        The width is a relavant scale for the value of skewness.
-        """
-        min_, max_, skew, width = arg[0], arg[1], arg[2], arg[3]
-        y = norm(loc=0, scale=width).cdf(x + skew)
-        if np.isnan(y):
-            raise ValueError(
-                "Output is nan, likely from triplet (x, skewness, width) "
-                "leading to low/high-probability in normal CDF."
-            )
-        return min_ + y * (max_ - min_)
+        return _transform_scalar(_errf, x, arg)
 
     @staticmethod
-    def trans_const(_: float, arg: list[float]) -> float:
-        return arg[0]
+    def trans_const(x: float, arg: list[float]) -> float:
+        return _transform_scalar(_const, x, arg)
 
     @staticmethod
-    def trans_raw(x: float, _: list[float]) -> float:
-        return x
+    def trans_raw(x: float, arg: list[float]) -> float:
+        return _transform_scalar(_raw, x, arg)
 
     @staticmethod
     def trans_derrf(x: float, arg: list[float]) -> float:
-        """
-        Bin the result of `trans_errf` with `min=0` and `max=1` to closest of `nbins`
-        linearly spaced values on [0,1]. Finally map [0,1] to [min, max].
-        """
-        steps, min_, max_, skew, width = (
-            int(arg[0]),
-            arg[1],
-            arg[2],
-            arg[3],
-            arg[4],
-        )
-        q_values = np.linspace(start=0, stop=1, num=steps)
-        q_checks = np.linspace(start=0, stop=1, num=steps + 1)[1:]
-        y = TransformFunction.trans_errf(x, [0, 1, skew, width])
-        bin_index = np.digitize(y, q_checks, right=True)
-        y_binned = q_values[bin_index]
-        result = min_ + y_binned * (max_ - min_)
-        if result > max_ or result < min_:
-            warnings.warn(
-                "trans_derff suffered from catastrophic loss of precision, clamping to min,max",
-                stacklevel=1,
-            )
-            return np.clip(result, min_, max_)
-        if np.isnan(result):
-            raise ValueError(
-                "trans_derrf returns nan, check that input arguments are reasonable"
-            )
-        return result
+        return _transform_scalar(_derrf, x, arg)
 
     @staticmethod
     def trans_unif(x: float, arg: list[float]) -> float:
-        min_, max_ = arg[0], arg[1]
-        y = norm.cdf(x)
-        return y * (max_ - min_) + min_
+        return _transform_scalar(_unif, x, arg)
 
     @staticmethod
     def trans_dunif(x: float, arg: list[float]) -> float:
-        steps, min_, max_ = int(arg[0]), arg[1], arg[2]
-        y = norm.cdf(x)
-        return (math.floor(y * steps) / (steps - 1)) * (max_ - min_) + min_
+        return _transform_scalar(_dunif, x, arg)
 
     @staticmethod
     def trans_normal(x: float, arg: list[float]) -> float:
-        mean, std = arg[0], arg[1]
-        return x * std + mean
+        return _transform_scalar(_normal, x, arg)
 
     @staticmethod
     def trans_truncated_normal(x: float, arg: list[float]) -> float:
-        mean, std, min_, max_ = arg[0], arg[1], arg[2], arg[3]
-        y = x * std + mean
-        return max(min(y, max_), min_)  # clamp
+        return _transform_scalar(_truncated_normal, x, arg)
 
     @staticmethod
     def trans_lognormal(x: float, arg: list[float]) -> float:
-        # mean is the expectation of log( y )
-        mean, std = arg[0], arg[1]
-        return math.exp(x * std + mean)
+        return _transform_scalar(_lognormal, x, arg)
 
     @staticmethod
     def trans_logunif(x: float, arg: list[float]) -> float:
-        log_min, log_max = math.log(arg[0]), math.log(arg[1])
-        tmp = norm.cdf(x)
-        log_y = log_min + tmp * (log_max - log_min)  # Shift according to max / min
-        return math.exp(log_y)
+        return _transform_scalar(_logunif, x, arg)
 
     @staticmethod
     def trans_triangular(x: float, arg: list[float]) -> float:
-        min_, mode, max_ = arg[0], arg[1], arg[2]
-        inv_norm_left = (max_ - min_) * (mode - min_)
-        inv_norm_right = (max_ - min_) * (max_ - mode)
-        ymode = (mode - min_) / (max_ - min_)
-        y = norm.cdf(x)
-
-        if y < ymode:
-            return min_ + math.sqrt(y * inv_norm_left)
-        else:
-            return max_ - math.sqrt((1 - y) * inv_norm_right)
+        return _transform_scalar(_triangular, x, arg)
 
     def calculate(self, x: float, arg: list[float]) -> float:
         return self.calc_func(x, arg)
@@ -690,6 +721,152 @@ def calculate(self, x: float, arg: list[float]) -> float:
 }
 
 
+# The transforms below are array kernels: x is an array of standard normal
+# values, and arg holds the distribution parameters along its first axis, each
+# broadcastable against x. This lets GenKwConfig.transform evaluate all
+# parameters sharing a distribution, for all realizations, in one call.
+Kernel = Callable[[npt.NDArray[np.float64], npt.NDArray[np.float64]], Any]
+
+
+def _transform_scalar(kernel: Kernel, x: float, arg: list[float]) -> float:
+    return float(
+        kernel(np.asarray(x, dtype=np.float64), np.asarray(arg, dtype=np.float64))
+    )
+
+
+def _errf(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    """
+    Width  = 1 => uniform
+    Width  > 1 => unimodal peaked
+    Width  < 1 => bimodal peaks
+    Skewness < 0 => shifts towards the left
+    Skewness = 0 => symmetric
+    Skewness > 0 => Shifts towards the right
+    The width is a relavant scale for the value of skewness.
+    """
+    min_, max_, skew, width = arg[0], arg[1], arg[2], arg[3]
+    y = _errf_cdf(x, skew, width)
+    return min_ + y * (max_ - min_)
+
+
+def _errf_cdf(
+    x: npt.NDArray[np.float64],
+    skew: npt.NDArray[np.float64],
+    width: npt.NDArray[np.float64],
+) -> Any:
+    y = norm.cdf(x + skew, scale=width)
+    if np.isnan(y).any():
+        raise ValueError(
+            "Output is nan, likely from triplet (x, skewness, width) "
+            "leading to low/high-probability in normal CDF."
+        )
+    return y
+
+
+def _const(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    return np.zeros_like(x) + arg[0]
+
+
+def _raw(x: npt.NDArray[np.float64], _: npt.NDArray[np.float64]) -> Any:
+    return x
+
+
+def _derrf(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    """
+    Bin the result of `_errf` with `min=0` and `max=1` to closest of `nbins`
+    linearly spaced values on [0,1]. Finally map [0,1] to [min, max].
+    """
+    steps, min_, max_, skew, width = arg[0], arg[1], arg[2], arg[3], arg[4]
+    y = _errf_cdf(x, skew, width)
+    steps = np.broadcast_to(np.trunc(steps), np.shape(y))
+    y_binned = np.empty(np.shape(y))
+    # Parameters are binned together by their number of bins
+    for nbins in np.unique(steps):
+        in_bins = steps == nbins
+        q_values = np.linspace(start=0, stop=1, num=int(nbins))
+        q_checks = np.linspace(start=0, stop=1, num=int(nbins) + 1)[1:]
+        bin_index = np.digitize(np.asarray(y)[in_bins], q_checks, right=True)
+        y_binned[in_bins] = q_values[bin_index]
+    result = min_ + y_binned * (max_ - min_)
+    if np.any((result > max_) | (result < min_)):
+        warnings.warn(
+            "trans_derff suffered from catastrophic loss of precision, clamping to min,max",
+            stacklevel=1,
+        )
+        return np.clip(result, min_, max_)
+    if np.isnan(result).any():
+        raise ValueError(
+            "trans_derrf returns nan, check that input arguments are reasonable"
+        )
+    return result
+
+
+def _unif(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    min_, max_ = arg[0], arg[1]
+    y = norm.cdf(x)
+    return y * (max_ - min_) + min_
+
+
+def _dunif(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    steps, min_, max_ = np.trunc(arg[0]), arg[1], arg[2]
+    y = norm.cdf(x)
+    return (np.floor(y * steps) / (steps - 1)) * (max_ - min_) + min_
+
+
+def _normal(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    mean, std = arg[0], arg[1]
+    return x * std + mean
+
+
+def _truncated_normal(
+    x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]
+) -> Any:
+    mean, std, min_, max_ = arg[0], arg[1], arg[2], arg[3]
+    y = x * std + mean
+    return np.maximum(np.minimum(y, max_), min_)  # clamp
+
+
+def _lognormal(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    # mean is the expectation of log( y )
+    mean, std = arg[0], arg[1]
+    return np.exp(x * std + mean)
+
+
+def _logunif(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    log_min, log_max = np.log(arg[0]), np.log(arg[1])
+    tmp = norm.cdf(x)
+    log_y = log_min + tmp * (log_max - log_min)  # Shift according to max / min
+    return np.exp(log_y)
+
+
+def _triangular(x: npt.NDArray[np.float64], arg: npt.NDArray[np.float64]) -> Any:
+    min_, mode, max_ = arg[0], arg[1], arg[2]
+    inv_norm_left = (max_ - min_) * (mode - min_)
+    inv_norm_right = (max_ - min_) * (max_ - mode)
+    ymode = (mode - min_) / (max_ - min_)
+    y = norm.cdf(x)
+    return np.where(
+        y < ymode,
+        min_ + np.sqrt(y * inv_norm_left),
+        max_ - np.sqrt((1 - y) * inv_norm_right),
+    )
+
+
+PRIOR_KERNELS: dict[str, Kernel] = {
+    "NORMAL": _normal,
+    "LOGNORMAL": _lognormal,
+    "TRUNCATED_NORMAL": _truncated_normal,
+    "TRIANGULAR": _triangular,
+    "UNIFORM": _unif,
+    "DUNIF": _dunif,
+    "ERRF": _errf,
+    "DERRF": _derrf,
+    "LOGUNIF": _logunif,
+    "CONST": _const,
+    "RAW": _raw,
+}
+
+
 DISTRIBUTION_PARAMETERS: dict[str, list[str]] = {
     "NORMAL": ["MEAN", "STD"],
     "LOGNORMAL": ["MEAN", "STD"],
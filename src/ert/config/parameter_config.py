@@ -9,6 +9,8 @@
 import xarray as xr
 
 if TYPE_CHECKING:
+    from collections.abc import Mapping
+
     import numpy.typing as npt
 
     from ert.storage import Ensemble
@@ -68,6 +70,26 @@ def write_to_runpath(
         expects
         """
 
+    def write_to_runpaths(
+        self, run_paths: Mapping[int, Path], ensemble: Ensemble
+    ) -> dict[int, dict[str, dict[str, float]]]:
+        """
+        Write the parameter to the runpaths of several realizations, given as
+        a mapping from realization number to runpath, and return the values
+        to export for each realization as returned by write_to_runpath.
+
+        Parameters that can be loaded for all the realizations at once
+        override this, by default write_to_runpath is called for each
+        realization. Loading all the realizations at once is one read in the
+        ensemble parameter layout, while the realization layout still reads
+        one file per realization.
+        """
+        exports = {}
+        for real_nr, run_path in run_paths.items():
+            if export_values := self.write_to_runpath(run_path, real_nr, ensemble):
+                exports[real_nr] = export_values
+        return exports
+
     @abstractmethod
     def save_parameters(
         self,
@@ -82,7 +104,7 @@ def save_parameters(
     @abstractmethod
     def load_parameters(
         self, ensemble: Ensemble, realizations: npt.NDArray[np.int_]
-    ) -> npt.NDArray[np.float64]:
+    ) -> npt.NDArray[np.floating[Any]]:
         """
         Load the parameter from internal storage for the given ensemble.
         Must return array of shape (number of parameters, number of realizations).
@@ -19,6 +19,7 @@
 from .config_errors import ConfigValidationError, ConfigWarning
 from .config_schema import SchemaItem, define_keyword
 from .error_info import ErrorInfo
+from .parse_cache import get_parse_cache
 from .schema_dict import SchemaItemDict
 from .types import Defines, FileContextToken, Instruction, MaybeWithContext
 
@@ -419,7 +420,14 @@ def _handle_includes(
 
 
 def _parse_contents(content: str, file: str) -> Tree[Instruction]:
-    file = os.path.normpath(os.path.abspath(file))
+    # Included files are parsed, and cached, separately as the file that is
+    # included may depend on the defines in the including file
+    return get_parse_cache().get(
+        "config", os.path.normpath(os.path.abspath(file)), content, _parse_tree
+    )
+
+
+def _parse_tree(content: str, file: str) -> Tree[Instruction]:
     try:
         tree = _parser.parse(content + "\n")
         return (
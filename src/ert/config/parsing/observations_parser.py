@@ -1,4 +1,5 @@
 import os
+import re
 from collections import Counter
 from collections.abc import Sequence
 from dataclasses import dataclass
@@ -10,12 +11,13 @@
     no_type_check,
 )
 
-from lark import Lark, Transformer, UnexpectedCharacters, UnexpectedToken
+from lark import Lark, Token, Transformer, UnexpectedCharacters, UnexpectedToken
 
 from .config_errors import ConfigValidationError
 from .error_info import ErrorInfo
 from .file_context_token import FileContextToken
 from .lark_parser import FileContextTransformer
+from .parse_cache import get_parse_cache
 
 ErrorModes = Literal["REL", "ABS", "RELMIN"]
 
@@ -106,23 +108,45 @@ class GenObsValues(DateValues, _GenObsValues):
 def parse(filename: str) -> ConfContent:
     filepath = os.path.normpath(os.path.abspath(filename))
     with open(filepath, encoding="utf-8") as f:
-        return _validate_conf_content(
-            os.path.dirname(filename), _parse_content_list(f.read(), filename)
-        )
+        return parse_content(f.read(), filename)
 
 
 def parse_content(content: str, filename: str) -> ConfContent:
+    conf_content = get_parse_cache().get(
+        "observations", filename, content, _parse_and_validate
+    )
+    if not _referenced_files_exist(conf_content):
+        # Gives the error of the file that no longer exists
+        return _parse_and_validate(content, filename)
+    return conf_content
+
+
+def _parse_and_validate(content: str, filename: str) -> ConfContent:
     return _validate_conf_content(
         os.path.dirname(filename), _parse_content_list(content, filename)
     )
 
 
+def _referenced_files_exist(conf_content: ConfContent) -> bool:
+    return all(
+        os.path.exists(path)
+        for _, values in conf_content
+        if isinstance(values, GenObsValues)
+        for path in (values.obs_file, values.index_file)
+        if path is not None
+    )
+
+
 def _parse_content_list(
     content: str, filename: str
 ) -> list[
     SimpleHistoryDeclaration
     | tuple[ObservationType, FileContextToken, dict[FileContextToken, Any]]
 ]:
+    try:
+        return _FastObservationParser(content, filename).parse()
+    except _NotFastParsable:
+        pass
     try:
         return (FileContextTransformer(filename) * TreeToObservations()).transform(
             observations_parser.parse(content)
@@ -223,6 +247,130 @@ def segment(tree):
     pair = tuple
 
 
+class _NotFastParsable(Exception):
+    """The content is left to the Lark parser, which gives the error messages"""
+
+
+_OBSERVATION_TYPES = {
+    "HISTORY_OBSERVATION": ObservationType.HISTORY,
+    "SUMMARY_OBSERVATION": ObservationType.SUMMARY,
+    "GENERAL_OBSERVATION": ObservationType.GENERAL,
+}
+_KEYWORDS = {*_OBSERVATION_TYPES, "SEGMENT"}
+_SYMBOLS = {";", "{", "}", "="}
+# Whitespace is skipped between tokens, and comments start with -- where a
+# token would start
+_TOKENS = re.compile(r"--|[;{}=]|[^; \t{}=]+")
+
+
+class _FastObservationParser:
+    """Parser of the observations grammar that gives the same result as
+    parsing with observations_parser and TreeToObservations, but is many times
+    faster for files with many observations.
+
+    It only parses content that is syntactically correct and where keywords
+    are only used as keywords, and raises _NotFastParsable for anything else,
+    including whitespace that the grammar treats specially, so that the Lark
+    parser decides what is correct and how errors are reported."""
+
+    def __init__(self, content: str, filename: str) -> None:
+        if "\r" in content or "\f" in content:
+            raise _NotFastParsable
+        self.tokens = self._tokenize(content, filename)
+        self.position = 0
+
+    @staticmethod
+    def _tokenize(content: str, filename: str) -> list[str]:
+        # Symbols are plain strings, and strings are FileContextTokens
+        tokens: list[str] = []
+        offset = 0
+        for line, text in enumerate(content.split("\n"), start=1):
+            for match in _TOKENS.finditer(text):
+                value = match.group()
+                if value == "--":
+                    break
+                if value in _SYMBOLS:
+                    tokens.append(value)
+                    continue
+                start, end = match.span()
+                tokens.append(
+                    FileContextToken(
+                        Token(
+                            "STRING",
+                            value,
+                            offset + start,
+                            line,
+                            start + 1,
+                            line,
+                            end + 1,
+                            offset + end,
+                        ),
+                        filename,
+                    )
+                )
+            offset += len(text) + 1
+        return tokens
+
+    def parse(
+        self,
+    ) -> list[
+        SimpleHistoryDeclaration
+        | tuple[ObservationType, FileContextToken, dict[FileContextToken, Any]]
+    ]:
+        observations: list[Any] = []
+        while self.position < len(self.tokens):
+            observation_type = _OBSERVATION_TYPES.get(self._next())
+            if observation_type is None:
+                raise _NotFastParsable
+            name = self._string()
+            token = self._next()
+            if token == "{":
+                observations.append((observation_type, name, self._object()))
+                self._expect(";")
+            elif token == ";":
+                observations.append((observation_type, name))
+            else:
+                raise _NotFastParsable
+        return observations
+
+    def _object(self) -> dict[Any, Any]:
+        declarations: list[tuple[Any, Any]] = []
+        while (token := self._next()) != "}":
+            if token == "SEGMENT":
+                name = self._string()
+                self._expect("{")
+                declarations.append(("SEGMENT", (name, self._object())))
+            elif token in _SYMBOLS or token in _KEYWORDS:
+                raise _NotFastParsable
+            else:
+                self._expect("=")
+                value: Any = self._next()
+                if value == "{":
+                    value = self._object()
+                elif value in _SYMBOLS or value in _KEYWORDS:
+                    raise _NotFastParsable
+                declarations.append((token, value))
+            self._expect(";")
+        return dict(declarations)
+
+    def _next(self) -> str:
+        if self.position >= len(self.tokens):
+            raise _NotFastParsable
+        token = self.tokens[self.position]
+        self.position += 1
+        return token
+
+    def _string(self) -> str:
+        token = self._next()
+        if token in _SYMBOLS or token in _KEYWORDS:
+            raise _NotFastParsable
+        return token
+
+    def _expect(self, symbol: str) -> None:
+        if self._next() != symbol:
+            raise _NotFastParsable
+
+
 def _validate_conf_content(
     directory: str,
     inp: Sequence[
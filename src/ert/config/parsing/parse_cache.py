@@ -0,0 +1,162 @@
+"""
+Cache of the results of parsing configuration files.
+
+Parsing large configurations, and in particular observation files with
+hundreds of thousands of observations, takes a noticeable amount of time
+every time the configuration is loaded, although the files seldom change.
+Parse results are kept pickled, keyed on the hash of the content of the file,
+in memory and, if ERT_PARSE_CACHE_DIR is set, in that directory so that they
+are shared between processes. Pickled results are unpickled into new objects
+on every lookup, so callers are free to modify what they get.
+
+Unpickling runs code given by the pickle, so a cache directory or file that is
+not owned by the current user, or that other users can write to, is ignored.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import logging
+import os
+import pickle
+import stat
+import threading
+from collections import OrderedDict
+from collections.abc import Callable
+from pathlib import Path
+from typing import Final, TypeVar
+
+from ert.shared import __version__
+
+logger = logging.getLogger(__name__)
+
+T = TypeVar("T")
+
+DEFAULT_PARSE_CACHE_SIZE: Final = 64 * 1024**2
+"""Bytes of pickled parse results that are kept in memory. The most recent
+result is kept even if it is larger, e.g. for a large observation file"""
+
+
+def _is_private(status: os.stat_result) -> bool:
+    """Whether the file is owned by the current user and cannot be written by
+    anyone else, so that no one else can have put a pickle there"""
+    return status.st_uid == os.getuid() and not status.st_mode & (
+        stat.S_IWGRP | stat.S_IWOTH
+    )
+
+
+class ParseCache:
+    """Least recently used cache of pickled parse results by the hash of the
+    kind of parse, the name and the content of the file"""
+
+    def __init__(
+        self,
+        max_size: int = DEFAULT_PARSE_CACHE_SIZE,
+        directory: str | os.PathLike[str] | None = None,
+    ) -> None:
+        self.max_size = max_size
+        self.directory = Path(directory) if directory is not None else None
+        self._entries: OrderedDict[str, bytes] = OrderedDict()
+        self._size = 0
+        self._lock = threading.Lock()
+
+    @staticmethod
+    def key(kind: str, filename: str, content: str) -> str:
+        digest = hashlib.sha256()
+        for part in (__version__, kind, filename, content):
+            digest.update(part.encode("utf-8", errors="surrogateescape"))
+            digest.update(b"\0")
+        return digest.hexdigest()
+
+    def get(
+        self,
+        kind: str,
+        filename: str,
+        content: str,
+        parse: Callable[[str, str], T],
+    ) -> T:
+        """The result of parse(content, filename), parsed only if there is no
+        result cached for the same content of the file. Errors raised by parse
+        are not cached."""
+        key = self.key(kind, filename, content)
+        pickled = self._lookup(key)
+        if pickled is not None:
+            try:
+                return pickle.loads(pickled)
+            except Exception as err:
+                logger.warning(f"Discarding cached parse of {filename}: {err}")
+        result = parse(content, filename)
+        self._store(key, pickle.dumps(result, protocol=pickle.HIGHEST_PROTOCOL))
+        return result
+
+    def clear(self) -> None:
+        with self._lock:
+            self._entries.clear()
+            self._size = 0
+
+    def _lookup(self, key: str) -> bytes | None:
+        with self._lock:
+            pickled = self._entries.get(key)
+            if pickled is not None:
+                self._entries.move_to_end(key)
+                return pickled
+        if self.directory is not None:
+            pickled = self._read_private(self.directory / f"{key}.pickle")
+            if pickled is not None:
+                self._remember(key, pickled)
+        return pickled
+
+    def _read_private(self, path: Path) -> bytes | None:
+        assert self.directory is not None
+        try:
+            if not _is_private(self.directory.stat()):
+                logger.warning(
+                    f"Ignoring the parse cache {self.directory}, as it is not "
+                    "owned by the current user or can be written by others"
+                )
+                return None
+            with open(path, "rb") as f:
+                if not _is_private(os.fstat(f.fileno())):
+                    logger.warning(
+                        f"Ignoring the cached parse {path}, as it is not owned "
+                        "by the current user or can be written by others"
+                    )
+                    return None
+                return f.read()
+        except OSError:
+            return None
+
+    def _store(self, key: str, pickled: bytes) -> None:
+        self._remember(key, pickled)
+        if self.directory is not None:
+            path = self.directory / f"{key}.pickle"
+            try:
+                self.directory.mkdir(mode=0o700, parents=True, exist_ok=True)
+                if not _is_private(self.directory.stat()):
+                    return
+                tmp_path = path.with_suffix(f".{os.getpid()}.tmp")
+                tmp_path.write_bytes(pickled)
+                tmp_path.chmod(0o600)
+                tmp_path.replace(path)
+            except OSError as err:
+                logger.debug(f"Could not write parse cache {path}: {err}")
+
+    def _remember(self, key: str, pickled: bytes) -> None:
+        with self._lock:
+            if key in self._entries:
+                return
+            self._entries[key] = pickled
+            self._size += len(pickled)
+            while self._size > self.max_size and len(self._entries) > 1:
+                _, evicted = self._entries.popitem(last=False)
+                self._size -= len(evicted)
+
+
+_parse_cache: ParseCache | None = None
+
+
+def get_parse_cache() -> ParseCache:
+    global _parse_cache
+    if _parse_cache is None:
+        _parse_cache = ParseCache(directory=os.environ.get("ERT_PARSE_CACHE_DIR"))
+    return _parse_cache
@@ -37,6 +37,19 @@ def activate_script() -> str:
     return ""
 
 
+# Queue options that are handled by ert and not passed on to the driver
+_NON_DRIVER_OPTIONS = {
+    "name",
+    "max_running",
+    "submit_sleep",
+    "internalization_workers",
+    "submit_when_runpath_ready",
+    "forward_model_telemetry",
+    "predictive_scheduling",
+    "compact_jobs_json",
+}
+
+
 class QueueOptions(
     BaseModelWithContextSupport,
     validate_assignment=True,
@@ -47,9 +60,20 @@ class QueueOptions(
     name: QueueSystem
     max_running: pydantic.NonNegativeInt = 0
     submit_sleep: pydantic.NonNegativeFloat = 0.0
+    internalization_workers: pydantic.PositiveInt = 1
+    submit_when_runpath_ready: bool = False
+    # See _ert.forward_model_runner.reporting.telemetry
+    forward_model_telemetry: Literal["FULL", "CHANGES", "PEAKS"] = "FULL"
+    predictive_scheduling: bool = False
+    compact_jobs_json: bool = False
     project_code: str | None = None
     activate_script: str | None = Field(default=None, validate_default=True)
 
+    @field_validator("forward_model_telemetry", mode="before")
+    @classmethod
+    def upper_case_telemetry_mode(cls, v: Any) -> Any:
+        return v.upper() if isinstance(v, str) else v
+
     @field_validator("activate_script", mode="before")
     @classmethod
     def inject_site_config_script(cls, v: str, info: ValidationInfo) -> str:
@@ -125,10 +149,11 @@ class LsfQueueOptions(QueueOptions):
     exclude_host: str | None = None
     lsf_queue: NonEmptyString | None = None
     lsf_resource: str | None = None
+    job_arrays: bool = False
 
     @property
     def driver_options(self) -> dict[str, Any]:
-        driver_dict = self.model_dump(exclude={"name", "submit_sleep", "max_running"})
+        driver_dict = self.model_dump(exclude=_NON_DRIVER_OPTIONS)
         driver_dict["exclude_hosts"] = driver_dict.pop("exclude_host")
         driver_dict["queue_name"] = driver_dict.pop("lsf_queue")
         driver_dict["resource_requirement"] = driver_dict.pop("lsf_resource")
@@ -144,16 +169,11 @@ class TorqueQueueOptions(QueueOptions):
     cluster_label: NonEmptyString | None = None
     job_prefix: NonEmptyString | None = None
     keep_qsub_output: bool = False
+    job_arrays: bool = False
 
     @property
     def driver_options(self) -> dict[str, Any]:
-        driver_dict = self.model_dump(
-            exclude={
-                "name",
-                "max_running",
-                "submit_sleep",
-            }
-        )
+        driver_dict = self.model_dump(exclude=_NON_DRIVER_OPTIONS)
         driver_dict["queue_name"] = driver_dict.pop("queue")
         return driver_dict
 
@@ -170,10 +190,11 @@ class SlurmQueueOptions(QueueOptions):
     partition: NonEmptyString | None = None  # aka queue_name
     squeue_timeout: pydantic.PositiveFloat = 2
     max_runtime: pydantic.NonNegativeFloat | None = None
+    job_arrays: bool = False
 
     @property
     def driver_options(self) -> dict[str, Any]:
-        driver_dict = self.model_dump(exclude={"name", "max_running", "submit_sleep"})
+        driver_dict = self.model_dump(exclude=_NON_DRIVER_OPTIONS)
         driver_dict["sbatch_cmd"] = driver_dict.pop("sbatch")
         driver_dict["scancel_cmd"] = driver_dict.pop("scancel")
         driver_dict["scontrol_cmd"] = driver_dict.pop("scontrol")
@@ -347,7 +368,14 @@ def create_local_copy(self) -> QueueConfig:
             self.realization_memory,
             self.max_submit,
             QueueSystem.LOCAL,
-            LocalQueueOptions(max_running=self.max_running),
+            LocalQueueOptions(
+                max_running=self.max_running,
+                internalization_workers=self.internalization_workers,
+                submit_when_runpath_ready=self.submit_when_runpath_ready,
+                forward_model_telemetry=self.forward_model_telemetry,
+                predictive_scheduling=self.predictive_scheduling,
+                compact_jobs_json=self.compact_jobs_json,
+            ),
             stop_long_running=bool(self.stop_long_running),
             max_runtime=self.max_runtime,
         )
@@ -360,6 +388,26 @@ def max_running(self) -> int:
     def submit_sleep(self) -> float:
         return self.queue_options.submit_sleep
 
+    @property
+    def internalization_workers(self) -> int:
+        return self.queue_options.internalization_workers
+
+    @property
+    def submit_when_runpath_ready(self) -> bool:
+        return self.queue_options.submit_when_runpath_ready
+
+    @property
+    def forward_model_telemetry(self) -> str:
+        return self.queue_options.forward_model_telemetry
+
+    @property
+    def predictive_scheduling(self) -> bool:
+        return self.queue_options.predictive_scheduling
+
+    @property
+    def compact_jobs_json(self) -> bool:
+        return self.queue_options.compact_jobs_json
+
 
 def _parse_realization_memory_str(realization_memory_str: str) -> int:
     if "-" in realization_memory_str:
@@ -15,6 +15,8 @@
 from .parsing import ConfigValidationError, ErrorInfo
 
 if TYPE_CHECKING:
+    from collections.abc import Mapping
+
     import numpy.typing as npt
 
     from ert.storage import Ensemble
@@ -124,7 +126,28 @@ def write_to_runpath(
         self, run_path: Path, real_nr: int, ensemble: Ensemble
     ) -> None:
         data = ensemble.load_parameters(self.name, real_nr)["values"]
-
+        self._save_to_runpath(run_path, real_nr, ensemble.iteration, data.values)
+
+    def write_to_runpaths(
+        self, run_paths: Mapping[int, Path], ensemble: Ensemble
+    ) -> dict[int, dict[str, dict[str, float]]]:
+        """Loads the surface for all the realizations at once"""
+        if not run_paths:
+            return {}
+        values = ensemble.load_parameters(self.name, np.array(list(run_paths)))[
+            "values"
+        ].values
+        for data, (real_nr, run_path) in zip(values, run_paths.items(), strict=True):
+            self._save_to_runpath(run_path, real_nr, ensemble.iteration, data)
+        return {}
+
+    def _save_to_runpath(
+        self,
+        run_path: Path,
+        real_nr: int,
+        iteration: int,
+        values: npt.NDArray[np.float32],
+    ) -> None:
         surf = xtgeo.RegularSurface(
             ncol=self.ncol,
             nrow=self.nrow,
@@ -134,11 +157,11 @@ def write_to_runpath(
             yinc=self.yinc,
             rotation=self.rotation,
             yflip=self.yflip,
-            values=data.values,
+            values=values,
         )
 
         file_path = run_path / substitute_runpath_name(
-            str(self.output_file), real_nr, ensemble.iteration
+            str(self.output_file), real_nr, iteration
         )
         file_path.parent.mkdir(exist_ok=True, parents=True)
         surf.to_file(file_path, fformat="irap_ascii")
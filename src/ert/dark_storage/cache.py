@@ -0,0 +1,211 @@
+"""
+Cache of the records computed from storage by the record endpoints.
+
+The plotter asks for the same records again and again while the user switches
+between keys and ensembles, and each of them is computed from the files of
+every realization in the ensemble. Records are cached by ensemble and key
+within a memory budget, least recently used first out, and are recomputed
+when the files of the ensemble change, e.g. while it is still running.
+"""
+
+from __future__ import annotations
+
+import contextlib
+import logging
+import os
+import sys
+import threading
+from collections import OrderedDict
+from collections.abc import Callable, Iterable
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Final
+from uuid import UUID
+
+import numpy as np
+import pandas as pd
+import polars as pl
+
+from ert.storage import Ensemble
+
+logger = logging.getLogger(__name__)
+
+DEFAULT_RECORD_CACHE_SIZE: Final = 256 * 1024**2
+"""Bytes of records that are cached, unless ERT_STORAGE_RECORD_CACHE_SIZE is set"""
+PREFETCH_DISTANCE: Final = 2
+"""Number of keys on each side of a requested key that are prefetched"""
+
+CacheKey = tuple[UUID, str, str]
+
+
+@dataclass
+class _Entry:
+    version: tuple[int, ...]
+    value: Any
+    size: int
+
+
+def ensemble_version(ensemble: Ensemble) -> tuple[int, ...]:
+    """A token that changes whenever files are written to the ensemble.
+
+    Storage writes files by renaming them into place, which updates the
+    modification time of the directory of the ensemble or of the realization
+    the file is written to, and touches the directory of a parameter group
+    after writing to its ensemble-wide arrays in place. The state file is
+    renamed into place after every write, or when a write-behind context
+    exits, which tells writes apart that happen within the resolution of the
+    modification times."""
+    mount_point = ensemble.mount_point
+    mtimes = [os.stat(mount_point).st_mtime_ns]
+    mtimes.extend(_directory_mtimes(mount_point, "realization-"))
+    with contextlib.suppress(FileNotFoundError):
+        mtimes.extend(_directory_mtimes(mount_point / "parameters"))
+    try:
+        state = os.stat(mount_point / "state.json")
+    except FileNotFoundError:
+        state_file = (0, 0)
+    else:
+        state_file = (state.st_ino, state.st_mtime_ns)
+    return len(mtimes), max(mtimes), *state_file
+
+
+def _directory_mtimes(path: Path, prefix: str = "") -> list[int]:
+    with os.scandir(path) as entries:
+        return [
+            entry.stat().st_mtime_ns
+            for entry in entries
+            if entry.name.startswith(prefix) and entry.is_dir()
+        ]
+
+
+def size_of(value: Any) -> int:
+    """The approximate number of bytes a cached value takes up"""
+    if isinstance(value, pl.DataFrame):
+        return int(value.estimated_size())
+    if isinstance(value, pd.DataFrame):
+        return int(value.memory_usage(deep=True).sum())
+    if isinstance(value, np.ndarray):
+        return int(value.nbytes)
+    return sys.getsizeof(value)
+
+
+class RecordCache:
+    """Least recently used cache of records by (ensemble id, kind, key), where
+    kind tells records of the same key in different formats apart"""
+
+    def __init__(self, max_size: int = DEFAULT_RECORD_CACHE_SIZE) -> None:
+        self.max_size = max_size
+        self._entries: OrderedDict[CacheKey, _Entry] = OrderedDict()
+        self._size = 0
+        self._lock = threading.Lock()
+        self._prefetching: set[CacheKey] = set()
+        self._executor = ThreadPoolExecutor(
+            max_workers=1, thread_name_prefix="record_prefetch"
+        )
+
+    @property
+    def size(self) -> int:
+        return self._size
+
+    def __contains__(self, key: CacheKey) -> bool:
+        with self._lock:
+            return key in self._entries
+
+    def get(
+        self,
+        ensemble: Ensemble,
+        kind: str,
+        key: str,
+        compute: Callable[[Ensemble, str], Any],
+    ) -> Any:
+        """The cached record of the given kind for the key in the ensemble,
+        computed by compute(ensemble, key) if it is not cached or the ensemble
+        has changed since it was cached"""
+        cache_key = (ensemble.id, kind, key)
+        version = ensemble_version(ensemble)
+        with self._lock:
+            entry = self._entries.get(cache_key)
+            if entry is not None and entry.version == version:
+                self._entries.move_to_end(cache_key)
+                return entry.value
+        value = compute(ensemble, key)
+        self._put(cache_key, _Entry(version, value, size_of(value)))
+        return value
+
+    def prefetch(
+        self,
+        ensemble: Ensemble,
+        kind: str,
+        keys: Iterable[str],
+        compute: Callable[[Ensemble, str], Any],
+    ) -> None:
+        """Compute and cache the records of the keys in the background"""
+        for key in keys:
+            cache_key = (ensemble.id, kind, key)
+            with self._lock:
+                if cache_key in self._entries or cache_key in self._prefetching:
+                    continue
+                self._prefetching.add(cache_key)
+            self._executor.submit(self._prefetch, ensemble, kind, key, compute)
+
+    def clear(self) -> None:
+        with self._lock:
+            self._entries.clear()
+            self._size = 0
+
+    def _prefetch(
+        self,
+        ensemble: Ensemble,
+        kind: str,
+        key: str,
+        compute: Callable[[Ensemble, str], Any],
+    ) -> None:
+        try:
+            self.get(ensemble, kind, key, compute)
+        except Exception as err:
+            # The record is computed again, and the error raised, if requested
+            logger.debug(f"Failed to prefetch {kind} of {key}: {err}")
+        finally:
+            with self._lock:
+                self._prefetching.discard((ensemble.id, kind, key))
+
+    def _put(self, cache_key: CacheKey, entry: _Entry) -> None:
+        with self._lock:
+            old = self._entries.pop(cache_key, None)
+            if old is not None:
+                self._size -= old.size
+            if entry.size > self.max_size:
+                return
+            self._entries[cache_key] = entry
+            self._size += entry.size
+            while self._size > self.max_size:
+                _, evicted = self._entries.popitem(last=False)
+                self._size -= evicted.size
+
+
+def neighbouring_keys(keys: list[str], key: str) -> list[str]:
+    """The keys that follow and precede key in keys, nearest first"""
+    try:
+        index = keys.index(key)
+    except ValueError:
+        return []
+    following = keys[index + 1 : index + 1 + PREFETCH_DISTANCE]
+    preceding = keys[max(index - PREFETCH_DISTANCE, 0) : index][::-1]
+    return following + preceding
+
+
+_record_cache: RecordCache | None = None
+
+
+def get_record_cache() -> RecordCache:
+    global _record_cache
+    if _record_cache is None:
+        _record_cache = RecordCache(
+            int(
+                os.environ.get(
+                    "ERT_STORAGE_RECORD_CACHE_SIZE", DEFAULT_RECORD_CACHE_SIZE
+                )
+            )
+        )
+    return _record_cache
@@ -100,16 +100,7 @@ def gen_data_display_keys(ensemble: Ensemble) -> Iterator[str]:
                     yield f"{key}@{report_step}"
 
 
-def data_for_key(
-    ensemble: Ensemble,
-    key: str,
-) -> pd.DataFrame:
-    """Returns a pandas DataFrame with the datapoints for a given key for a
-    given ensemble. The row index is the realization number, and the columns are an
-    index over the indexes/dates"""
-
-    key = key.removeprefix("LOG10_")
-
+def _response_key_and_type(ensemble: Ensemble, key: str) -> tuple[str, str] | None:
     response_key_to_response_type = ensemble.experiment.response_key_to_response_type
 
     # Check for exact match first. For example if key is "FOPRH"
@@ -120,54 +111,127 @@ def data_for_key(
             (k for k in response_key_to_response_type if k in key and key != f"{k}H"),
             None,
         )
+    if response_key is None:
+        return None
+    return response_key, response_key_to_response_type[response_key]
+
+
+def _summary_for_key(ensemble: Ensemble, response_key: str) -> pl.DataFrame:
+    """The (realization, time, values) of the summary key, only reading those
+    columns of the row groups that hold the key"""
+    summary_data = ensemble.load_responses(
+        response_key,
+        tuple(ensemble.get_realization_list_with_responses()),
+        columns=["realization", "time", "values"],
+    )
+    # This performs the same aggragation by mean of duplicate values
+    # as in ert/analysis/_es_update.py
+    return (
+        summary_data.group_by("realization", "time")
+        .agg(pl.col("values").mean())
+        .sort("realization", "time")
+    )
+
+
+def _gen_data_for_key(ensemble: Ensemble, key: str) -> pl.DataFrame | None:
+    """The (realization, index, values) of the gen data key, or None if the
+    key does not name a report step of a gen data response"""
+    try:
+        # Call below will ValueError if key ends with H,
+        # requested via PlotAPI.history_data
+        response_key, report_step = displayed_key_to_response_key["gen_data"](key)
+        mask = ensemble.get_realization_mask_with_responses()
+        realizations = np.where(mask)[0]
+        assert isinstance(response_key, str)
+        data = ensemble.load_responses(
+            response_key,
+            tuple(realizations),
+            columns=["realization", "report_step", "index", "values"],
+        )
+    except ValueError as err:
+        logger.info(f"Dark storage could not load response {key}: {err}")
+        return None
+    except ColumnNotFoundError:
+        return None
+    return (
+        data.filter(pl.col("report_step").eq(report_step))
+        .drop("report_step")
+        .sort("realization", "index")
+    )
+
+
+def records_for_key(ensemble: Ensemble, key: str) -> pl.DataFrame:
+    """The datapoints of data_for_key as a polars DataFrame, with the
+    realization number in the Realization column and one column named by each
+    index/date, so that responses are not converted to pandas"""
+    key = key.removeprefix("LOG10_")
+    found = _response_key_and_type(ensemble, key)
+    if found is not None and found[1] in {"summary", "gen_data"}:
+        response_key, response_type = found
+        if response_type == "summary":
+            long = _summary_for_key(ensemble, response_key).with_columns(
+                pl.col("time").dt.strftime("%Y-%m-%d %H:%M:%S").alias("axis")
+            )
+            on = "time"
+        else:
+            gen_data = _gen_data_for_key(ensemble, key)
+            if gen_data is None:
+                return pl.DataFrame()
+            long = gen_data.with_columns(pl.col("index").cast(pl.String).alias("axis"))
+            on = "index"
+        if long.is_empty():
+            return pl.DataFrame()
+        # Sorting before pivoting keeps the columns in index/date order
+        return (
+            long.sort(on, "realization")
+            .pivot(on="axis", index="realization", values="values")
+            .sort("realization")
+            .rename({"realization": "Realization"})
+            .cast({pl.Float32: pl.Float64})
+        )
+
+    data = data_for_key(ensemble, key)
+    if data.empty:
+        return pl.DataFrame()
+    data.columns = [str(column) for column in data.columns]
+    return pl.from_pandas(data.reset_index(names="Realization"))
 
-    if response_key is not None:
-        response_type = response_key_to_response_type[response_key]
+
+def data_for_key(
+    ensemble: Ensemble,
+    key: str,
+) -> pd.DataFrame:
+    """Returns a pandas DataFrame with the datapoints for a given key for a
+    given ensemble. The row index is the realization number, and the columns are an
+    index over the indexes/dates"""
+
+    key = key.removeprefix("LOG10_")
+
+    if (found := _response_key_and_type(ensemble, key)) is not None:
+        response_key, response_type = found
 
         if response_type == "summary":
-            summary_data = ensemble.load_responses(
-                response_key,
-                tuple(ensemble.get_realization_list_with_responses()),
-            )
+            summary_data = _summary_for_key(ensemble, response_key)
             if summary_data.is_empty():
                 return pd.DataFrame()
 
-            df = (
+            data = (
                 summary_data.rename({"time": "Date", "realization": "Realization"})
-                .drop("response_key")
                 .to_pandas()
+                .pivot(index="Realization", columns="Date", values="values")
             )
-            df = df.set_index(["Date", "Realization"])
-            # This performs the same aggragation by mean of duplicate values
-            # as in ert/analysis/_es_update.py
-            df = df.groupby(["Date", "Realization"]).mean()
-            data = df.unstack(level="Date")
-            data.columns = data.columns.droplevel(0)
             try:
                 return data.astype(float)
             except ValueError:
                 return data
 
         if response_type == "gen_data":
-            try:
-                # Call below will ValueError if key ends with H,
-                # requested via PlotAPI.history_data
-                response_key, report_step = displayed_key_to_response_key["gen_data"](
-                    key
-                )
-                mask = ensemble.get_realization_mask_with_responses()
-                realizations = np.where(mask)[0]
-                assert isinstance(response_key, str)
-                data = ensemble.load_responses(response_key, tuple(realizations))
-            except ValueError as err:
-                logger.info(f"Dark storage could not load response {key}: {err}")
+            gen_data = _gen_data_for_key(ensemble, key)
+            if gen_data is None:
                 return pd.DataFrame()
 
             try:
-                vals = data.filter(pl.col("report_step").eq(report_step))
-                pivoted = vals.drop("response_key", "report_step").pivot(
-                    on="index", values="values"
-                )
+                pivoted = gen_data.pivot(on="index", values="values")
                 data = pivoted.to_pandas().set_index("realization")
                 data.columns = data.columns.astype(int)
                 data.columns.name = "axis"
@@ -1,38 +1,79 @@
-from collections.abc import Mapping
+from datetime import datetime
 
 import numpy as np
 import numpy.typing as npt
 import pandas as pd
+import polars as pl
+from dateutil.parser import parse
 
+from ert.dark_storage.common import (
+    displayed_key_to_response_key,
+    gen_data_display_keys,
+    get_observation_keys_for_response,
+)
+from ert.storage import Ensemble
 
-def _calculate_misfit(
-    obs_value: npt.NDArray[np.float64],
-    response_value: npt.NDArray[np.float64],
-    obs_std: npt.NDArray[np.float64],
-) -> list[float]:
-    difference = response_value - obs_value
-    misfit = (difference / obs_std) ** 2
-    return (misfit * np.sign(difference)).tolist()
 
+def calculate_misfits(
+    observations: npt.NDArray[np.floating],
+    errors: npt.NDArray[np.floating],
+    responses: npt.NDArray[np.floating],
+) -> npt.NDArray[np.float64]:
+    """
+    Signed misfits of the (observations, realizations) matrix of responses,
+    i.e. the squared difference from the observations in units of the error,
+    with the sign of the difference
+    """
+    difference = responses.astype(np.float64) - observations[:, np.newaxis]
+    return np.sign(difference) * (difference / errors[:, np.newaxis]) ** 2
+
+
+def _parse_index(index: str) -> int | datetime:
+    # The index of gen_data observations is "report_step, index"
+    x_axis = index.rsplit(", ", 1)[-1]
+    try:
+        return int(x_axis)
+    except ValueError:
+        return parse(x_axis)
 
-def calculate_misfits_from_pandas(
-    reponses_dict: Mapping[int, pd.DataFrame],
-    observation: pd.DataFrame,
-    summary_misfits: bool = False,
-) -> pd.DataFrame:
+
+def misfits_for_response(ensemble: Ensemble, response_name: str) -> pd.DataFrame:
     """
-    Compute misfits from reponses_dict (real_id, values in dataframe)
-    and observation
+    Misfits of the realizations with responses in the ensemble against the
+    observations of the displayed response key, with one row per realization
+    and one column per index/date of the observations. The responses are
+    aligned with the observations as for the update.
     """
-    misfits_dict = {}
-    for realization_index in reponses_dict:
-        misfits_dict[realization_index] = _calculate_misfit(
-            observation["values"],
-            reponses_dict[realization_index].loc[:, observation.index].values.flatten(),
-            observation["errors"],
+    observation_keys = get_observation_keys_for_response(ensemble, response_name)
+    if not observation_keys:
+        raise ValueError(f"No observations for key {response_name}")
+
+    if response_name in gen_data_display_keys(ensemble):
+        response_key, report_step = displayed_key_to_response_key["gen_data"](
+            response_name
         )
+        in_response = (pl.col("response_key") == response_key) & pl.col(
+            "index"
+        ).str.starts_with(f"{report_step}, ")
+    else:
+        in_response = pl.col("response_key") == response_name
+
+    realizations = ensemble.get_realization_list_with_responses()
+    aligned = ensemble.get_observations_and_responses(
+        observation_keys, np.array(realizations, dtype=int)
+    ).filter(in_response)
+    misfits = calculate_misfits(
+        aligned["observations"].to_numpy(),
+        aligned["std"].to_numpy(),
+        aligned.select([str(real) for real in realizations]).to_numpy(),
+    )
+    return pd.DataFrame(
+        misfits.T,
+        index=realizations,
+        columns=[_parse_index(index) for index in aligned["index"]],
+    ).sort_index(axis=1, kind="stable")
+
 
-    df = pd.DataFrame(data=misfits_dict, index=observation.index)
-    if summary_misfits:
-        df = pd.DataFrame([df.abs().sum(axis=0)], columns=df.columns, index=[0])
-    return df.T
+def summarize_misfits(misfits: pd.DataFrame) -> pd.DataFrame:
+    """The sum of the absolute misfits of each realization"""
+    return misfits.abs().sum(axis=1).to_frame(0)
@@ -1,19 +1,11 @@
-from datetime import datetime
-from typing import Any
 from uuid import UUID
 
-import pandas as pd
-from dateutil.parser import parse
 from fastapi import APIRouter, Depends, status
 from fastapi.responses import Response
 
 from ert.dark_storage import exceptions as exc
-from ert.dark_storage.common import (
-    data_for_key,
-    get_observation_keys_for_response,
-    get_observations_for_obs_keys,
-)
-from ert.dark_storage.compute.misfits import calculate_misfits_from_pandas
+from ert.dark_storage.cache import get_record_cache
+from ert.dark_storage.compute.misfits import misfits_for_response, summarize_misfits
 from ert.dark_storage.enkf import get_storage
 from ert.storage import Storage
 
@@ -38,38 +30,14 @@ async def get_response_misfits(
     summary_misfits: bool = False,
 ) -> Response:
     ensemble = storage.get_ensemble(ensemble_id)
-    dataframe = data_for_key(ensemble, response_name)
-    if realization_index is not None:
-        dataframe = pd.DataFrame(dataframe.loc[realization_index]).T
-
-    response_dict = {}
-    for index, data in dataframe.iterrows():
-        data_df = pd.DataFrame(data).T
-        response_dict[index] = data_df
-
-    obs_keys = get_observation_keys_for_response(ensemble, response_name)
-    obs = get_observations_for_obs_keys(ensemble, obs_keys)
-
-    if not obs_keys:
-        raise ValueError(f"No observations for key {response_name}")
-    if not obs:
-        raise ValueError(f"Cant fetch observations for key {response_name}")
-    o = obs[0]
-
-    def parse_index(x: Any) -> int | datetime:
-        try:
-            return int(x)
-        except ValueError:
-            return parse(x)
-
-    observation_df = pd.DataFrame(
-        data={"values": o["values"], "errors": o["errors"]},
-        index=[parse_index(x) for x in o["x_axis"]],
-    )
     try:
-        result_df = calculate_misfits_from_pandas(
-            response_dict, observation_df, summary_misfits
+        result_df = get_record_cache().get(
+            ensemble, "misfits", response_name, misfits_for_response
         )
+        if realization_index is not None:
+            result_df = result_df.loc[[realization_index]]
+        if summary_misfits:
+            result_df = summarize_misfits(result_df)
     except Exception as misfits_exc:
         raise exc.UnprocessableError(
             f"Unable to compute misfits: {misfits_exc}"
@@ -6,20 +6,23 @@
 from uuid import UUID, uuid4
 
 import numpy as np
+import numpy.typing as npt
 from fastapi import APIRouter, Body, Depends, File, Header, HTTPException, status
 from fastapi.responses import Response
 
 from ert.dark_storage import json_schema as js
+from ert.dark_storage.cache import get_record_cache, neighbouring_keys
 from ert.dark_storage.common import (
     data_for_key,
     ensemble_parameters,
     gen_data_display_keys,
     get_observation_keys_for_response,
     get_observations_for_obs_keys,
+    records_for_key,
     response_key_to_displayed_key,
 )
 from ert.dark_storage.enkf import get_storage
-from ert.storage import Storage
+from ert.storage import Ensemble, Storage
 
 router = APIRouter(tags=["record"])
 
@@ -27,6 +30,7 @@
 DEFAULT_BODY = Body(...)
 DEFAULT_FILE = File(...)
 DEFAULT_HEADER = Header("application/json")
+ARROW_STREAM = "application/vnd.apache.arrow.stream"
 
 
 @router.get("/ensembles/{ensemble_id}/records/{response_name}/observations")
@@ -66,6 +70,7 @@ async def get_record_observations(
                 "application/json": {},
                 "text/csv": {},
                 "application/x-parquet": {},
+                ARROW_STREAM: {},
             }
         },
         status.HTTP_401_UNAUTHORIZED: {
@@ -83,12 +88,30 @@ async def get_ensemble_record(
     accept: Annotated[str | None, Header()] = None,
 ) -> Any:
     name = unquote(name)
+    media_type = accept if accept is not None else "text/csv"
+    ensemble = storage.get_ensemble(ensemble_id)
+    cache = get_record_cache()
+    if media_type == ARROW_STREAM:
+        try:
+            records = cache.get(ensemble, "records", name, records_for_key)
+        except PermissionError as e:
+            raise HTTPException(status_code=401, detail=str(e)) from e
+        cache.prefetch(
+            ensemble,
+            "records",
+            neighbouring_keys(_record_keys(storage, ensemble), name),
+            records_for_key,
+        )
+        stream = io.BytesIO()
+        records.write_ipc_stream(stream)
+        return Response(content=stream.getvalue(), media_type=ARROW_STREAM)
     try:
-        dataframe = data_for_key(storage.get_ensemble(ensemble_id), name)
+        dataframe = cache.get(ensemble, "data", name, data_for_key)
     except PermissionError as e:
         raise HTTPException(status_code=401, detail=str(e)) from e
-    media_type = accept if accept is not None else "text/csv"
     if media_type == "application/x-parquet":
+        # The cached dataframe is shared with other requests
+        dataframe = dataframe.copy(deep=False)
         dataframe.columns = [str(s) for s in dataframe.columns]
         stream = io.BytesIO()
         dataframe.to_parquet(stream)
@@ -105,6 +128,16 @@ async def get_ensemble_record(
         )
 
 
+def _record_keys(storage: Storage, ensemble: Ensemble) -> list[str]:
+    """The keys of the records of the ensemble, in the order the plotter
+    lists them"""
+    return [
+        *ensemble.experiment.response_type_to_response_keys.get("summary", []),
+        *gen_data_display_keys(ensemble),
+        *(param["name"] for param in ensemble_parameters(storage, ensemble.id)),
+    ]
+
+
 @router.get("/ensembles/{ensemble_id}/parameters", response_model=list[dict[str, Any]])
 async def get_ensemble_parameters(
     *, storage: Storage = DEFAULT_STORAGE, ensemble_id: UUID
@@ -165,6 +198,10 @@ def get_ensemble_responses(
     return response_map
 
 
+def _std_dev(ensemble: Ensemble, key: str) -> npt.NDArray[Any]:
+    return ensemble.calculate_std_dev_for_parameter(key)["values"].to_numpy()
+
+
 @router.get("/ensembles/{ensemble_id}/records/{key}/std_dev")
 def get_std_dev(
     *, storage: Storage = DEFAULT_STORAGE, ensemble_id: UUID, key: str, z: int
@@ -172,7 +209,7 @@ def get_std_dev(
     key = unquote(key)
     ensemble = storage.get_ensemble(ensemble_id)
     try:
-        da = ensemble.calculate_std_dev_for_parameter(key)["values"]
+        da = get_record_cache().get(ensemble, "std_dev", key, _std_dev)
     except ValueError as e:
         raise HTTPException(status_code=404, detail="Data not found") from e
 
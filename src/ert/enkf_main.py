@@ -3,7 +3,9 @@
 import json
 import logging
 import os
-from collections.abc import Iterable, Mapping
+from collections.abc import Callable, Iterable, Mapping
+from concurrent.futures import ThreadPoolExecutor, as_completed
+from dataclasses import dataclass
 from datetime import datetime
 from pathlib import Path
 from typing import TYPE_CHECKING, Any
@@ -13,7 +15,12 @@
 import xarray as xr
 from numpy.random import SeedSequence
 
-from ert.substitutions import Substitutions, substitute_runpath_name
+from ert.substitutions import (
+    Substitutions,
+    has_substitution_keys,
+    substitute_runpath_name,
+)
+from ert.trace import get_traceparent, tracer, with_current_context
 from ert.utils import log_duration
 
 from .config import (
@@ -34,6 +41,20 @@
 
 logger = logging.getLogger(__name__)
 
+# The largest number of realizations each parameter is loaded for at a time
+# when creating runpaths, which bounds the memory used for large fields
+RUNPATH_BATCH_SIZE = 50
+
+
+def _runpath_batch_size(num_realizations: int, max_workers: int | None) -> int:
+    """Batches small enough that every worker gets one, so that batching
+    does not limit how many runpaths are written at the same time, and that
+    the first runpaths are ready early"""
+    if max_workers is None:
+        # The default of concurrent.futures.ThreadPoolExecutor
+        max_workers = min(32, (os.cpu_count() or 1) + 4)
+    return max(1, min(RUNPATH_BATCH_SIZE, -(-num_realizations // max_workers)))
+
 
 def _backup_if_existing(path: Path) -> None:
     if not path.exists():
@@ -87,8 +108,7 @@ def _value_export_json(
 def _generate_parameter_files(
     parameter_configs: Iterable[ParameterConfig],
     export_base_name: str,
-    run_path: Path,
-    iens: int,
+    run_paths: Mapping[int, Path],
     fs: Ensemble,
     iteration: int,
 ) -> None:
@@ -96,16 +116,17 @@ def _generate_parameter_files(
     Generate parameter files that are placed in each runtime directory for
     forward-model jobs to consume.
 
+    Each parameter is loaded from the ensemble once for all the realizations.
+
     Args:
         parameter_configs: Configuration which contains the parameter nodes for this
             ensemble run.
         export_base_name: Base name for the GEN_KW parameters file. Ie. the
             `parameters` in `parameters.json`.
-        run_path: Path to the runtime directory
-        iens: Realisation index
+        run_paths: Path to the runtime directory of each realisation index
         fs: Ensemble from which to load parameter data
     """
-    exports: dict[str, dict[str, float]] = {}
+    exports: dict[int, dict[str, dict[str, float]]] = {iens: {} for iens in run_paths}
 
     for node in parameter_configs:
         # For the first iteration we do not write the parameter
@@ -113,13 +134,12 @@ def _generate_parameter_files(
         # model has completed.
         if node.forward_init and iteration == 0:
             continue
-        export_values = node.write_to_runpath(Path(run_path), iens, fs)
-        if export_values:
-            exports.update(export_values)
-        continue
+        for iens, export_values in node.write_to_runpaths(run_paths, fs).items():
+            exports[iens].update(export_values)
 
-    _value_export_txt(run_path, export_base_name, exports)
-    _value_export_json(run_path, export_base_name, exports)
+    for iens, run_path in run_paths.items():
+        _value_export_txt(run_path, export_base_name, exports[iens])
+        _value_export_json(run_path, export_base_name, exports[iens])
 
 
 def _manifest_to_json(ensemble: Ensemble, iens: int, iter: int) -> dict[str, Any]:
@@ -221,6 +241,113 @@ def sample_prior(
     ensemble.refresh_ensemble_state()
 
 
+@dataclass(frozen=True)
+class _TemplatePlan:
+    """A template read and substituted with everything that is the same for
+    all realizations, so that it is read once for the whole ensemble"""
+
+    target_file: str
+    content: str
+    realization_independent: bool
+
+    def render(self, substitutions: Substitutions, iens: int, iteration: int) -> str:
+        if self.realization_independent:
+            return self.content
+        return substitutions.substitute_real_iter(self.content, iens, iteration)
+
+
+def _plan_templates(
+    templates: list[tuple[str, str]], substitutions: Substitutions
+) -> list[_TemplatePlan]:
+    shared_substitutions = substitutions.without_real_iter()
+    plans = []
+    for source_file, target_file in templates:
+        try:
+            file_content = Path(source_file).read_text("utf-8")
+        except UnicodeDecodeError as e:
+            raise ValueError(
+                f"Unsupported non UTF-8 character found in file: {source_file}"
+            ) from e
+        content = shared_substitutions.substitute(file_content)
+        plans.append(
+            _TemplatePlan(
+                target_file=target_file,
+                content=content,
+                realization_independent=not has_substitution_keys(content),
+            )
+        )
+    return plans
+
+
+def _create_run_paths(
+    run_args: list[RunArg],
+    ensemble: Ensemble,
+    user_config_file: str,
+    env_vars: dict[str, str],
+    env_pr_fm_step: dict[str, dict[str, Any]],
+    forward_model_steps: list[ForwardModelStep],
+    substitutions: Substitutions,
+    template_plans: list[_TemplatePlan],
+    parameters_file: str,
+    compact_jobs_json: bool,
+    on_runpath_ready: Callable[[int], None] | None,
+) -> None:
+    run_paths = {run_arg.iens: Path(run_arg.runpath) for run_arg in run_args}
+    for run_arg in run_args:
+        run_path = run_paths[run_arg.iens]
+        run_path.mkdir(parents=True, exist_ok=True)
+        for plan in template_plans:
+            target_file = substitutions.substitute_real_iter(
+                plan.target_file, run_arg.iens, ensemble.iteration
+            )
+            target = run_path / target_file
+            if not target.parent.exists():
+                os.makedirs(
+                    target.parent,
+                    exist_ok=True,
+                )
+            target.write_text(
+                plan.render(substitutions, run_arg.iens, ensemble.iteration)
+            )
+
+    _generate_parameter_files(
+        ensemble.experiment.parameter_configuration.values(),
+        parameters_file,
+        run_paths,
+        ensemble,
+        ensemble.iteration,
+    )
+
+    jobs_json_option = orjson.OPT_NON_STR_KEYS
+    if not compact_jobs_json:
+        jobs_json_option |= orjson.OPT_INDENT_2
+    for run_arg in run_args:
+        run_path = run_paths[run_arg.iens]
+        path = run_path / "jobs.json"
+        _backup_if_existing(path)
+
+        forward_model_output: dict[str, Any] = create_forward_model_json(
+            context=substitutions,
+            forward_model_steps=forward_model_steps,
+            user_config_file=user_config_file,
+            env_vars=env_vars,
+            env_pr_fm_step=env_pr_fm_step,
+            run_id=run_arg.run_id,
+            iens=run_arg.iens,
+            itr=ensemble.iteration,
+        )
+        with open(path, mode="wb") as fptr:
+            fptr.write(orjson.dumps(forward_model_output, option=jobs_json_option))
+        # Write MANIFEST file to runpath use to avoid NFS sync issues
+        data = _manifest_to_json(ensemble, run_arg.iens, run_arg.itr)
+        with open(run_path / "manifest.json", mode="wb") as fptr:
+            fptr.write(
+                orjson.dumps(data, option=orjson.OPT_NON_STR_KEYS | orjson.OPT_INDENT_2)
+            )
+        if on_runpath_ready is not None:
+            on_runpath_ready(run_arg.iens)
+
+
 @log_duration(logger, logging.INFO)
 def create_run_path(
     run_args: list[RunArg],
@@ -234,75 +361,68 @@ def create_run_path(
     parameters_file: str,
     runpaths: Runpaths,
     context_env: dict[str, str] | None = None,
+    compact_jobs_json: bool = False,
+    max_workers: int | None = None,
+    on_runpath_ready: Callable[[int], None] | None = None,
+    batch_size: int | None = None,
 ) -> None:
+    """Create the runpaths of the active realizations in run_args.
+
+    The templates are read once, and the runpaths are written concurrently
+    by up to max_workers threads (by default as many as
+    concurrent.futures.ThreadPoolExecutor picks), in batches of batch_size
+    realizations for which each parameter is loaded from the ensemble with
+    one call. By default the realizations are spread over the workers in
+    batches of at most RUNPATH_BATCH_SIZE. In the ensemble parameter layout
+    a batch is one read of the parameter store, while in the realization
+    layout every realization is still its own file, and batching only saves
+    the per-realization transformation of the parameters.
+
+    on_runpath_ready is called with the realization number as soon as the
+    runpath of that realization has been written, from the thread that wrote
+    it. If compact_jobs_json is set, jobs.json is written without
+    indentation.
+    """
     if context_env is None:
         context_env = {}
+    if traceparent := get_traceparent():
+        # Lets forward model steps continue the trace of the experiment
+        context_env = {**context_env, "TRACEPARENT": traceparent}
     runpaths.set_ert_ensemble(ensemble.name)
-    for run_arg in run_args:
-        run_path = Path(run_arg.runpath)
-        if run_arg.active:
-            run_path.mkdir(parents=True, exist_ok=True)
-            for source_file, target_file in templates:
-                target_file = substitutions.substitute_real_iter(
-                    target_file, run_arg.iens, ensemble.iteration
-                )
-                try:
-                    file_content = Path(source_file).read_text("utf-8")
-                except UnicodeDecodeError as e:
-                    raise ValueError(
-                        f"Unsupported non UTF-8 character found in file: {source_file}"
-                    ) from e
-
-                result = substitutions.substitute_real_iter(
-                    file_content,
-                    run_arg.iens,
-                    ensemble.iteration,
-                )
-                target = run_path / target_file
-                if not target.parent.exists():
-                    os.makedirs(
-                        target.parent,
-                        exist_ok=True,
-                    )
-                target.write_text(result)
-
-            _generate_parameter_files(
-                ensemble.experiment.parameter_configuration.values(),
-                parameters_file,
-                run_path,
-                run_arg.iens,
+    template_plans = _plan_templates(templates, substitutions)
+
+    active_run_args = [run_arg for run_arg in run_args if run_arg.active]
+    if batch_size is None:
+        batch_size = _runpath_batch_size(len(active_run_args), max_workers)
+    with (
+        tracer.start_as_current_span(f"{__name__}.create_run_path") as span,
+        ThreadPoolExecutor(max_workers=max_workers) as executor,
+    ):
+        span.set_attribute("ert.realization_count", len(active_run_args))
+        futures = [
+            executor.submit(
+                with_current_context(_create_run_paths),
+                active_run_args[start : start + batch_size],
                 ensemble,
-                ensemble.iteration,
-            )
-
-            path = run_path / "jobs.json"
-            _backup_if_existing(path)
-
-            forward_model_output: dict[str, Any] = create_forward_model_json(
-                context=substitutions,
-                forward_model_steps=forward_model_steps,
-                user_config_file=user_config_file,
-                env_vars={**env_vars, **context_env},
-                env_pr_fm_step=env_pr_fm_step,
-                run_id=run_arg.run_id,
-                iens=run_arg.iens,
-                itr=ensemble.iteration,
+                user_config_file,
+                {**env_vars, **context_env},
+                env_pr_fm_step,
+                forward_model_steps,
+                substitutions,
+                template_plans,
+                parameters_file,
+                compact_jobs_json,
+                on_runpath_ready,
             )
-            with open(run_path / "jobs.json", mode="wb") as fptr:
-                fptr.write(
-                    orjson.dumps(
-                        forward_model_output,
-                        option=orjson.OPT_NON_STR_KEYS | orjson.OPT_INDENT_2,
-                    )
-                )
-            # Write MANIFEST file to runpath use to avoid NFS sync issues
-            data = _manifest_to_json(ensemble, run_arg.iens, run_arg.itr)
-            with open(run_path / "manifest.json", mode="wb") as fptr:
-                fptr.write(
-                    orjson.dumps(
-                        data, option=orjson.OPT_NON_STR_KEYS | orjson.OPT_INDENT_2
-                    )
-                )
+            for start in range(0, len(active_run_args), batch_size)
+        ]
+        try:
+            for future in as_completed(futures):
+                future.result()
+        except BaseException:
+            for future in futures:
+                future.cancel()
+            raise
 
     runpaths.write_runpath_list(
         [ensemble.iteration], [real.iens for real in run_args if real.active]
@@ -4,6 +4,7 @@
 import logging
 import traceback
 from collections.abc import Awaitable, Callable, Sequence
+from concurrent.futures import Future
 from dataclasses import dataclass
 from functools import partialmethod
 from typing import Any
@@ -169,6 +170,9 @@ def update_snapshot(self, events: Sequence[Event]) -> EnsembleSnapshot:
             snapshot_mutate_event = snapshot_mutate_event.update_from_event(
                 event, source_snapshot=self.snapshot
             )
+        # Monitors are only sent what changed, e.g. a step reporting memory
+        # usage keeps its status and index from the previous update
+        snapshot_mutate_event = snapshot_mutate_event.changes_from(self.snapshot)
         self.snapshot.merge_snapshot(snapshot_mutate_event)
         if self.snapshot.status is not None and self.status != self.snapshot.status:
             self.status = self._status_tracker.update_state(self.snapshot.status)
@@ -265,9 +269,13 @@ async def _evaluate_inner(
                 max_submit=self._queue_config.max_submit,
                 max_running=self._queue_config.max_running,
                 submit_sleep=self._queue_config.submit_sleep,
+                internalization_workers=self._queue_config.internalization_workers,
                 ens_id=self.id_,
                 ee_uri=self._config.get_uri(),
                 ee_token=self._config.token,
+                telemetry=self._queue_config.forward_model_telemetry,
+                predictive_scheduling=self._queue_config.predictive_scheduling,
+                compact_jobs_json=self._queue_config.compact_jobs_json,
             )
             logger.info(
                 f"Experiment ran on ORCHESTRATOR: scheduler on {self._queue_config.queue_system} queue"
@@ -307,6 +315,12 @@ async def _evaluate_inner(
     def cancellable(self) -> bool:
         return True
 
+    @property
+    def records_resource_usage(self) -> bool:
+        """Whether the scheduler records the resource usage of the forward
+        model steps, which is only done for predictive scheduling"""
+        return self._queue_config.predictive_scheduling
+
     async def cancel(self) -> None:
         if self._scheduler is not None:
             await self._scheduler.kill_all_jobs()
@@ -323,3 +337,6 @@ class Realization:
     num_cpu: int
     job_script: str
     realization_memory: int  # Memory to reserve/book, in bytes
+    runpath_ready: Future[None] | None = None
+    """Set when the runpath is written while the ensemble runs, in which
+    case the realization is submitted once the future is done"""
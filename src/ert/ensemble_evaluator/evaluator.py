@@ -4,14 +4,17 @@
 import logging
 import traceback
 from collections.abc import Awaitable, Callable, Iterable, Sequence
+from dataclasses import dataclass
 from enum import Enum
 from typing import Any, get_args
 
 import zmq.asyncio
+from opentelemetry import metrics
 
 from _ert.events import (
     EESnapshot,
     EESnapshotUpdate,
+    EESubscribe,
     EETerminated,
     EEUserCancel,
     EEUserDone,
@@ -22,6 +25,10 @@
     Event,
     FMEvent,
     ForwardModelStepChecksum,
+    ForwardModelStepFailure,
+    ForwardModelStepRunning,
+    ForwardModelStepStart,
+    ForwardModelStepSuccess,
     RealizationEvent,
     dispatch_event_from_json,
     event_from_json,
@@ -40,6 +47,7 @@
 from ._ensemble import LegacyEnsemble as Ensemble
 from .config import EvaluatorServerConfig
 from .snapshot import EnsembleSnapshot
+from .snapshot_delta import encode_snapshot_update
 from .state import (
     ENSEMBLE_STATE_CANCELLED,
     ENSEMBLE_STATE_FAILED,
@@ -47,6 +55,23 @@
 )
 
 logger = logging.getLogger(__name__)
+meter = metrics.get_meter(__name__)
+
+_event_queue_depth = meter.create_histogram(
+    "ert.evaluator.event_queue_depth",
+    unit="{event}",
+    description="Events left in the queue when a batch is flushed",
+)
+_batch_flush_latency = meter.create_histogram(
+    "ert.evaluator.batch_flush_latency",
+    unit="s",
+    description="Time from the first event of a batch arriving until it is flushed",
+)
+_handler_time = meter.create_histogram(
+    "ert.evaluator.handler_time",
+    unit="s",
+    description="Time spent handling the events of one batch",
+)
 
 EVENT_HANDLER = Callable[[list[Event]], Awaitable[None]]
 
@@ -55,13 +80,45 @@ class HeartbeatEvent(Enum):
     event = HEARTBEAT_MSG
 
 
+@dataclass
+class _SnapshotUpdate:
+    """A snapshot update waiting to be published, it is only serialized as
+    an EESnapshotUpdate event for the clients that have not subscribed"""
+
+    snapshot: EnsembleSnapshot
+
+
+@dataclass
+class _Subscription:
+    """Snapshot updates for a client that subscribed with EESubscribe, which
+    are merged until update_interval has passed since the last one was sent"""
+
+    update_interval: float
+    pending: EnsembleSnapshot | None = None
+    last_sent: float = float("-inf")
+
+    def add(self, snapshot: EnsembleSnapshot) -> None:
+        if self.pending is None:
+            self.pending = EnsembleSnapshot()
+        self.pending.merge_snapshot(snapshot)
+
+    def due(self, now: float) -> float | None:
+        """Seconds until the pending update should be sent, None if there is
+        nothing to send"""
+        if self.pending is None:
+            return None
+        return max(0.0, self.last_sent + self.update_interval - now)
+
+
 class EnsembleEvaluator:
     def __init__(self, ensemble: Ensemble, config: EvaluatorServerConfig):
         self._config: EvaluatorServerConfig = config
         self._ensemble: Ensemble = ensemble
 
         self._events: asyncio.Queue[Event] = asyncio.Queue()
-        self._events_to_send: asyncio.Queue[Event | HeartbeatEvent] = asyncio.Queue()
+        self._events_to_send: asyncio.Queue[
+            Event | _SnapshotUpdate | HeartbeatEvent
+        ] = asyncio.Queue()
         self._manifest_queue: asyncio.Queue[Any] = asyncio.Queue()
 
         self._ee_tasks: list[asyncio.Task[None]] = []
@@ -76,6 +133,7 @@ def __init__(self, ensemble: Ensemble, config: EvaluatorServerConfig):
         self._complete_batch: asyncio.Event = asyncio.Event()
         self._server_started: asyncio.Future[None] = asyncio.Future()
         self._clients_connected: set[bytes] = set()
+        self._subscriptions: dict[bytes, _Subscription] = {}
         self._clients_empty: asyncio.Event = asyncio.Event()
         self._clients_empty.set()
         self._dispatchers_connected: set[bytes] = set()
@@ -91,26 +149,72 @@ async def _do_heartbeat_clients(self) -> None:
                 await asyncio.sleep(0.1)
 
     async def _publisher(self) -> None:
+        loop = asyncio.get_running_loop()
         while True:
-            event = await self._events_to_send.get()
-            for identity in self._clients_connected:
+            try:
+                event = await asyncio.wait_for(
+                    self._events_to_send.get(),
+                    timeout=self._next_subscription_update(loop.time()),
+                )
+            except TimeoutError:
+                await self._send_subscription_updates()
+                continue
+            json_frame: bytes | None = None
+            for identity in list(self._clients_connected):
+                subscription = self._subscriptions.get(identity)
                 if isinstance(event, HeartbeatEvent):
-                    await self._router_socket.send_multipart(
-                        [identity, b"", event.value]
-                    )
+                    frame = event.value
+                elif subscription is not None and isinstance(event, _SnapshotUpdate):
+                    subscription.add(event.snapshot)
+                    continue
                 else:
-                    await self._router_socket.send_multipart(
-                        [identity, b"", event_to_json(event).encode("utf-8")]
-                    )
+                    if subscription is not None:
+                        # Updates are sent before later events, e.g. terminated
+                        await self._send_subscription_update(identity, subscription)
+                    if json_frame is None:
+                        json_frame = self._to_json_frame(event)
+                    frame = json_frame
+                await self._router_socket.send_multipart([identity, b"", frame])
+            await self._send_subscription_updates()
             self._events_to_send.task_done()
 
+    def _to_json_frame(self, event: Event | _SnapshotUpdate) -> bytes:
+        if isinstance(event, _SnapshotUpdate):
+            event = EESnapshotUpdate(
+                snapshot=event.snapshot.to_dict(), ensemble=self._ensemble.id_
+            )
+        return event_to_json(event).encode("utf-8")
+
+    def _next_subscription_update(self, now: float) -> float | None:
+        due = [
+            seconds
+            for subscription in self._subscriptions.values()
+            if (seconds := subscription.due(now)) is not None
+        ]
+        return min(due, default=None)
+
+    async def _send_subscription_updates(self) -> None:
+        now = asyncio.get_running_loop().time()
+        for identity, subscription in list(self._subscriptions.items()):
+            if subscription.due(now) == 0.0:
+                await self._send_subscription_update(identity, subscription)
+
+    async def _send_subscription_update(
+        self, identity: bytes, subscription: _Subscription
+    ) -> None:
+        if subscription.pending is None:
+            return
+        frame = encode_snapshot_update(subscription.pending, self._ensemble.id_)
+        subscription.pending = None
+        subscription.last_sent = asyncio.get_running_loop().time()
+        if identity in self._clients_connected:
+            await self._router_socket.send_multipart([identity, b"", frame])
+
     async def _append_message(self, snapshot_update_event: EnsembleSnapshot) -> None:
-        event = EESnapshotUpdate(
-            snapshot=snapshot_update_event.to_dict(), ensemble=self._ensemble.id_
-        )
-        await self._events_to_send.put(event)
+        await self._events_to_send.put(_SnapshotUpdate(snapshot_update_event))
 
     async def _process_event_buffer(self) -> None:
+        loop = asyncio.get_running_loop()
         while True:
             batch = await self._batch_processing_queue.get()
             function_to_events_map: dict[EVENT_HANDLER, list[Event]] = {}
@@ -120,11 +224,20 @@ async def _process_event_buffer(self) -> None:
                 function_to_events_map[func].append(event)
 
             for func, events in function_to_events_map.items():
+                start_time = loop.time()
                 await func(events)
+                _handler_time.record(
+                    loop.time() - start_time, {"handler": func.__name__}
+                )
 
             self._batch_processing_queue.task_done()
 
     async def _batch_events_into_buffer(self) -> None:
+        """Collect events into batches for _process_event_buffer.
+
+        A batch is started by the first event to arrive, and flushed once it
+        has _max_batch_size events or _batching_interval seconds have passed
+        since its first event, whichever comes first."""
         event_handler: dict[type[Event], EVENT_HANDLER] = {}
 
         def set_event_handler(event_types: set[type[Event]], func: Any) -> None:
@@ -137,30 +250,38 @@ def set_event_handler(event_types: set[type[Event]], func: Any) -> None:
         set_event_handler({EnsembleCancelled}, self._cancelled_handler)
         set_event_handler({EnsembleFailed}, self._failed_handler)
 
+        loop = asyncio.get_running_loop()
         while True:
+            self._complete_batch.set()
+            event = await self._events.get()
+            self._complete_batch.clear()
+            first_event_time = loop.time()
+            deadline = first_event_time + self._batching_interval
             batch: list[tuple[EVENT_HANDLER, Event]] = []
-            start_time = asyncio.get_running_loop().time()
-            while (
-                len(batch) < self._max_batch_size
-                and asyncio.get_running_loop().time() - start_time
-                < self._batching_interval
-            ):
-                self._complete_batch.clear()
+            while True:
+                batch.append((event_handler[type(event)], event))
+                self._events.task_done()
+                if len(batch) >= self._max_batch_size:
+                    break
                 try:
                     event = self._events.get_nowait()
-                    function = event_handler[type(event)]
-                    batch.append((function, event))
-                    self._events.task_done()
                 except asyncio.QueueEmpty:
-                    await asyncio.sleep(0.1)
-                    continue
-            self._complete_batch.set()
+                    try:
+                        event = await asyncio.wait_for(
+                            self._events.get(), timeout=deadline - loop.time()
+                        )
+                    except TimeoutError:
+                        break
             await self._batch_processing_queue.put(batch)
+            _batch_flush_latency.record(loop.time() - first_event_time)
+            _event_queue_depth.record(self._events.qsize())
             if self._events.qsize() > 2 * self._max_batch_size:
                 logger.info(f"{self._events.qsize()} events left in queue")
 
     async def _fm_handler(self, events: Sequence[FMEvent | RealizationEvent]) -> None:
-        await self._append_message(self.ensemble.update_snapshot(events))
+        await self._append_message(
+            self.ensemble.update_snapshot(coalesce_fm_step_running(events))
+        )
 
     async def _started_handler(self, events: Sequence[EnsembleStarted]) -> None:
         if self.ensemble.status != ENSEMBLE_STATE_FAILED:
@@ -217,6 +338,9 @@ async def handle_client(self, dealer: bytes, frame: bytes) -> None:
                 logger.warning(f"{dealer!r} wants to reconnect.")
             self._clients_connected.add(dealer)
             self._clients_empty.clear()
+            if subscription := self._subscriptions.get(dealer):
+                # The snapshot sent below includes any pending update
+                subscription.pending = None
             current_snapshot_dict = self._ensemble.snapshot.to_dict()
             event: Event = EESnapshot(
                 snapshot=current_snapshot_dict,
@@ -227,11 +351,18 @@ async def handle_client(self, dealer: bytes, frame: bytes) -> None:
             )
         elif frame == DISCONNECT_MSG:
             self._clients_connected.discard(dealer)
+            self._subscriptions.pop(dealer, None)
             if not self._clients_connected:
                 self._clients_empty.set()
         else:
             event = event_from_json(frame.decode("utf-8"))
-            if type(event) is EEUserCancel:
+            if type(event) is EESubscribe:
+                logger.debug(
+                    f"Client subscribed to snapshot updates every "
+                    f"{event.update_interval} seconds."
+                )
+                self._subscriptions[dealer] = _Subscription(event.update_interval)
+            elif type(event) is EEUserCancel:
                 logger.debug("Client asked to cancel.")
                 await self._signal_cancel()
             elif type(event) is EEUserDone:
@@ -259,6 +390,16 @@ async def handle_dispatch(self, dealer: bytes, frame: bytes) -> None:
                 await self.forward_checksum(event)
             else:
                 await self._events.put(event)
+                if type(event) in {ForwardModelStepSuccess, ForwardModelStepFailure}:
+                    # The scheduler uses these to learn that jobs are exiting
+                    # without waiting for the queue system to be polled, and
+                    # to record the resource usage of the steps
+                    await self._manifest_queue.put(event)
+                elif (
+                    type(event) in {ForwardModelStepStart, ForwardModelStepRunning}
+                    and self._ensemble.records_resource_usage
+                ):
+                    await self._manifest_queue.put(event)
 
     async def listen_for_messages(self) -> None:
         while True:
@@ -461,6 +602,24 @@ def _get_ens_id(source: str) -> str:
         return source.split("/")[3]
 
 
+def coalesce_fm_step_running(
+    events: Sequence[FMEvent | RealizationEvent],
+) -> list[FMEvent | RealizationEvent]:
+    """Drop the running events, i.e. the periodic memory and cpu reports, that
+    are followed by another running event for the same step in the batch, as
+    the later one sets all the fields of the earlier one."""
+    last_running: dict[tuple[str, str], int] = {}
+    for i, event in enumerate(events):
+        if type(event) is ForwardModelStepRunning:
+            last_running[event.real, event.fm_step] = i
+    return [
+        event
+        for i, event in enumerate(events)
+        if type(event) is not ForwardModelStepRunning
+        or last_running[event.real, event.fm_step] == i
+    ]
+
+
 def detect_overspent_cpu(num_cpu: int, real_id: str, fm_step: FMStepSnapshot) -> str:
     """Produces a message warning about misconfiguration of NUM_CPU if
     so is detected. Returns an empty string if everything is ok."""
@@ -7,6 +7,7 @@
 from typing import Final
 
 from _ert.events import (
+    EESubscribe,
     EETerminated,
     EEUserCancel,
     EEUserDone,
@@ -16,6 +17,8 @@
 )
 from _ert.forward_model_runner.client import Client
 
+from .snapshot_delta import SNAPSHOT_DELTA_PREFIX, decode_snapshot_update
+
 logger = logging.getLogger(__name__)
 
 
@@ -26,14 +29,35 @@ class EventSentinel:
 class Monitor(Client):
     _sentinel: Final = EventSentinel()
 
-    def __init__(self, uri: str, token: str | None = None) -> None:
+    def __init__(
+        self,
+        uri: str,
+        token: str | None = None,
+        snapshot_update_interval: float | None = None,
+    ) -> None:
+        """If snapshot_update_interval is given, the monitor subscribes to
+        receive snapshot updates as compact deltas at most once per interval,
+        otherwise every update is sent as a JSON event."""
         self._id = str(uuid.uuid1()).split("-", maxsplit=1)[0]
         self._event_queue: asyncio.Queue[Event | EventSentinel] = asyncio.Queue()
         self._receiver_timeout: float = 60.0
+        self._snapshot_update_interval = snapshot_update_interval
         super().__init__(uri, token, dealer_name=f"client-{self._id}")
 
-    async def process_message(self, msg: str) -> None:
-        event = event_from_json(msg)
+    async def connect(self) -> None:
+        await super().connect()
+        if self._snapshot_update_interval is not None:
+            subscribe_event = EESubscribe(
+                monitor=self._id, update_interval=self._snapshot_update_interval
+            )
+            await self.send(event_to_json(subscribe_event))
+
+    async def process_message(self, msg: bytes) -> None:
+        event: Event
+        if msg.startswith(SNAPSHOT_DELTA_PREFIX):
+            event = decode_snapshot_update(msg)
+        else:
+            event = event_from_json(msg)
         await self._event_queue.put(event)
 
     async def signal_cancel(self) -> None:
@@ -154,6 +154,26 @@ def merge_snapshot(self, ensemble: EnsembleSnapshot) -> EnsembleSnapshot:
             self._fm_step_snapshots[fm_step_id].update(other_fm_data)
         return self
 
+    def changes_from(self, current: EnsembleSnapshot) -> EnsembleSnapshot:
+        """The part of this update that changes current when merged into it,
+        i.e. without the fields that already have the same value in current."""
+        changes = EnsembleSnapshot()
+        changes._metadata = self._metadata
+        if (
+            self._ensemble_state is not None
+            and self._ensemble_state != current._ensemble_state
+        ):
+            changes._ensemble_state = self._ensemble_state
+        for real_id, real_data in self._realization_snapshots.items():
+            current_real = current._realization_snapshots.get(real_id, {})
+            if changed_real := _changed_fields(real_data, current_real):
+                changes._realization_snapshots[real_id] = changed_real
+        for fm_idx, fm_data in self._fm_step_snapshots.items():
+            current_fm = current._fm_step_snapshots.get(fm_idx, {})
+            if changed_fm := _changed_fields(fm_data, current_fm):
+                changes._fm_step_snapshots[fm_idx] = changed_fm
+        return changes
+
     def merge_metadata(self, metadata: EnsembleSnapshotMetadata) -> None:
         self._metadata.update(metadata)
 
@@ -466,3 +486,14 @@ def _realization_dict_to_realization_snapshot(
 
 def _filter_nones(input: T) -> T:
     return cast(T, {k: v for k, v in input.items() if v is not None})
+
+
+def _changed_fields(update: T, current: Mapping[str, Any]) -> T:
+    return cast(
+        T,
+        {
+            k: v
+            for k, v in update.items()
+            if k not in current or current[k] != v  # type: ignore
+        },
+    )
@@ -1,9 +1,11 @@
 from __future__ import annotations
 
 import os
+import re
+import warnings
 from collections.abc import Iterator
 from contextlib import contextmanager
-from typing import Any, TextIO
+from typing import Any, BinaryIO, TextIO
 
 import numpy as np
 import numpy.typing as npt
@@ -151,21 +153,114 @@ def read_grdecl(grdecl_stream: TextIO) -> Iterator[tuple[str, list[str]]]:
         yield read_grdecl(stream)
 
 
+# Number of bytes of a grdecl record parsed at a time by import_grdecl
+GRDECL_CHUNK_SIZE = 1 << 24
+
+_COMMENT = re.compile(rb"(?<!\S)--[^\n]*")
+_TERMINATOR = re.compile(rb"(?<!\S)/(?!\S)")
+_REPEAT = re.compile(rb"(?<!\S)(\d+)\*(\S*)")
+
+
+class _GrdeclValues:
+    """Preallocated buffer that the values of a grdecl record are parsed into"""
+
+    def __init__(self, size: int, dtype: npt.DTypeLike, name: str) -> None:
+        self.values = np.empty(size, dtype=dtype)
+        # Number of values read, which may exceed the size of the buffer
+        self.size = 0
+        self._name = name
+
+    def _store(self, values: npt.NDArray[Any] | float, count: int) -> None:
+        # Values beyond the expected size are only counted, so that the size
+        # can be reported once the whole record has been read
+        available = max(min(count, len(self.values) - self.size), 0)
+        if isinstance(values, np.ndarray):
+            values = values[:available]
+        self.values[self.size : self.size + available] = values
+        self.size += count
+
+    def parse(self, text: bytes) -> None:
+        """Parses whitespace separated numbers, including N*value repeats"""
+        if b"*" not in text:
+            self._parse_numbers(text)
+            return
+        position = 0
+        for repeat in _REPEAT.finditer(text):
+            self._parse_numbers(text[position : repeat.start()])
+            try:
+                value = float(repeat[2])
+            except ValueError as err:
+                raise ValueError(
+                    f"Could not read {repeat[0].decode(errors='replace')!r} "
+                    f"in {self._name}"
+                ) from err
+            self._store(value, int(repeat[1]))
+            position = repeat.end()
+        self._parse_numbers(text[position:])
+
+    def _parse_numbers(self, text: bytes) -> None:
+        text = text.strip()
+        if not text:
+            return
+        with warnings.catch_warnings():
+            # numpy warns and stops parsing at the first token that is not a number
+            warnings.simplefilter("error", DeprecationWarning)
+            try:
+                numbers = np.fromstring(text, dtype=self.values.dtype, sep=" ")
+            except (DeprecationWarning, ValueError) as err:
+                raise ValueError(f"Could not read values of {self._name}") from err
+        self._store(numbers, len(numbers))
+
+
+def _read_grdecl_record(
+    stream: BinaryIO, values: _GrdeclValues, chunk_size: int
+) -> bool:
+    """Parses the values following the keyword line until the terminating
+    slash in chunks of about chunk_size bytes, split at line ends so that
+    tokens and comments are never split. Returns whether the record was
+    terminated."""
+    remainder = b""
+    while True:
+        chunk = stream.read(chunk_size)
+        at_end = not chunk
+        text = remainder + chunk
+        if not at_end:
+            line_end = text.rfind(b"\n")
+            if line_end == -1:
+                remainder = text
+                continue
+            text, remainder = text[: line_end + 1], text[line_end + 1 :]
+        if b"--" in text:
+            text = _COMMENT.sub(b" ", text)
+        if b"/" in text and (terminator := _TERMINATOR.search(text)):
+            values.parse(text[: terminator.start()])
+            return True
+        values.parse(text)
+        if at_end:
+            return False
+
+
 def import_grdecl(
     filename: str | os.PathLike[str],
     name: str,
     dimensions: tuple[int, int, int],
     dtype: npt.DTypeLike = np.float32,
+    chunk_size: int = GRDECL_CHUNK_SIZE,
 ) -> npt.NDArray[np.float32]:
     """
     Read a field from a grdecl file, see open_grdecl for description
     of format.
 
+    The values are parsed in chunks straight into the resulting array,
+    without tokenizing the file in python, so memory use is bounded by the
+    size of the field.
+
     Args:
         filename (pathlib.Path or str): File in grdecl format.
         name (str): The name of the field to get from the file
         dimensions ((int,int,int)): Triple of the size of grid.
         dtype (data-type, optional): The datatype to be read, ie., float.
+        chunk_size (int, optional): Number of bytes parsed at a time.
 
     Raises:
         ValueError: If the file is not a valid file or does not contain
@@ -175,19 +270,26 @@ def import_grdecl(
         numpy array with given dimensions and data type read
         from the grdecl file.
     """
-    result = None
-
-    with open_grdecl(filename, keywords=[name]) as kw_generator:
-        try:
-            _, result = next(kw_generator)
-        except StopIteration as si:
-            raise ValueError(
-                f"Did not find field parameter {name} in {filename}"
-            ) from si
-
+    keyword = _until_space(name).encode("utf-8")
+    size = int(np.prod(dimensions))
+    values = _GrdeclValues(size, dtype, name.strip())
+    with open(filename, "rb") as stream:
+        for line in stream:
+            first_word = line.split(maxsplit=1)[0] if line[:1].strip() else b""
+            if first_word[:8] == keyword:
+                break
+        else:
+            raise ValueError(f"Did not find field parameter {name} in {filename}")
+        if not _read_grdecl_record(stream, values, chunk_size):
+            raise ValueError(f"Reached end of stream while reading {name.strip()}")
+
+    if values.size != size:
+        raise ValueError(
+            f"{name.strip()} in {filename} has {values.size} values, "
+            f"expected {size} for dimensions {dimensions}"
+        )
     # The values are stored in F order in the grdecl file
-    f_order_values = np.asarray(result, dtype=dtype)
-    return np.ascontiguousarray(f_order_values.reshape(dimensions, order="F"))
+    return np.ascontiguousarray(values.values.reshape(dimensions, order="F"))
 
 
 def import_bgrdecl(
@@ -218,6 +320,10 @@ def import_bgrdecl(
     raise ValueError(f"Did not find field parameter {field_name} in {file_path}")
 
 
+_VALUES_PER_LINE = 6
+_LINES_PER_BLOCK = 10000
+
+
 def export_grdecl(
     values: np.ma.MaskedArray[Any, np.dtype[np.float32]] | npt.NDArray[np.float32],
     file_path: str | os.PathLike[str],
@@ -232,12 +338,15 @@ def export_grdecl(
     if binary:
         resfo.write(file_path, [(param_name.ljust(8), values.astype(np.float32))])
     else:
+        # Formats a block of lines with one string formatting operation, rather
+        # than one per value
+        line_format = " %3e" * _VALUES_PER_LINE + "\n"
+        full_lines = len(values) // _VALUES_PER_LINE * _VALUES_PER_LINE
+        block_size = _LINES_PER_BLOCK * _VALUES_PER_LINE
         with open(file_path, "w", encoding="utf-8") as fh:
             fh.write(param_name + "\n")
-            for i, v in enumerate(values):
-                fh.write(" ")
-                fh.write(f"{v:3e}")
-                if i % 6 == 5:
-                    fh.write("\n")
-
+            for start in range(0, full_lines, block_size):
+                block = values[start : min(start + block_size, full_lines)].tolist()
+                fh.write(line_format * (len(block) // _VALUES_PER_LINE) % tuple(block))
+            fh.write("".join(f" {v:3e}" for v in values[full_lines:].tolist()))
             fh.write(" /\n")
@@ -19,7 +19,7 @@ def _repr(node: RootNode | IterNode | RealNode | ForwardModelStepNode) -> str:
 
 
 def _row(node: RootNode | IterNode | RealNode | ForwardModelStepNode) -> int:
-    if not node._index:
+    if node._index is None:
         if node.parent:
             node._index = list(node.parent.children.keys()).index(node.id_)
         else:
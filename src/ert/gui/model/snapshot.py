@@ -84,6 +84,19 @@ def _estimate_duration(
     return end_time - start_time
 
 
+def _row_ranges(rows: list[int]) -> list[tuple[int, int]]:
+    """The rows as ranges of consecutive rows, so that one dataChanged signal
+    is emitted for each range of changed rows rather than for every row
+    between the first and last changed row"""
+    ranges: list[tuple[int, int]] = []
+    for row in sorted(set(rows)):
+        if ranges and ranges[-1][1] == row - 1:
+            ranges[-1] = (ranges[-1][0], row)
+        else:
+            ranges.append((row, row))
+    return ranges
+
+
 class SnapshotModel(QAbstractItemModel):
     def __init__(self, parent: QObject | None = None) -> None:
         super().__init__(parent)
@@ -119,6 +132,13 @@ def prerender(ensemble: EnsembleSnapshot) -> EnsembleSnapshot | None:
             metadata["sorted_fm_step_ids"][real_id].append(fm_step_id)
             metadata["fm_step_status"][real_id][fm_step_id] = fm_step_status
 
+        # Timestamps are parsed here rather than when the model is updated
+        for fm_step in ensemble.get_all_fm_steps().values():
+            if start_time := fm_step.get("start_time"):
+                fm_step["start_time"] = convert_iso8601_to_datetime(start_time)
+            if end_time := fm_step.get("end_time"):
+                fm_step["end_time"] = convert_iso8601_to_datetime(end_time)
+
         ensemble.merge_metadata(metadata)
         return ensemble
 
@@ -149,6 +169,13 @@ def _update_snapshot(self, snapshot: EnsembleSnapshot, iter_: str) -> None:
             for real_id, real in reals.items():
                 real_node = iter_node.children[real_id]
                 data = real_node.data
+                before = (
+                    data.status,
+                    data.exec_hosts,
+                    data.real_status,
+                    data.message,
+                    dict(data.fm_step_status_by_id),
+                )
                 if real_status := real.get("status"):
                     data.status = real_status
                 if real_exec_hosts := real.get("exec_hosts"):
@@ -159,23 +186,34 @@ def _update_snapshot(self, snapshot: EnsembleSnapshot, iter_: str) -> None:
                     data.fm_step_status_by_id[real_fm_step_id] = status
                 if real_id in metadata["real_status"]:
                     data.real_status = metadata["real_status"][real_id]
-                reals_changed.append(real_node.row())
                 if msg := real.get("message"):
                     data.message = msg
+                if before != (
+                    data.status,
+                    data.exec_hosts,
+                    data.real_status,
+                    data.message,
+                    data.fm_step_status_by_id,
+                ):
+                    reals_changed.append(real_node.row())
 
             fm_steps_changed_by_real: dict[str, list[int]] = defaultdict(list)
             for (real_id, fm_step_id), fm_step in fm_steps.items():
                 real_node = iter_node.children[real_id]
                 fm_step_node = real_node.children[fm_step_id]
 
-                fm_steps_changed_by_real[real_id].append(fm_step_node.row())
                 if start_time := fm_step.get("start_time", None):
                     fm_step["start_time"] = convert_iso8601_to_datetime(start_time)
                 if end_time := fm_step.get("end_time", None):
                     fm_step["end_time"] = convert_iso8601_to_datetime(end_time)
                 # Errors may be unset as the queue restarts the job
                 fm_step[ids.ERROR] = fm_step.get(ids.ERROR, "")
-                fm_step_node.data.update(fm_step)
+                if any(
+                    fm_step_node.data.get(key) != value
+                    for key, value in fm_step.items()
+                ):
+                    fm_steps_changed_by_real[real_id].append(fm_step_node.row())
+                    fm_step_node.data.update(fm_step)
                 if cur_mem_usage := fm_step.get("current_memory_usage", None):
                     real_node.data.current_memory_usage = int(float(cur_mem_usage))
                 if maximum_mem_usage := fm_step.get("max_memory_usage", None):
@@ -190,23 +228,21 @@ def _update_snapshot(self, snapshot: EnsembleSnapshot, iter_: str) -> None:
             for real_idx, changed_fm_steps in fm_steps_changed_by_real.items():
                 real_node = iter_node.children[real_idx]
                 real_index = self.index(real_node.row(), 0, iter_index)
+                last_column = self.columnCount(real_index) - 1
+                for first, last in _row_ranges(changed_fm_steps):
+                    stack.callback(
+                        self.dataChanged.emit,
+                        self.index(first, 0, real_index),
+                        self.index(last, last_column, real_index),
+                    )
 
-                fm_step_top_left = self.index(min(changed_fm_steps), 0, real_index)
-                fm_step_bottom_right = self.index(
-                    max(changed_fm_steps),
-                    self.columnCount(real_index) - 1,
-                    real_index,
-                )
+            last_column = self.columnCount(iter_index) - 1
+            for first, last in _row_ranges(reals_changed):
                 stack.callback(
-                    self.dataChanged.emit, fm_step_top_left, fm_step_bottom_right
-                )
-
-            if reals_changed:
-                real_top_left = self.index(min(reals_changed), 0, iter_index)
-                real_bottom_right = self.index(
-                    max(reals_changed), self.columnCount(iter_index) - 1, iter_index
+                    self.dataChanged.emit,
+                    self.index(first, 0, iter_index),
+                    self.index(last, last_column, iter_index),
                 )
-                stack.callback(self.dataChanged.emit, real_top_left, real_bottom_right)
 
             return
 
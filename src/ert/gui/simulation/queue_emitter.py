@@ -3,7 +3,8 @@
 import logging
 from contextlib import suppress
 from queue import Empty, SimpleQueue
-from time import sleep
+from time import monotonic, sleep
+from typing import Final
 
 from PyQt6.QtCore import QObject
 from PyQt6.QtCore import pyqtSignal as Signal
@@ -15,6 +16,23 @@
 
 logger = logging.getLogger(__name__)
 
+SNAPSHOT_UPDATE_INTERVAL: Final = 1 / 30
+"""Seconds between the snapshot updates emitted to the GUI, updates that
+arrive in between are merged into one, so that the GUI thread only redraws
+the run dialog at about the rate it can be displayed"""
+
+
+def merge_snapshot_updates(
+    pending: SnapshotUpdateEvent, event: SnapshotUpdateEvent
+) -> SnapshotUpdateEvent:
+    """The event as if it was sent after pending, carrying the snapshot
+    changes of both"""
+    assert pending.snapshot is not None
+    assert event.snapshot is not None
+    return event.model_copy(
+        update={"snapshot": pending.snapshot.merge_snapshot(event.snapshot)}
+    )
+
 
 class QueueEmitter(QObject):
     """A worker that emits items put on a queue to qt subscribers."""
@@ -35,25 +53,43 @@ def __init__(
     @Slot()
     def consume_and_emit(self) -> None:
         logger.debug("tracking...")
+        pending: SnapshotUpdateEvent | None = None
+        last_emitted = 0.0
         while True:
             event = None
+            timeout = (
+                max(last_emitted + SNAPSHOT_UPDATE_INTERVAL - monotonic(), 0.0)
+                if pending is not None
+                else 1.0
+            )
             with suppress(Empty):
-                event = self._event_queue.get(timeout=1.0)
+                event = self._event_queue.get(timeout=timeout)
             if self._stopped:
                 logger.debug("stopped")
                 break
-            if event is None:
+            if event is None and pending is None:
                 sleep(0.1)
                 continue
 
-            # pre-rendering in this thread to avoid work in main rendering thread
-            if (
-                isinstance(event, FullSnapshotEvent | SnapshotUpdateEvent)
-                and event.snapshot
-            ):
-                SnapshotModel.prerender(event.snapshot)
+            if isinstance(event, SnapshotUpdateEvent) and event.snapshot:
+                if pending is not None and pending.iteration == event.iteration:
+                    pending = merge_snapshot_updates(pending, event)
+                else:
+                    if pending is not None:
+                        self._emit(pending)
+                    pending = event
+                if monotonic() - last_emitted < SNAPSHOT_UPDATE_INTERVAL:
+                    continue
+                event = None
 
-            self.new_event.emit(event)
+            if pending is not None:
+                self._emit(pending)
+                pending = None
+                last_emitted = monotonic()
+            if event is None:
+                continue
+
+            self._emit(event)
 
             if isinstance(event, EndEvent):
                 logger.debug("got end event")
@@ -62,6 +98,13 @@ def consume_and_emit(self) -> None:
         self.done.emit()
         logger.debug("tracking done.")
 
+    def _emit(self, event: StatusEvents) -> None:
+        # pre-rendering in this thread to avoid work in main rendering thread
+        if isinstance(event, FullSnapshotEvent | SnapshotUpdateEvent) and event.snapshot:
+            SnapshotModel.prerender(event.snapshot)
+
+        self.new_event.emit(event)
+
     @Slot()
     def stop(self) -> None:
         logger.debug("stopping...")
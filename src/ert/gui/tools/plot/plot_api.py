@@ -12,6 +12,7 @@
 import numpy as np
 import numpy.typing as npt
 import pandas as pd
+import polars as pl
 from pandas.errors import ParserError
 
 from ert.services import StorageService
@@ -173,13 +174,15 @@ def data_for_key(self, ensemble_id: str, key: str) -> pd.DataFrame:
         with StorageService.session(project=self.ens_path) as client:
             response = client.get(
                 f"/ensembles/{ensemble.id}/records/{PlotApi.escape(key)}",
-                headers={"accept": "application/x-parquet"},
+                headers={"accept": "application/vnd.apache.arrow.stream"},
                 timeout=self._timeout,
             )
             self._check_response(response)
 
-            stream = io.BytesIO(response.content)
-            df = pd.read_parquet(stream)
+            records = pl.read_ipc_stream(io.BytesIO(response.content))
+            if "Realization" not in records.columns:
+                return pd.DataFrame()
+            df = records.to_pandas().set_index("Realization")
 
             try:
                 df.columns = pd.to_datetime(df.columns, format="%Y-%m-%d %H:%M:%S")
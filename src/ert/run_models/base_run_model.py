@@ -219,6 +219,12 @@ def __init__(
             eclbase=self._model_config.eclbase_format_string,
         )
         self._iter_snapshot: dict[int, EnsembleSnapshot] = {}
+        # Seconds between the snapshot updates the monitor is sent, updates
+        # in between are merged by the evaluator
+        self._snapshot_update_interval: float = 0.5
+        # Futures the realizations wait on before they are submitted, while
+        # their runpaths are written, see SUBMIT_WHEN_RUNPATH_READY
+        self._runpath_ready: dict[int, concurrent.futures.Future[None]] = {}
         self._status_queue = status_queue
         self._end_queue: SimpleQueue[str] = SimpleQueue()
         # This holds state about the run model
@@ -563,7 +569,11 @@ async def run_monitor(
     ) -> bool:
         try:
             logger.debug("connecting to new monitor...")
-            async with Monitor(ee_config.get_uri(), ee_config.token) as monitor:
+            async with Monitor(
+                ee_config.get_uri(),
+                ee_config.token,
+                snapshot_update_interval=self._snapshot_update_interval,
+            ) as monitor:
                 logger.debug("connected")
                 async for event in monitor.track(heartbeat_interval=0.1):
                     if type(event) in {
@@ -684,6 +694,7 @@ def _build_ensemble(
                     num_cpu=self._queue_config.preferred_num_cpu,
                     job_script=self._queue_config.job_script,
                     realization_memory=self._queue_config.realization_memory,
+                    runpath_ready=self._runpath_ready.get(run_arg.iens),
                 )
             )
         return EEEnsemble(
@@ -751,12 +762,12 @@ def run_workflows(
         for workflow in self._hooked_workflows[runtime]:
             WorkflowRunner(workflow=workflow, fixtures=fixtures).run_blocking()
 
-    def _evaluate_and_postprocess(
+    def _create_run_path(
         self,
         run_args: list[RunArg],
         ensemble: Ensemble,
-        evaluator_server_config: EvaluatorServerConfig,
-    ) -> int:
+        on_runpath_ready: Callable[[int], None] | None = None,
+    ) -> None:
         create_run_path(
             run_args=run_args,
             ensemble=ensemble,
@@ -769,26 +780,98 @@ def _evaluate_and_postprocess(
             parameters_file=self._model_config.gen_kw_export_name,
             runpaths=self.run_paths,
             context_env=self._context_env,
+            compact_jobs_json=self._queue_config.compact_jobs_json,
+            on_runpath_ready=on_runpath_ready,
         )
 
-        self.run_workflows(
-            HookRuntime.PRE_SIMULATION,
-            fixtures={
-                "storage": self._storage,
-                "ensemble": ensemble,
-                "reports_dir": self.reports_dir(
-                    experiment_name=ensemble.experiment.name
-                ),
-                "random_seed": self.random_seed,
-                "run_paths": self.run_paths,
-            },
-        )
-        try:
-            successful_realizations = self.run_ensemble_evaluator(
-                run_args,
-                ensemble,
-                evaluator_server_config,
+    def _create_run_path_and_run_ensemble_evaluator(
+        self,
+        run_args: list[RunArg],
+        ensemble: Ensemble,
+        evaluator_server_config: EvaluatorServerConfig,
+    ) -> list[int]:
+        """Run the ensemble while the runpaths are created, submitting each
+        realization as soon as its runpath has been written"""
+        waiting: dict[int, concurrent.futures.Future[None]] = {
+            run_arg.iens: concurrent.futures.Future()
+            for run_arg in run_args
+            if run_arg.active
+        }
+        self._runpath_ready = waiting
+
+        def runpath_ready(iens: int) -> None:
+            waiting[iens].set_result(None)
+
+        def fail_waiting_realizations(
+            future: concurrent.futures.Future[None],
+        ) -> None:
+            if (error := future.exception()) is None:
+                return
+            for ready in waiting.values():
+                if not ready.done():
+                    ready.set_exception(error)
+
+        with concurrent.futures.ThreadPoolExecutor(max_workers=1) as executor:
+            runpaths_created = executor.submit(
+                self._create_run_path, run_args, ensemble, runpath_ready
             )
+            runpaths_created.add_done_callback(fail_waiting_realizations)
+            try:
+                successful_realizations = self.run_ensemble_evaluator(
+                    run_args,
+                    ensemble,
+                    evaluator_server_config,
+                )
+            finally:
+                self._runpath_ready = {}
+            runpaths_created.result()
+        return successful_realizations
+
+    def _evaluate_and_postprocess(
+        self,
+        run_args: list[RunArg],
+        ensemble: Ensemble,
+        evaluator_server_config: EvaluatorServerConfig,
+    ) -> int:
+        # PRE_SIMULATION workflows may change the runpaths, so the
+        # realizations can only be submitted early if there are none
+        submit_early = self._queue_config.submit_when_runpath_ready
+        if submit_early and self._hooked_workflows[HookRuntime.PRE_SIMULATION]:
+            logger.info(
+                "Ignoring SUBMIT_WHEN_RUNPATH_READY as there are "
+                "PRE_SIMULATION workflows"
+            )
+            submit_early = False
+
+        if not submit_early:
+            self._create_run_path(run_args, ensemble)
+            self.run_workflows(
+                HookRuntime.PRE_SIMULATION,
+                fixtures={
+                    "storage": self._storage,
+                    "ensemble": ensemble,
+                    "reports_dir": self.reports_dir(
+                        experiment_name=ensemble.experiment.name
+                    ),
+                    "random_seed": self.random_seed,
+                    "run_paths": self.run_paths,
+                },
+            )
+        try:
+            # The results are on disk once the context exits
+            with self._storage.write_behind_context():
+                if submit_early:
+                    successful_realizations = (
+                        self._create_run_path_and_run_ensemble_evaluator(
+                            run_args, ensemble, evaluator_server_config
+                        )
+                    )
+                else:
+                    successful_realizations = self.run_ensemble_evaluator(
+                        run_args,
+                        ensemble,
+                        evaluator_server_config,
+                    )
         except UserCancelled:
             self.active_realizations = [False for _ in self.active_realizations]
             raise
@@ -919,21 +1002,22 @@ def update(
             fixtures=workflow_fixtures,
         )
         try:
-            smoother_update(
-                prior,
-                posterior,
-                update_settings=self._update_settings,
-                es_settings=self._analysis_settings,
-                parameters=prior.experiment.update_parameters,
-                observations=prior.experiment.observation_keys,
-                global_scaling=weight,
-                rng=self.rng,
-                progress_callback=functools.partial(
-                    self.send_smoother_event,
-                    prior.iteration,
-                    prior.id,
-                ),
-            )
+            with self._storage.write_behind_context():
+                smoother_update(
+                    prior,
+                    posterior,
+                    update_settings=self._update_settings,
+                    es_settings=self._analysis_settings,
+                    parameters=prior.experiment.update_parameters,
+                    observations=prior.experiment.observation_keys,
+                    global_scaling=weight,
+                    rng=self.rng,
+                    progress_callback=functools.partial(
+                        self.send_smoother_event,
+                        prior.iteration,
+                        prior.id,
+                    ),
+                )
         except ErtAnalysisError as e:
             raise ErtRunError(
                 "Update algorithm failed for iteration:"
@@ -45,6 +45,9 @@ class _CacheHitInfo(TypedDict):
     target_evaluation_id: int
     target_perturbation: int
     model_realization: int
+    # The source batch is a batch of an earlier optimization, e.g. of the
+    # optimization before a restart
+    from_earlier_optimization: bool
 
 
 class EverestCacheHitEvent(BaseModel):
@@ -7,6 +7,7 @@
 import os
 import queue
 import shutil
+import uuid
 from collections.abc import Callable, MutableSequence
 from enum import IntEnum, auto
 from pathlib import Path
@@ -37,6 +38,7 @@
 from everest.config import ControlConfig, ControlVariableGuessListConfig, EverestConfig
 from everest.config.utils import FlattenedControls
 from everest.everest_storage import (
+    EvaluationCache,
     EverestStorage,
     OptimalResult,
 )
@@ -139,6 +141,7 @@ def __init__(
         self._result: OptimalResult | None = None
         self._exit_code: EverestExitCode | None = None
         self._experiment: Experiment | None = None
+        self._evaluation_cache: EvaluationCache | None = None
         self._eval_server_cfg: EvaluatorServerConfig | None = None
         self._batch_id: int = 0
 
@@ -315,6 +318,11 @@ def run_experiment(
             output_dir=Path(self._everest_config.optimization_output_dir),
         )
         self.ever_storage.init(self._everest_config)
+        self._evaluation_cache = EvaluationCache(
+            Path(self._everest_config.optimization_output_dir) / "evaluation_cache",
+            EvaluationCache.config_hash(self._everest_config),
+            optimization_id=str(uuid.uuid4()),
+        )
         optimizer.set_results_callback(self._handle_optimizer_results)
 
         # Run the optimization:
@@ -654,7 +662,9 @@ def _create_evaluation_infos(
             sim_id_counter += 1
 
         cache_hits = (
-            cache_hits_df[["batch", "simulation_id", "flat_index"]]
+            cache_hits_df[
+                ["batch", "simulation_id", "flat_index", "from_earlier_optimization"]
+            ]
             if cache_hits_df is not None and not cache_hits_df.is_empty()
             else None
         )
@@ -677,8 +687,8 @@ def _forward_model_evaluator(
 
         num_constraints = len(self._everest_config.constraint_names)
 
-        assert self._experiment is not None
-        all_results = self._experiment.all_parameters_and_gen_data
+        assert self._evaluation_cache is not None
+        all_results = self._evaluation_cache.results()
 
         evaluation_infos, cache_hits_df = self._create_evaluation_infos(
             control_values=control_values,
@@ -724,6 +734,10 @@ def _forward_model_evaluator(
                         "flat_index": "target_evaluation_id",
                     }
                 )
+                # In the order of the fields of _CacheHitInfo
+                .select(
+                    pl.exclude("from_earlier_optimization"), "from_earlier_optimization"
+                )
                 .to_dicts()
             )
 
@@ -731,20 +745,14 @@ def _forward_model_evaluator(
                 EverestCacheHitEvent(batch=self._batch_id, data=cache_hits_dict)
             )
 
+        sim_infos = [
+            c for c in evaluation_infos if c.status == _EvaluationStatus.TO_SIMULATE
+        ]
         control_values_to_simulate = np.array(
-            [
-                c.control_vector
-                for c in evaluation_infos
-                if c.status == _EvaluationStatus.TO_SIMULATE
-            ],
-            dtype=np.float64,
+            [c.control_vector for c in sim_infos], dtype=np.float64
         )
 
         if control_values_to_simulate.shape[0] > 0:
-            sim_infos = [
-                c for c in evaluation_infos if c.status == _EvaluationStatus.TO_SIMULATE
-            ]
-
             self.send_event(
                 EverestStatusEvent(
                     batch=self._batch_id,
@@ -780,6 +788,9 @@ def _forward_model_evaluator(
                     else None
                 )
 
+        if sim_infos:
+            self._cache_simulation_results(sim_infos)
+
         # At this point:
         # cached results are attached to cached evaluations
         # np.zeros are attached to inactive evaluations
@@ -807,13 +818,18 @@ def _forward_model_evaluator(
                     sim_ids.append(ei.simulation_id)
                     source_batch_ids.append(self._batch_id)
                 case _EvaluationStatus.CACHED:
-                    sim_id, batch_id = next(
-                        (item["source_simulation_id"], item["source_batch_id"])
+                    hit = next(
+                        item
                         for item in cache_hits_dict
                         if item["target_evaluation_id"] == ei.flat_index
                     )
-                    sim_ids.append(sim_id)
-                    source_batch_ids.append(batch_id)
+                    sim_ids.append(hit["source_simulation_id"])
+                    # The batches of earlier optimizations are not in this one
+                    source_batch_ids.append(
+                        -1
+                        if hit["from_earlier_optimization"]
+                        else hit["source_batch_id"]
+                    )
                 case _EvaluationStatus.INACTIVE:
                     sim_ids.append(-1)
                     source_batch_ids.append(-1)
@@ -833,6 +849,50 @@ def _forward_model_evaluator(
 
         return evaluator_result
 
+    def _cache_simulation_results(self, sim_infos: list[_EvaluationInfo]) -> None:
+        assert self._evaluation_cache is not None
+        objective_names = self._everest_config.objective_names
+        constraint_names = self._everest_config.constraint_names
+        control_names = self._everest_config.formatted_control_names
+
+        objectives = np.array([ei.objectives for ei in sim_infos], dtype=np.float64)
+        constraints = (
+            np.array([ei.constraints for ei in sim_infos], dtype=np.float64)
+            if constraint_names
+            else np.zeros((len(sim_infos), 0))
+        )
+        controls = np.array([ei.control_vector for ei in sim_infos], dtype=np.float64)
+        self._evaluation_cache.add(
+            pl.DataFrame(
+                {
+                    "batch": pl.Series(
+                        [self._batch_id] * len(sim_infos), dtype=pl.Int32
+                    ),
+                    "model_realization": pl.Series(
+                        [ei.model_realization for ei in sim_infos], dtype=pl.UInt16
+                    ),
+                    "perturbation": pl.Series(
+                        [ei.perturbation for ei in sim_infos], dtype=pl.Int32
+                    ),
+                    "realization": pl.Series(
+                        [ei.simulation_id for ei in sim_infos], dtype=pl.UInt16
+                    ),
+                    **{
+                        name: pl.Series(objectives[:, i], dtype=pl.Float64)
+                        for i, name in enumerate(objective_names)
+                    },
+                    **{
+                        name: pl.Series(constraints[:, i], dtype=pl.Float64)
+                        for i, name in enumerate(constraint_names)
+                    },
+                    **{
+                        name: pl.Series(controls[:, i], dtype=pl.Float64)
+                        for i, name in enumerate(control_names)
+                    },
+                }
+            )
+        )
+
     def _create_simulation_controls(
         self,
         control_values: NDArray[np.float64],
@@ -4,6 +4,8 @@
 from pwd import getpwuid
 from typing import TYPE_CHECKING
 
+import psutil
+
 from ert.config import QueueSystem
 
 from .driver import Driver
@@ -21,6 +23,9 @@
 def create_driver(queue_options: QueueOptions) -> Driver:
     match str(queue_options.name):
         case QueueSystem.LOCAL:
+            if queue_options.predictive_scheduling:
+                # Realizations only wait for memory when it is predicted
+                return LocalDriver(memory_limit=psutil.virtual_memory().total)
             return LocalDriver()
         case QueueSystem.TORQUE:
             return OpenPBSDriver(**queue_options.driver_options)
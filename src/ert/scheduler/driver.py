@@ -3,8 +3,11 @@
 import asyncio
 import logging
 import shlex
+import time
 from abc import ABC, abstractmethod
-from collections.abc import Iterable
+from collections.abc import Awaitable, Callable, Iterable, Mapping, Sequence
+from contextlib import suppress
+from dataclasses import dataclass
 from pathlib import Path
 
 from .event import Event
@@ -12,6 +15,19 @@
 SIGNAL_OFFSET = 128
 """Bash and other shells add an offset of 128 to the signal value when a process exited due to a signal"""
 
+SUBMIT_BATCH_WINDOW = 0.1
+"""Seconds to wait for more submits before submitting a batch, see SubmitBatcher"""
+MAX_ARRAY_SIZE = 1000
+"""Largest number of realizations submitted as one job array"""
+MAX_SWEEP_PERIOD = 30.0
+"""Longest period between polls of the queue system once the forward model
+dispatchers notify the driver of finished jobs, see Driver.notify_finished"""
+JOBS_PER_POLL_PERIOD = 100
+"""Number of jobs per poll period added to the sweep period"""
+FINISHING_TIMEOUT = 60.0
+"""How long a notified job is polled for at the poll period, before it is
+left to the sweep"""
+
 
 def create_submit_script(
     runpath: Path, executable: str, args: tuple[str, ...], activate_script: str
@@ -24,10 +40,140 @@ def create_submit_script(
     )
 
 
+def create_array_submit_script(
+    index_variable: str,
+    requests: Sequence[SubmitRequest],
+    activate_script: str,
+    outputs: Sequence[tuple[str, str]] | None = None,
+    first_index: int = 0,
+) -> str:
+    """Submit script for a job array, where the element given by the
+    environment variable index_variable runs requests[index - first_index],
+    optionally redirecting its stdout and stderr to the given files in its
+    runpath."""
+    elements = []
+    for index, request in enumerate(requests):
+        runpath = request.runpath or Path.cwd()
+        redirect = ""
+        if outputs is not None:
+            stdout, stderr = outputs[index]
+            redirect = f"exec >{shlex.quote(stdout)} 2>{shlex.quote(stderr)}\n"
+        elements.append(
+            f"{first_index + index})\n"
+            f"cd {shlex.quote(str(runpath))}\n"
+            f"{redirect}"
+            f"{activate_script}\n"
+            f"exec -a {shlex.quote(request.executable)} {request.executable} "
+            f"{shlex.join(request.args)}\n"
+            ";;\n"
+        )
+    return (
+        "#!/usr/bin/env bash\n"
+        f'case "${index_variable}" in\n'
+        f"{''.join(elements)}"
+        "*)\n"
+        f'echo "Unknown array index ${index_variable}" >&2\n'
+        "exit 1\n"
+        ";;\n"
+        "esac\n"
+    )
+
+
 class FailedSubmit(RuntimeError):
     pass
 
 
+@dataclass
+class SubmitRequest:
+    """The arguments of one call to Driver.submit, see Driver.submit_many"""
+
+    iens: int
+    executable: str
+    args: tuple[str, ...] = ()
+    name: str | None = None
+    runpath: Path | None = None
+    num_cpu: int | None = 1
+    realization_memory: int | None = 0
+
+
+def array_groups(
+    requests: Sequence[SubmitRequest],
+) -> Iterable[list[SubmitRequest]]:
+    """Split requests into groups that can be submitted as one job array,
+    as the elements of an array share the program and resource requirements"""
+    groups: dict[tuple[str, int | None, int | None], list[SubmitRequest]] = {}
+    for request in requests:
+        groups.setdefault(
+            (request.executable, request.num_cpu, request.realization_memory), []
+        ).append(request)
+    for group in groups.values():
+        for start in range(0, len(group), MAX_ARRAY_SIZE):
+            yield group[start : start + MAX_ARRAY_SIZE]
+
+
+class SubmitBatcher:
+    """Collects the submits made within a short window of each other, and
+    submits them together with submit_batch.
+
+    The scheduler submits realizations one by one, this lets drivers that
+    support job arrays submit all realizations that are ready at the same time
+    as one array. Submits made while a batch is being submitted are collected
+    into the next batch.
+    """
+
+    def __init__(
+        self,
+        submit_batch: Callable[
+            [Sequence[SubmitRequest]], Awaitable[Mapping[int, FailedSubmit]]
+        ],
+        kill: Callable[[int], Awaitable[None]],
+        window: float = SUBMIT_BATCH_WINDOW,
+    ) -> None:
+        self._submit_batch = submit_batch
+        self._kill = kill
+        self._window = window
+        self._pending: list[tuple[SubmitRequest, asyncio.Future[None]]] = []
+        self._flush_task: asyncio.Task[None] | None = None
+        self._kill_tasks: set[asyncio.Task[None]] = set()
+
+    async def submit(self, request: SubmitRequest) -> None:
+        """Wait until the request has been submitted, raises FailedSubmit if it
+        could not be submitted"""
+        future: asyncio.Future[None] = asyncio.get_running_loop().create_future()
+        self._pending.append((request, future))
+        if self._flush_task is None or self._flush_task.done():
+            self._flush_task = asyncio.create_task(self._flush())
+        await future
+
+    async def _flush(self) -> None:
+        await asyncio.sleep(self._window)
+        while self._pending:
+            batch = [(request, f) for request, f in self._pending if not f.done()]
+            self._pending = []
+            if not batch:
+                continue
+            try:
+                failures = await self._submit_batch([request for request, _ in batch])
+            except Exception as err:
+                for _, future in batch:
+                    if not future.done():
+                        future.set_exception(err)
+                continue
+            for request, future in batch:
+                failure = failures.get(request.iens)
+                if future.cancelled():
+                    # The job gave up while the batch was being submitted,
+                    # so nobody else is going to kill it
+                    if failure is None:
+                        task = asyncio.create_task(self._kill(request.iens))
+                        self._kill_tasks.add(task)
+                        task.add_done_callback(self._kill_tasks.discard)
+                elif failure is not None:
+                    future.set_exception(failure)
+                else:
+                    future.set_result(None)
+
+
 class Driver(ABC):
     """Adapter for the HPC cluster."""
 
@@ -35,6 +181,10 @@ def __init__(self, activate_script: str = "") -> None:
         self._event_queue: asyncio.Queue[Event] | None = None
         self._job_error_message_by_iens: dict[int, str] = {}
         self.activate_script = activate_script
+        self._poll_period: float = 2.0
+        self._poll_requested = asyncio.Event()
+        self._finishing: dict[int, float] = {}
+        self._has_finished_notifications = False
 
     @property
     def event_queue(self) -> asyncio.Queue[Event]:
@@ -67,6 +217,58 @@ async def submit(
             be regareded as a hint to the queue system, not absolute limits.
         """
 
+    async def submit_many(
+        self, requests: Sequence[SubmitRequest]
+    ) -> dict[int, FailedSubmit]:
+        """Submit several programs to execute on the cluster.
+
+        The requests with the same program and resource requirements are
+        submitted together with _submit_array, which drivers that support job
+        arrays submit as one array, while a request on its own is submitted
+        with _submit_one.
+
+        Args:
+          requests: The arguments of each submit
+
+        Returns:
+          The reason for each realization that failed to be submitted.
+        """
+        failures: dict[int, FailedSubmit] = {}
+        for group in array_groups(requests):
+            if len(group) == 1:
+                try:
+                    await self._submit_one(group[0])
+                except FailedSubmit as err:
+                    failures[group[0].iens] = err
+            else:
+                failures.update(await self._submit_array(group))
+        return failures
+
+    async def _submit_one(self, request: SubmitRequest) -> None:
+        """Submit one request as a job of its own"""
+        await self.submit(
+            request.iens,
+            request.executable,
+            *request.args,
+            name=request.name,
+            runpath=request.runpath,
+            num_cpu=request.num_cpu,
+            realization_memory=request.realization_memory,
+        )
+
+    async def _submit_array(
+        self, requests: Sequence[SubmitRequest]
+    ) -> dict[int, FailedSubmit]:
+        """Submit requests that share program and resource requirements, one by
+        one unless the driver supports job arrays"""
+        failures: dict[int, FailedSubmit] = {}
+        for request in requests:
+            try:
+                await self._submit_one(request)
+            except FailedSubmit as err:
+                failures[request.iens] = err
+        return failures
+
     @abstractmethod
     async def kill(self, iens: int) -> None:
         """Terminate execution of a job associated with a realization.
@@ -83,6 +285,50 @@ async def poll(self) -> None:
     async def finish(self) -> None:
         """make sure that all the jobs / realizations are complete."""
 
+    def notify_finished(self, iens: int) -> None:
+        """Notify the driver that the forward model of a realization has
+        finished, and that its job is about to exit, so that the queue system
+        is polled right away rather than in the next sweep.
+
+        Args:
+          iens: Realization number.
+        """
+        self._has_finished_notifications = True
+        self._finishing[iens] = time.monotonic() + FINISHING_TIMEOUT
+        self._poll_requested.set()
+
+    def _job_finished(self, iens: int) -> None:
+        self._finishing.pop(iens, None)
+
+    def _sweep_period(self, number_of_jobs: int) -> float:
+        """Without notifications of finished jobs the queue system is polled
+        every poll period. Once notifications arrive, polling is only needed
+        as a consistency sweep for jobs that are never notified, and the
+        period backs off with the number of jobs, except while notified jobs
+        are still waiting to be reported finished by the queue system."""
+        now = time.monotonic()
+        self._finishing = {
+            iens: deadline
+            for iens, deadline in self._finishing.items()
+            if deadline > now
+        }
+        if not self._has_finished_notifications or self._finishing:
+            return self._poll_period
+        return max(
+            self._poll_period,
+            min(
+                MAX_SWEEP_PERIOD,
+                self._poll_period * (1 + number_of_jobs / JOBS_PER_POLL_PERIOD),
+            ),
+        )
+
+    async def _wait_for_next_poll(self, number_of_jobs: int) -> None:
+        with suppress(TimeoutError):
+            await asyncio.wait_for(
+                self._poll_requested.wait(), timeout=self._sweep_period(number_of_jobs)
+            )
+        self._poll_requested.clear()
+
     def read_stdout_and_stderr_files(
         self, runpath: str, job_name: str, num_characters_to_read_from_end: int = 300
     ) -> str:
@@ -112,15 +112,16 @@ async def _submit_and_run_once(self, sem: asyncio.BoundedSemaphore) -> None:
             await self._send(JobState.SUBMITTING)
             submit_time = time.time()
             try:
-                await self.driver.submit(
-                    self.real.iens,
-                    self.real.job_script,
-                    self.real.run_arg.runpath,
-                    num_cpu=self.real.num_cpu,
-                    realization_memory=self.real.realization_memory,
-                    name=self.real.run_arg.job_name,
-                    runpath=Path(self.real.run_arg.runpath),
-                )
+                with tracer.start_as_current_span(f"{__name__}.submit"):
+                    await self.driver.submit(
+                        self.real.iens,
+                        self.real.job_script,
+                        self.real.run_arg.runpath,
+                        num_cpu=self.real.num_cpu,
+                        realization_memory=self.real.realization_memory,
+                        name=self.real.run_arg.job_name,
+                        runpath=Path(self.real.run_arg.runpath),
+                    )
             except FailedSubmit as err:
                 await self._send(JobState.FAILED)
                 logger.error(f"Failed to submit: {err}")
@@ -128,7 +129,8 @@ async def _submit_and_run_once(self, sem: asyncio.BoundedSemaphore) -> None:
                 return
 
             await self._send(JobState.PENDING)
-            await self.started.wait()
+            with tracer.start_as_current_span(f"{__name__}.pending"):
+                await self.started.wait()
             self._start_time = time.time()
             pending_time = self._start_time - submit_time
             logger.info(
@@ -144,7 +146,8 @@ async def _submit_and_run_once(self, sem: asyncio.BoundedSemaphore) -> None:
                 self._scheduler.warnings_extracted = True
                 await log_warnings_from_forward_model(self.real)
 
-            await self.returncode
+            with tracer.start_as_current_span(f"{__name__}.running"):
+                await self.returncode
 
         except asyncio.CancelledError:
             await self._send(JobState.ABORTING)
@@ -161,13 +164,16 @@ async def _submit_and_run_once(self, sem: asyncio.BoundedSemaphore) -> None:
     async def run(
         self,
         sem: asyncio.BoundedSemaphore,
-        forward_model_ok_lock: asyncio.Lock,
+        internalization_slots: asyncio.Semaphore | asyncio.Lock,
         checksum_lock: asyncio.Lock,
         max_submit: int = 1,
     ) -> None:
         current_span = trace.get_current_span()
         current_span.set_attribute("ert.realization_number", self.iens)
+        current_span.set_attribute("ert.num_cpu", self.real.num_cpu)
         self._requested_max_submit = max_submit
+        if not await self._wait_for_runpath():
+            return
         for attempt in range(max_submit):
             await self._submit_and_run_once(sem)
 
@@ -177,8 +183,9 @@ async def run(
             if self.returncode.result() == 0:
                 if self._scheduler._manifest_queue is not None:
                     await self._verify_checksum(checksum_lock)
-                async with forward_model_ok_lock:
-                    await self._handle_finished_forward_model()
+                async with internalization_slots:
+                    with tracer.start_as_current_span(f"{__name__}.internalize"):
+                        await self._handle_finished_forward_model()
                 break
 
             if attempt < max_submit - 1:
@@ -194,6 +201,37 @@ async def run(
                 current_span.set_status(Status(StatusCode.ERROR))
                 await self._send(JobState.FAILED)
 
+    async def _wait_for_runpath(self) -> bool:
+        """Wait for the runpath of the realization to be written, for
+        realizations that are submitted while runpaths are being created.
+        Returns False if the runpath could not be created."""
+        if self.real.runpath_ready is None:
+            return True
+        await self._send(JobState.WAITING)
+        try:
+            # Shielded so that cancelling the job does not cancel the future
+            # which the thread creating the runpath will set
+            await asyncio.shield(asyncio.wrap_future(self.real.runpath_ready))
+        except asyncio.CancelledError:
+            self.returncode.cancel()
+            await self._send(JobState.ABORTED)
+            return False
+        except Exception as err:
+            self._message = f"Runpath could not be created: {err}"
+            self.returncode.cancel()
+            await self._send(JobState.FAILED)
+            return False
+        # The dispatch information is added to the jobs.json of the other
+        # realizations before any of them are submitted
+        if error_msg := self._scheduler._update_jobs_json(
+            self.iens, self.real.run_arg.runpath
+        ):
+            self._message = error_msg
+            self.returncode.cancel()
+            await self._send(JobState.FAILED)
+            return False
+        return True
+
     async def _max_runtime_task(self) -> None:
         assert self.real.max_runtime is not None
         await asyncio.sleep(self.real.max_runtime)
@@ -265,6 +303,7 @@ async def _handle_finished_forward_model(self) -> None:
             realization=self.real.run_arg.iens,
             iter=self.real.run_arg.itr,
             ensemble=self.real.run_arg.ensemble_storage,
+            executor=self._scheduler._internalization_executor,
         )
         if self._message:
             self._message = status_msg
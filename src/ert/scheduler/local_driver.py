@@ -18,10 +18,19 @@
 
 
 class LocalDriver(Driver):
-    def __init__(self) -> None:
+    def __init__(self, memory_limit: int | None = None) -> None:
+        """
+        Args:
+          memory_limit: Bytes of memory the realizations that book memory may
+            book in total, realizations wait to start until the memory they
+            book is available. None means that memory is not booked.
+        """
         super().__init__()
         self._tasks: MutableMapping[int, asyncio.Task[None]] = {}
         self._sent_finished_events: set[int] = set()
+        self._memory_limit = memory_limit
+        self._booked_memory: dict[int, int] = {}
+        self._memory_released = asyncio.Condition()
 
     async def submit(
         self,
@@ -35,10 +44,30 @@ async def submit(
         realization_memory: int | None = 0,
         activate_script: str = "",
     ) -> None:
+        if realization_memory and self._memory_limit:
+            await self._book_memory(iens, realization_memory)
         self._tasks[iens] = asyncio.create_task(self._run(iens, executable, *args))
         with suppress(KeyError):
             self._sent_finished_events.remove(iens)
 
+    async def _book_memory(self, iens: int, realization_memory: int) -> None:
+        """Wait until the memory is available. A realization that books more
+        than the memory limit is started when no other memory is booked"""
+        assert self._memory_limit is not None
+        memory_limit = self._memory_limit
+        async with self._memory_released:
+            await self._memory_released.wait_for(
+                lambda: not self._booked_memory
+                or sum(self._booked_memory.values()) + realization_memory
+                <= memory_limit
+            )
+            self._booked_memory[iens] = realization_memory
+
+    async def _release_memory(self, iens: int) -> None:
+        if self._booked_memory.pop(iens, None) is not None:
+            async with self._memory_released:
+                self._memory_released.notify_all()
+
     async def kill(self, iens: int) -> None:
         try:
             self._tasks[iens].cancel()
@@ -46,6 +75,8 @@ async def kill(self, iens: int) -> None:
             with contextlib.suppress(asyncio.CancelledError):
                 await self._tasks[iens]
             del self._tasks[iens]
+            # The task may have been cancelled before it started running
+            await self._release_memory(iens)
             await self._dispatch_finished_event(iens, signal.SIGTERM + SIGNAL_OFFSET)
 
         except KeyError:
@@ -64,6 +95,14 @@ async def finish(self) -> None:
         logger.info("All realization tasks finished")
 
     async def _run(self, iens: int, executable: str, /, *args: str | Path) -> None:
+        try:
+            await self._run_process(iens, executable, *args)
+        finally:
+            await self._release_memory(iens)
+
+    async def _run_process(
+        self, iens: int, executable: str, /, *args: str | Path
+    ) -> None:
         logger.debug(
             f"Submitting realization {iens} as command '{executable} {' '.join(str(arg) for arg in args)}'"
         )
@@ -10,6 +10,7 @@
 import stat
 import time
 from collections.abc import Iterable, Mapping, MutableMapping, Sequence
+from contextlib import AsyncExitStack
 from dataclasses import dataclass
 from pathlib import Path
 from tempfile import NamedTemporaryFile
@@ -19,7 +20,15 @@
     get_args,
 )
 
-from .driver import SIGNAL_OFFSET, Driver, FailedSubmit, create_submit_script
+from .driver import (
+    SIGNAL_OFFSET,
+    Driver,
+    FailedSubmit,
+    SubmitBatcher,
+    SubmitRequest,
+    create_array_submit_script,
+    create_submit_script,
+)
 from .event import Event, FinishedEvent, StartedEvent
 
 _POLL_PERIOD = 2.0  # seconds
@@ -111,11 +120,30 @@ class JobData:
     exec_hosts: str = "-"
 
 
+def _element_job_id(job_id: str, job_index: str) -> str:
+    """The id of element job_index of job array job_id, as understood by
+    bjobs, bkill and bhist. Jobs that are not in an array have index 0."""
+    return f"{job_id}[{job_index}]" if job_index not in {"", "0"} else job_id
+
+
+def _split_bjobs_line(line: str) -> tuple[str, str, str] | None:
+    """Job id, state and exec hosts of a line of bjobs -o "jobid stat
+    exec_host [jobindex]" delimited by ^, where the optional job index
+    identifies array elements"""
+    tokens = line.split(sep="^")
+    if len(tokens) == 3:
+        job_id, job_state, exec_hosts = tokens
+        return job_id, job_state, exec_hosts
+    if len(tokens) == 4:
+        job_id, job_state, exec_hosts, job_index = tokens
+        return _element_job_id(job_id, job_index.strip()), job_state, exec_hosts
+    return None
+
+
 def parse_bjobs(bjobs_output: str) -> dict[str, JobState]:
     data: dict[str, JobState] = {}
     for line in bjobs_output.splitlines():
-        tokens = line.split(sep="^")
-        if len(tokens) == 3:
+        if (tokens := _split_bjobs_line(line)) is not None:
             job_id, job_state, _ = tokens
             if job_state not in get_args(JobState):
                 logger.error(
@@ -130,8 +158,7 @@ def parse_bjobs(bjobs_output: str) -> dict[str, JobState]:
 def parse_bjobs_exec_hosts(bjobs_output: str) -> dict[str, str]:
     data: dict[str, str] = {}
     for line in bjobs_output.splitlines():
-        tokens = line.split(sep="^")
-        if len(tokens) == 3:
+        if (tokens := _split_bjobs_line(line)) is not None:
             job_id, _, exec_hosts = tokens
             data[job_id] = exec_hosts
     return data
@@ -257,8 +284,11 @@ def __init__(
         bkill_cmd: str | None = None,
         bhist_cmd: str | None = None,
         activate_script: str = "",
+        job_arrays: bool = False,
     ) -> None:
         super().__init__(activate_script)
+        self._job_arrays = job_arrays
+        self._submit_batcher = SubmitBatcher(self.submit_many, self.kill)
         self._queue_name = queue_name
         self._project_code = project_code
         self._resource_requirement = resource_requirement
@@ -297,42 +327,32 @@ async def submit(
         num_cpu: int | None = 1,
         realization_memory: int | None = 0,
     ) -> None:
-        if runpath is None:
-            runpath = Path.cwd()
-        if name is None:
-            name = Path(executable).name
+        request = SubmitRequest(
+            iens, executable, args, name, runpath, num_cpu, realization_memory
+        )
+        if self._job_arrays:
+            await self._submit_batcher.submit(request)
+        else:
+            await self._submit_one(request)
 
+    def _bsub_cmd_with_args(
+        self,
+        name: str,
+        stdout: str,
+        stderr: str,
+        num_cpu: int | None,
+        realization_memory: int | None,
+    ) -> list[str]:
         arg_queue_name = ["-q", self._queue_name] if self._queue_name else []
         arg_project_code = ["-P", self._project_code] if self._project_code else []
-        script = create_submit_script(runpath, executable, args, self.activate_script)
-        script_path: Path | None = None
-        try:
-            with NamedTemporaryFile(
-                dir=runpath,
-                prefix=".lsf_submit_",
-                suffix=".sh",
-                mode="w",
-                encoding="utf-8",
-                delete=False,
-            ) as script_handle:
-                script_handle.write(script)
-                script_path = Path(script_handle.name)
-        except OSError as err:
-            error_message = f"Could not create submit script: {err}"
-            self._job_error_message_by_iens[iens] = error_message
-            raise FailedSubmit(error_message) from err
-
-        assert script_path is not None
-        script_path.chmod(script_path.stat().st_mode | stat.S_IEXEC)
-
-        bsub_with_args: list[str] = [
+        return [
             str(self._bsub_cmd),
             *arg_queue_name,
             *arg_project_code,
             "-o",
-            str(runpath / (name + ".LSF-stdout")),
+            stdout,
             "-e",
-            str(runpath / (name + ".LSF-stderr")),
+            stderr,
             "-n",
             str(num_cpu),
             *self._build_resource_requirement_arg(
@@ -340,6 +360,76 @@ async def submit(
             ),
             "-J",
             name,
+        ]
+
+    @staticmethod
+    def _write_submit_script(runpath: Path, script: str) -> Path:
+        with NamedTemporaryFile(
+            dir=runpath,
+            prefix=".lsf_submit_",
+            suffix=".sh",
+            mode="w",
+            encoding="utf-8",
+            delete=False,
+        ) as script_handle:
+            script_handle.write(script)
+            script_path = Path(script_handle.name)
+        script_path.chmod(script_path.stat().st_mode | stat.S_IEXEC)
+        return script_path
+
+    async def _bsub(self, bsub_with_args: list[str]) -> tuple[bool, str]:
+        """Run bsub, and return whether it succeeded with the job id of the
+        submitted job, or the error message"""
+        logger.debug(f"Submitting to LSF with command {shlex.join(bsub_with_args)}")
+        process_success, process_message = await self._execute_with_retry(
+            bsub_with_args,
+            retry_on_empty_stdout=True,
+            retry_codes=(FLAKY_SSH_RETURNCODE,),
+            total_attempts=self._max_bsub_attempts,
+            retry_interval=self._sleep_time_between_cmd_retries,
+            error_on_msgs=BSUB_FAILURE_MESSAGES,
+        )
+        if not process_success:
+            return False, process_message
+        match = re.search(r"Job <([0-9]+)> is submitted to .*queue", process_message)
+        if match is None:
+            return False, f"Could not understand '{process_message}' from bsub"
+        return True, match[1]
+
+    def _add_job(self, iens: int, job_id: str, runpath: Path) -> None:
+        (runpath / LSF_INFO_JSON_FILENAME).write_text(
+            json.dumps({"job_id": job_id}), encoding="utf-8"
+        )
+        self._jobs[job_id] = JobData(
+            iens=iens,
+            job_state=QueuedJob(job_state="PEND"),
+            submitted_timestamp=time.time(),
+        )
+        self._iens2jobid[iens] = job_id
+
+    async def _submit_one(self, request: SubmitRequest) -> None:
+        iens = request.iens
+        runpath = request.runpath or Path.cwd()
+        name = request.name or Path(request.executable).name
+
+        script = create_submit_script(
+            runpath, request.executable, request.args, self.activate_script
+        )
+        try:
+            script_path = self._write_submit_script(runpath, script)
+        except OSError as err:
+            error_message = f"Could not create submit script: {err}"
+            self._job_error_message_by_iens[iens] = error_message
+            raise FailedSubmit(error_message) from err
+
+        bsub_with_args: list[str] = [
+            *self._bsub_cmd_with_args(
+                name,
+                str(runpath / (name + ".LSF-stdout")),
+                str(runpath / (name + ".LSF-stderr")),
+                request.num_cpu,
+                request.realization_memory,
+            ),
             str(script_path),
             str(runpath),
         ]
@@ -348,38 +438,92 @@ async def submit(
             self._submit_locks[iens] = asyncio.Lock()
 
         async with self._submit_locks[iens]:
-            logger.debug(f"Submitting to LSF with command {shlex.join(bsub_with_args)}")
-            process_success, process_message = await self._execute_with_retry(
-                bsub_with_args,
-                retry_on_empty_stdout=True,
-                retry_codes=(FLAKY_SSH_RETURNCODE,),
-                total_attempts=self._max_bsub_attempts,
-                retry_interval=self._sleep_time_between_cmd_retries,
-                error_on_msgs=BSUB_FAILURE_MESSAGES,
-            )
+            process_success, process_message = await self._bsub(bsub_with_args)
             if not process_success:
                 self._job_error_message_by_iens[iens] = process_message
                 raise FailedSubmit(process_message)
-
-            match = re.search(
-                r"Job <([0-9]+)> is submitted to .*queue", process_message
-            )
-            if match is None:
-                raise FailedSubmit(
-                    f"Could not understand '{process_message}' from bsub"
-                )
-            job_id = match[1]
+            job_id = process_message
             logger.info(f"Realization {iens} accepted by LSF, got id {job_id}")
-
-            (Path(runpath) / LSF_INFO_JSON_FILENAME).write_text(
-                json.dumps({"job_id": job_id}), encoding="utf-8"
+            self._add_job(iens, job_id, runpath)
+
+    async def _submit_array(
+        self, requests: Sequence[SubmitRequest]
+    ) -> dict[int, FailedSubmit]:
+        """Submit requests, which share program and resources, as one job
+        array name[1-N]. LSF numbers the elements from 1, and element i of
+        array id is tracked as the job id[i], which is how bjobs, bkill and
+        bhist refer to array elements."""
+        first = requests[0]
+        runpath = first.runpath or Path.cwd()
+        names = [
+            request.name or Path(request.executable).name for request in requests
+        ]
+        script = create_array_submit_script(
+            "LSB_JOBINDEX", requests, self.activate_script, first_index=1
+        )
+        try:
+            script_path = self._write_submit_script(runpath, script)
+            outputs_dir = self._link_array_outputs(
+                script_path.with_suffix(".outputs"), requests, names
             )
-            self._jobs[job_id] = JobData(
-                iens=iens,
-                job_state=QueuedJob(job_state="PEND"),
-                submitted_timestamp=time.time(),
+        except OSError as err:
+            error_message = f"Could not create submit script: {err}"
+            for request in requests:
+                self._job_error_message_by_iens[request.iens] = error_message
+            return {request.iens: FailedSubmit(error_message) for request in requests}
+
+        bsub_with_args: list[str] = [
+            *self._bsub_cmd_with_args(
+                f"{names[0]}[1-{len(requests)}]",
+                str(outputs_dir / "%I.LSF-stdout"),
+                str(outputs_dir / "%I.LSF-stderr"),
+                first.num_cpu,
+                first.realization_memory,
+            ),
+            str(script_path),
+        ]
+
+        async with AsyncExitStack() as locks:
+            for request in requests:
+                lock = self._submit_locks.setdefault(request.iens, asyncio.Lock())
+                await locks.enter_async_context(lock)
+            process_success, process_message = await self._bsub(bsub_with_args)
+            if not process_success:
+                for request in requests:
+                    self._job_error_message_by_iens[request.iens] = process_message
+                return {
+                    request.iens: FailedSubmit(process_message) for request in requests
+                }
+            array_id = process_message
+            logger.info(
+                f"Realizations {[request.iens for request in requests]} accepted "
+                f"by LSF as job array {array_id}"
             )
-            self._iens2jobid[iens] = job_id
+            for index, request in enumerate(requests, start=1):
+                self._add_job(
+                    request.iens,
+                    _element_job_id(array_id, str(index)),
+                    request.runpath or Path.cwd(),
+                )
+        return {}
+
+    @staticmethod
+    def _link_array_outputs(
+        outputs_dir: Path, requests: Sequence[SubmitRequest], names: Sequence[str]
+    ) -> Path:
+        """A directory of links from the -o and -e files of each element of a
+        job array, %I.LSF-stdout and %I.LSF-stderr, to the files of the
+        element in its own runpath, so that the output of an element and the
+        LSF job report, e.g. of TERM_MEMLIMIT, end up where they would for a
+        single job"""
+        outputs_dir.mkdir()
+        for index, (request, name) in enumerate(zip(requests, names, strict=True)):
+            runpath = request.runpath or Path.cwd()
+            for suffix in ("LSF-stdout", "LSF-stderr"):
+                (outputs_dir / f"{index + 1}.{suffix}").symlink_to(
+                    runpath.absolute() / f"{name}.{suffix}"
+                )
+        return outputs_dir
 
     async def kill(self, iens: int) -> None:
         if iens not in self._submit_locks:
@@ -420,7 +564,8 @@ async def kill(self, iens: int) -> None:
             )
 
             if not re.search(
-                f"Job <{job_id}> is being (terminated|signaled)", process_message
+                f"Job <{re.escape(job_id)}> is being (terminated|signaled)",
+                process_message,
             ):
                 if JOB_ALREADY_FINISHED_BKILL_MSG in process_message:
                     logger.debug(f"LSF kill failed with: {process_message}")
@@ -430,7 +575,7 @@ async def kill(self, iens: int) -> None:
     async def poll(self) -> None:
         while True:
             if not self._jobs.keys():
-                await asyncio.sleep(self._poll_period)
+                await self._wait_for_next_poll(0)
                 continue
             current_jobids = list(self._jobs.keys())
 
@@ -439,7 +584,9 @@ async def poll(self) -> None:
                     str(self._bjobs_cmd),
                     "-noheader",
                     "-o",
-                    "jobid stat exec_host delimiter='^'",
+                    "jobid stat exec_host jobindex delimiter='^'"
+                    if self._job_arrays
+                    else "jobid stat exec_host delimiter='^'",
                     *current_jobids,
                     stdout=asyncio.subprocess.PIPE,
                     stderr=asyncio.subprocess.PIPE,
@@ -486,7 +633,7 @@ async def poll(self) -> None:
                 logger.debug(
                     f"bhist did not give status for job_ids {missing_in_bhist_and_bjobs}, giving up for now."
                 )
-            await asyncio.sleep(self._poll_period)
+            await self._wait_for_next_poll(len(self._jobs))
 
     async def _process_job_update(self, job_id: str, new_state: AnyJob) -> None:
         if job_id not in self._jobs:
@@ -527,6 +674,7 @@ async def _process_job_update(self, job_id: str, new_state: AnyJob) -> None:
             if isinstance(event, FinishedEvent):
                 del self._jobs[job_id]
                 del self._iens2jobid[iens]
+                self._job_finished(iens)
                 await self._log_bhist_job_summary(job_id)
             await self.event_queue.put(event)
 
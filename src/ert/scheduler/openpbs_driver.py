@@ -5,12 +5,19 @@
 import logging
 import shlex
 import shutil
-from collections.abc import Mapping, MutableMapping
+from collections.abc import Mapping, MutableMapping, Sequence
 from dataclasses import dataclass
 from pathlib import Path
 from typing import Any, Literal, cast, get_type_hints
 
-from .driver import Driver, FailedSubmit, create_submit_script
+from .driver import (
+    Driver,
+    FailedSubmit,
+    SubmitBatcher,
+    SubmitRequest,
+    create_array_submit_script,
+    create_submit_script,
+)
 from .event import Event, FinishedEvent, StartedEvent
 
 logger = logging.getLogger(__name__)
@@ -28,7 +35,7 @@
     "T",  # Transiting
     "U",  # User suspended
     "W",  # Waiting
-    "X",  # Expired (subjobs only)
+    "X",  # Expired, i.e. finished (subjobs only)
 ]
 
 QSUB_INVALID_CREDENTIAL = 171
@@ -41,7 +48,7 @@
 
 @dataclass(frozen=True)
 class IgnoredJobstates:
-    job_state: Literal["B", "M", "S", "T", "U", "W", "X"]
+    job_state: Literal["B", "M", "S", "T", "U", "W"]
 
 
 @dataclass(frozen=True)
@@ -56,7 +63,7 @@ class RunningJob:
 
 @dataclass(frozen=True)
 class FinishedJob:
-    job_state: Literal["E", "F"]
+    job_state: Literal["E", "F", "X"]
     returncode: int | None = None
 
 
@@ -75,7 +82,7 @@ def _create_job_class(job_dict: Mapping[str, str]) -> AnyJob:
     job_state = job_dict["job_state"]
     if job_state in get_type_hints(FinishedJob)["job_state"].__args__:
         return FinishedJob(
-            cast(Literal["E", "F"], job_state),
+            cast(Literal["E", "F", "X"], job_state),
             returncode=int(job_dict["Exit_status"])
             if "Exit_status" in job_dict
             else None,
@@ -85,9 +92,7 @@ def _create_job_class(job_dict: Mapping[str, str]) -> AnyJob:
     if job_state in get_type_hints(QueuedJob)["job_state"].__args__:
         return QueuedJob(cast(Literal["H", "Q"], job_state))
     if job_state in get_type_hints(IgnoredJobstates)["job_state"].__args__:
-        return IgnoredJobstates(
-            cast(Literal["B", "M", "S", "T", "U", "W", "X"], job_state)
-        )
+        return IgnoredJobstates(cast(Literal["B", "M", "S", "T", "U", "W"], job_state))
     raise TypeError(f"Invalid job state '{job_state}'")
 
 
@@ -130,8 +135,11 @@ def __init__(
         qstat_cmd: str | None = None,
         qdel_cmd: str | None = None,
         activate_script: str = "",
+        job_arrays: bool = False,
     ) -> None:
         super().__init__(activate_script)
+        self._job_arrays = job_arrays
+        self._submit_batcher = SubmitBatcher(self.submit_many, self.kill)
 
         self._queue_name = queue_name
         self._project_code = project_code
@@ -184,22 +192,32 @@ async def submit(
         num_cpu: int | None = 1,
         realization_memory: int | None = 0,
     ) -> None:
-        if runpath is None:
-            runpath = Path.cwd()
-        if name is None:
-            name = Path(executable).name
+        request = SubmitRequest(
+            iens, executable, args, name, runpath, num_cpu, realization_memory
+        )
+        if self._job_arrays:
+            await self._submit_batcher.submit(request)
+        else:
+            await self._submit_one(request)
 
+    def _qsub_cmd_with_args(
+        self,
+        name: str,
+        num_cpu: int | None,
+        realization_memory: int | None,
+        job_array: bool = False,
+    ) -> list[str]:
         arg_queue_name = ["-q", self._queue_name] if self._queue_name else []
         arg_project_code = ["-A", self._project_code] if self._project_code else []
         arg_keep_qsub_output = (
             [] if self._keep_qsub_output else ["-o", "/dev/null", "-e", "/dev/null"]
         )
-
-        script = create_submit_script(runpath, executable, args, self.activate_script)
         name_prefix = self._job_prefix or ""
-        qsub_with_args: list[str] = [
+        return [
             str(self._qsub_cmd),
-            "-rn",  # Don't restart on failure
+            # Don't restart on failure, except for job arrays which PBS
+            # Professional only accepts when they are rerunnable
+            "-ry" if job_array else "-rn",
             f"-N{name_prefix}{name}",  # Set name of job
             *arg_queue_name,
             *arg_project_code,
@@ -208,10 +226,11 @@ async def submit(
                 num_cpu=num_cpu or 1, realization_memory=realization_memory or 0
             ),
         ]
+
+    async def _qsub(self, qsub_with_args: list[str], script: str) -> tuple[bool, str]:
         logger.debug(f"Submitting to PBS with command {shlex.join(qsub_with_args)}")
         logger.debug(f"Submit script passed on stdin: {script}")
-
-        process_success, process_message = await self._execute_with_retry(
+        return await self._execute_with_retry(
             qsub_with_args,
             retry_codes=(
                 QSUB_INVALID_CREDENTIAL,
@@ -223,15 +242,70 @@ async def submit(
             retry_interval=self._sleep_time_between_cmd_retries,
             driverlogger=logger,
         )
+
+    def _add_job(self, iens: int, job_id: str) -> None:
+        self._jobs[job_id] = (iens, QueuedJob())
+        self._iens2jobid[iens] = job_id
+        self._non_finished_job_ids.add(job_id)
+
+    async def _submit_one(self, request: SubmitRequest) -> None:
+        iens = request.iens
+        runpath = request.runpath or Path.cwd()
+        name = request.name or Path(request.executable).name
+
+        script = create_submit_script(
+            runpath, request.executable, request.args, self.activate_script
+        )
+        process_success, process_message = await self._qsub(
+            self._qsub_cmd_with_args(name, request.num_cpu, request.realization_memory),
+            script,
+        )
         if not process_success:
             self._job_error_message_by_iens[iens] = process_message
             raise FailedSubmit(process_message)
 
         job_id_ = process_message
         logger.debug(f"Realization {iens} accepted by PBS, got id {job_id_}")
-        self._jobs[job_id_] = (iens, QueuedJob())
-        self._iens2jobid[iens] = job_id_
-        self._non_finished_job_ids.add(job_id_)
+        self._add_job(iens, job_id_)
+
+    async def _submit_array(
+        self, requests: Sequence[SubmitRequest]
+    ) -> dict[int, FailedSubmit]:
+        """Submit requests, which share program and resources, as one job
+        array with qsub -J. PBS replies with the array id id[].server, and
+        element i is tracked as the subjob id[i].server, which is how qstat -t
+        and qdel refer to subjobs."""
+        first = requests[0]
+        name = first.name or Path(first.executable).name
+        script = create_array_submit_script(
+            "PBS_ARRAY_INDEX", requests, self.activate_script
+        )
+        qsub_with_args = [
+            *self._qsub_cmd_with_args(
+                name, first.num_cpu, first.realization_memory, job_array=True
+            ),
+            "-J",
+            f"0-{len(requests) - 1}",
+        ]
+        process_success, process_message = await self._qsub(qsub_with_args, script)
+        if not process_success or "[]" not in process_message:
+            error_message = (
+                process_message
+                if not process_success
+                else f"Could not understand '{process_message}' from qsub -J"
+            )
+            for request in requests:
+                self._job_error_message_by_iens[request.iens] = error_message
+            return {request.iens: FailedSubmit(error_message) for request in requests}
+
+        array_id = process_message
+        logger.debug(
+            f"Realizations {[request.iens for request in requests]} accepted "
+            f"by PBS as job array {array_id}"
+        )
+        for index, request in enumerate(requests):
+            self._add_job(request.iens, array_id.replace("[]", f"[{index}]", 1))
+        return {}
 
     async def kill(self, iens: int) -> None:
         if iens in self._finished_iens:
@@ -259,7 +333,7 @@ async def kill(self, iens: int) -> None:
     async def poll(self) -> None:
         while True:
             if not self._jobs:
-                await asyncio.sleep(self._poll_period)
+                await self._wait_for_next_poll(0)
                 continue
 
             if self._non_finished_job_ids:
@@ -268,6 +342,7 @@ async def poll(self) -> None:
                         str(self._qstat_cmd),
                         "-Ex",
                         "-w",  # wide format
+                        *self._subjob_args,
                         *self._non_finished_job_ids,
                         stdout=asyncio.subprocess.PIPE,
                         stderr=asyncio.subprocess.PIPE,
@@ -302,6 +377,7 @@ async def poll(self) -> None:
                     str(self._qstat_cmd),
                     "-Efx",
                     "-Fjson",
+                    *self._subjob_args,
                     *self._finished_job_ids,
                     stdout=asyncio.subprocess.PIPE,
                     stderr=asyncio.subprocess.PIPE,
@@ -324,7 +400,12 @@ async def poll(self) -> None:
                 for job_id, job in parsed_jobs_dict.items():
                     await self._process_job_update(job_id, job)
 
-            await asyncio.sleep(self._poll_period)
+            await self._wait_for_next_poll(len(self._jobs))
+
+    @property
+    def _subjob_args(self) -> list[str]:
+        # Subjobs of job arrays are only listed by qstat with -t
+        return ["-t"] if self._job_arrays else []
 
     async def _process_job_update(self, job_id: str, new_state: AnyJob) -> None:
         if job_id not in self._jobs:
@@ -365,6 +446,7 @@ async def _process_job_update(self, job_id: str, new_state: AnyJob) -> None:
             del self._jobs[job_id]
             del self._iens2jobid[iens]
             self._finished_job_ids.remove(job_id)
+            self._job_finished(iens)
 
         if event:
             await self.event_queue.put(event)
@@ -0,0 +1,160 @@
+"""
+Runtime and peak memory usage of the forward model steps, as reported by the
+forward model runner while the realizations run.
+
+With predictive scheduling, the scheduler records the usage of every
+realization it runs and saves it with the ensemble. The usage observed in the
+previous iteration of the experiment is used to submit the realizations that
+are expected to run the longest first, so that they do not end up as a long
+tail at the end of the ensemble, and to book the memory each realization was
+observed to use instead of the global REALIZATION_MEMORY.
+"""
+
+from __future__ import annotations
+
+import logging
+import math
+from dataclasses import dataclass
+from datetime import datetime
+from typing import TYPE_CHECKING, Final
+
+import polars as pl
+
+from _ert.events import (
+    ForwardModelStepFailure,
+    ForwardModelStepRunning,
+    ForwardModelStepStart,
+    ForwardModelStepSuccess,
+)
+
+if TYPE_CHECKING:
+    from ert.storage import Ensemble
+
+logger = logging.getLogger(__name__)
+
+MEMORY_HEADROOM: Final = 1.25
+"""Factor applied to the observed peak memory usage when booking memory"""
+MEMORY_GRANULARITY: Final = 256 * 1024**2
+"""Booked memory is rounded up to a multiple of this, so that realizations
+with similar usage can still be submitted in the same job array"""
+
+ResourceUsageEvent = (
+    ForwardModelStepStart
+    | ForwardModelStepRunning
+    | ForwardModelStepSuccess
+    | ForwardModelStepFailure
+)
+
+
+@dataclass
+class _StepUsage:
+    name: str | None = None
+    start_time: datetime | None = None
+    end_time: datetime | None = None
+    max_memory_usage: int = 0
+
+
+@dataclass(frozen=True)
+class ResourceEstimate:
+    runtime: float
+    """Seconds the forward model of the realization is expected to run"""
+    max_memory_usage: int
+    """Bytes of memory the forward model of the realization is expected to use"""
+
+
+class ResourceUsageRecorder:
+    """Collects the runtime and peak memory usage of each forward model step
+    from the events sent by the forward model runner"""
+
+    def __init__(self) -> None:
+        self._steps: dict[tuple[int, int], _StepUsage] = {}
+
+    def record(self, event: ResourceUsageEvent, name: str | None = None) -> None:
+        key = (int(event.real), int(event.fm_step))
+        step = self._steps.setdefault(key, _StepUsage())
+        if name is not None:
+            step.name = name
+        if type(event) is ForwardModelStepStart:
+            # A resubmitted realization starts its steps over again
+            step.start_time, step.end_time = event.time, None
+            step.max_memory_usage = 0
+        elif type(event) is ForwardModelStepRunning:
+            step.max_memory_usage = max(
+                step.max_memory_usage, event.max_memory_usage or 0
+            )
+        else:
+            step.end_time = event.time
+
+    def to_dataframe(self) -> pl.DataFrame:
+        """The usage of the steps that have run to completion or failure, in
+        the format of Ensemble.save_resource_usage"""
+        rows = [
+            (
+                real,
+                fm_step,
+                step.name,
+                (step.end_time - step.start_time).total_seconds(),
+                step.max_memory_usage,
+            )
+            for (real, fm_step), step in sorted(self._steps.items())
+            if step.start_time is not None and step.end_time is not None
+        ]
+        return pl.DataFrame(
+            rows,
+            schema={
+                "realization": pl.UInt16,
+                "fm_step": pl.UInt16,
+                "name": pl.String,
+                "runtime": pl.Float64,
+                "max_memory_usage": pl.Int64,
+            },
+            orient="row",
+        )
+
+
+def estimate_resource_usage(usage: pl.DataFrame) -> dict[int, ResourceEstimate]:
+    """The expected runtime and peak memory usage of each realization, given
+    the usage of its steps in a previous run"""
+    per_realization = usage.group_by("realization").agg(
+        pl.col("runtime").sum(), pl.col("max_memory_usage").max()
+    )
+    return {
+        real: ResourceEstimate(runtime=runtime, max_memory_usage=max_memory_usage)
+        for real, runtime, max_memory_usage in per_realization.iter_rows()
+    }
+
+
+def load_previous_resource_usage(ensemble: Ensemble) -> pl.DataFrame | None:
+    """The resource usage saved for the latest ensemble of the experiment that
+    was started before the given ensemble"""
+    previous = sorted(
+        (
+            other
+            for other in ensemble.experiment.ensembles
+            if other.started_at < ensemble.started_at
+        ),
+        key=lambda other: other.started_at,
+        reverse=True,
+    )
+    for other in previous:
+        usage = other.load_resource_usage()
+        if usage is not None and not usage.is_empty():
+            logger.info(
+                f"Scheduling ensemble {ensemble.name} from the resource usage "
+                f"of ensemble {other.name}"
+            )
+            return usage
+    return None
+
+
+def booked_memory(max_memory_usage: int, realization_memory: int) -> int:
+    """The memory to book for a realization observed to use max_memory_usage
+    bytes, which is never more than the configured realization_memory. Memory
+    is only booked for realizations that were configured to book memory."""
+    if realization_memory <= 0 or max_memory_usage <= 0:
+        return realization_memory
+    memory = (
+        math.ceil(max_memory_usage * MEMORY_HEADROOM / MEMORY_GRANULARITY)
+        * MEMORY_GRANULARITY
+    )
+    return min(memory, realization_memory)
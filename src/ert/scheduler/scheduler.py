@@ -7,16 +7,22 @@
 import traceback
 from collections import defaultdict
 from collections.abc import Iterable, MutableMapping, Sequence
+from concurrent.futures import ThreadPoolExecutor
 from contextlib import suppress
 from dataclasses import asdict
 from typing import TYPE_CHECKING, Any
 
 import orjson
+import polars as pl
 from pydantic.dataclasses import dataclass
 
 from _ert.events import (
     Event,
     ForwardModelStepChecksum,
+    ForwardModelStepFailure,
+    ForwardModelStepRunning,
+    ForwardModelStepStart,
+    ForwardModelStepSuccess,
     Id,
     RealizationStoppedLongRunning,
     event_from_dict,
@@ -25,6 +31,13 @@
 from .driver import Driver
 from .event import FinishedEvent, StartedEvent
 from .job import Job, JobState
+from .resource_usage import (
+    ResourceUsageEvent,
+    ResourceUsageRecorder,
+    booked_memory,
+    estimate_resource_usage,
+    load_previous_resource_usage,
+)
 
 if TYPE_CHECKING:
     from ert.ensemble_evaluator import Realization
@@ -39,6 +52,7 @@ class _JobsJson:
     dispatch_url: str | None
     ee_token: str | None
     experiment_id: str | None
+    telemetry: str
 
 
 class SubmitSleeper:
@@ -69,9 +83,13 @@ def __init__(
         max_submit: int = 1,
         max_running: int = 1,
         submit_sleep: float = 0.0,
+        internalization_workers: int = 1,
         ens_id: str | None = None,
         ee_uri: str | None = None,
         ee_token: str | None = None,
+        telemetry: str = "FULL",
+        predictive_scheduling: bool = False,
+        compact_jobs_json: bool = False,
     ) -> None:
         self.driver = driver
         self._ensemble_evaluator_queue = ensemble_evaluator_queue
@@ -102,11 +120,19 @@ def __init__(
             )
         self._max_submit = max_submit
         self._max_running = max_running
+        if internalization_workers < 1:
+            raise ValueError("internalization_workers needs to be a positive number")
+        self._internalization_workers = internalization_workers
+        self._internalization_executor: ThreadPoolExecutor | None = None
         self._ee_uri = ee_uri
         self._ens_id = ens_id
         self._ee_token = ee_token
+        self._telemetry = telemetry
+        self._predictive_scheduling = predictive_scheduling
+        self._compact_jobs_json = compact_jobs_json
 
         self.checksum: dict[str, dict[str, Any]] = {}
+        self.resource_usage = ResourceUsageRecorder()
 
     async def kill_all_jobs(self) -> None:
         await self.cancel_all_jobs()
@@ -177,15 +203,99 @@ def count_states(self) -> dict[JobState, int]:
             counts[job.state] += 1
         return counts
 
-    async def _checksum_consumer(self) -> None:
+    async def _dispatch_event_consumer(self) -> None:
         if self._manifest_queue is None:
             return
         while True:
             event = await self._manifest_queue.get()
             if type(event) is ForwardModelStepChecksum:
                 self.checksum.update(event.checksums)
+            elif type(event) in {ForwardModelStepStart, ForwardModelStepRunning}:
+                self._record_resource_usage(event)
+            elif type(event) in {ForwardModelStepSuccess, ForwardModelStepFailure}:
+                self._record_resource_usage(event)
+                self._notify_driver_if_forward_model_finished(event)
             self._manifest_queue.task_done()
 
+    def _record_resource_usage(self, event: ResourceUsageEvent) -> None:
+        if not self._predictive_scheduling:
+            return
+        job = self._jobs.get(int(event.real))
+        if job is None:
+            return
+        fm_step = int(event.fm_step)
+        name = (
+            job.real.fm_steps[fm_step].name
+            if fm_step < len(job.real.fm_steps)
+            else None
+        )
+        self.resource_usage.record(event, name)
+
+    def _save_resource_usage(self) -> None:
+        usage = self.resource_usage.to_dataframe()
+        if usage.is_empty():
+            return
+        ensemble = next(iter(self._jobs.values())).real.run_arg.ensemble_storage
+        try:
+            # Keep the usage of the realizations that were not run this time
+            if (previous := ensemble.load_resource_usage()) is not None:
+                usage = pl.concat(
+                    [
+                        previous.filter(
+                            ~pl.col("realization").is_in(usage["realization"])
+                        ),
+                        usage,
+                    ]
+                ).sort("realization", "fm_step")
+            ensemble.save_resource_usage(usage)
+        except Exception as err:
+            logger.warning(f"Could not save the resource usage of the ensemble: {err}")
+
+    def _submission_order(self) -> list[Job]:
+        """The jobs in the order they are to be submitted.
+
+        With predictive scheduling, the resource usage of the latest ensemble
+        of the experiment is used to submit the realizations that are expected
+        to run the longest first, and to book the memory each realization was
+        observed to use. Realizations without observed usage are expected to
+        run for the average runtime, and book the configured memory.
+        """
+        jobs = list(self._jobs.values())
+        if not self._predictive_scheduling or not jobs:
+            return jobs
+        usage = load_previous_resource_usage(jobs[0].real.run_arg.ensemble_storage)
+        if usage is None:
+            return jobs
+        estimates = estimate_resource_usage(usage)
+        average_runtime = sum(e.runtime for e in estimates.values()) / len(estimates)
+        for job in jobs:
+            if (estimate := estimates.get(job.iens)) is not None:
+                job.real.realization_memory = booked_memory(
+                    estimate.max_memory_usage, job.real.realization_memory
+                )
+        return sorted(
+            jobs,
+            key=lambda job: (
+                estimates[job.iens].runtime
+                if job.iens in estimates
+                else average_runtime
+            ),
+            reverse=True,
+        )
+
+    def _notify_driver_if_forward_model_finished(
+        self, event: ForwardModelStepSuccess | ForwardModelStepFailure
+    ) -> None:
+        """The dispatcher stops at the first failing step, and exits after the
+        last step, so both mean that the job of the realization is exiting"""
+        job = self._jobs.get(int(event.real))
+        if job is None:
+            return
+        if type(event) is ForwardModelStepFailure or int(event.fm_step) == (
+            len(job.real.fm_steps) - 1
+        ):
+            self.driver.notify_finished(job.iens)
+
     async def _publisher(self) -> None:
         if self._ensemble_evaluator_queue is None:
             return
@@ -196,7 +306,12 @@ async def _publisher(self) -> None:
 
     def add_dispatch_information_to_jobs_file(self) -> None:
         for job in self._jobs.values():
-            self._update_jobs_json(job.iens, job.real.run_arg.runpath)
+            # Realizations that are submitted while their runpaths are being
+            # created get theirs added once the runpath is ready, see Job.run
+            if job.real.runpath_ready is not None:
+                continue
+            if error_msg := self._update_jobs_json(job.iens, job.real.run_arg.runpath):
+                job.unschedule(error_msg)
 
     async def _monitor_and_handle_tasks(
         self, scheduling_tasks: list[asyncio.Task[None]]
@@ -250,7 +365,7 @@ async def execute(
             ),
             asyncio.create_task(self.driver.poll(), name="poll_task"),
             asyncio.create_task(
-                self._checksum_consumer(), name="checksum_consumer_task"
+                self._dispatch_event_consumer(), name="dispatch_event_consumer_task"
             ),
         ]
 
@@ -265,17 +380,25 @@ async def execute(
             )
 
         sem = asyncio.BoundedSemaphore(self._max_running or len(self._jobs))
-        # this lock is to assure that no more than 1 task
-        # does internalization at a time
-        forward_model_ok_lock = asyncio.Lock()
+        # Results are internalized by a pool of worker threads, off the event
+        # loop. Jobs wait for a free worker before internalizing, so no more
+        # than internalization_workers realizations are loaded at a time.
+        internalization_slots = asyncio.BoundedSemaphore(
+            self._internalization_workers
+        )
+        self._internalization_executor = ThreadPoolExecutor(
+            max_workers=self._internalization_workers,
+            thread_name_prefix="internalization",
+        )
         verify_checksum_lock = asyncio.Lock()
-        for iens, job in self._jobs.items():
+        for job in self._submission_order():
+            iens = job.iens
             await asyncio.sleep(0)
             if job.state != JobState.ABORTED:
                 self._job_tasks[iens] = asyncio.create_task(
                     job.run(
                         sem,
-                        forward_model_ok_lock,
+                        internalization_slots,
                         verify_checksum_lock,
                         self._max_submit,
                     ),
@@ -307,6 +430,12 @@ async def execute(
                 *scheduling_tasks,
                 return_exceptions=True,
             )
+            # Internalizations that have started are left to finish, so that
+            # nothing is written to storage after the ensemble has run
+            await asyncio.to_thread(
+                self._internalization_executor.shutdown, wait=True, cancel_futures=True
+            )
+            self._save_resource_usage()
 
         if self._cancelled:
             logger.debug("Scheduler has been cancelled, jobs are stopped.")
@@ -332,23 +461,28 @@ async def _process_event_queue(self) -> None:
             ):
                 job.returncode.set_result(event.returncode)
 
-    def _update_jobs_json(self, iens: int, runpath: str) -> None:
+    def _update_jobs_json(self, iens: int, runpath: str) -> str | None:
+        """Add the dispatch information to the jobs.json of a realization,
+        returns the error message if it could not be updated"""
         jobs = _JobsJson(
             experiment_id=None,
             ens_id=self._ens_id,
             real_id=iens,
             dispatch_url=self._ee_uri,
             ee_token=self._ee_token,
+            telemetry=self._telemetry,
         )
         jobs_path = os.path.join(runpath, "jobs.json")
         try:
             with open(jobs_path, "rb") as fp:
-                data = orjson.loads(fp.read())
+                content = fp.read()
+            data = orjson.loads(content)
+            option = 0 if self._compact_jobs_json else orjson.OPT_INDENT_2
             with open(jobs_path, "wb") as fp:
                 data.update(asdict(jobs))
-                fp.write(orjson.dumps(data, option=orjson.OPT_INDENT_2))
+                fp.write(orjson.dumps(data, option=option))
         except OSError as err:
             error_msg = f"Could not update jobs.json: {err}"
-            self._jobs[iens].unschedule(error_msg)
             logger.error(error_msg)
-            return
+            return error_msg
+        return None
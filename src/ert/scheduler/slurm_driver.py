@@ -7,13 +7,22 @@
 import shlex
 import stat
 import time
-from collections.abc import Iterator
+from collections.abc import Iterator, Sequence
+from contextlib import AsyncExitStack
 from dataclasses import dataclass
 from enum import Enum, auto
 from pathlib import Path
 from tempfile import NamedTemporaryFile
 
-from .driver import SIGNAL_OFFSET, Driver, FailedSubmit, create_submit_script
+from .driver import (
+    SIGNAL_OFFSET,
+    Driver,
+    FailedSubmit,
+    SubmitBatcher,
+    SubmitRequest,
+    create_array_submit_script,
+    create_submit_script,
+)
 from .event import Event, FinishedEvent, StartedEvent
 
 SLURM_FAILED_EXIT_CODE_FETCH = SIGNAL_OFFSET + 66
@@ -72,8 +81,11 @@ def __init__(
         squeue_timeout: float = 2,
         project_code: str | None = None,
         activate_script: str = "",
+        job_arrays: bool = False,
     ) -> None:
         super().__init__(activate_script)
+        self._job_arrays = job_arrays
+        self._submit_batcher = SubmitBatcher(self.submit_many, self.kill)
         self._submit_locks: dict[int, asyncio.Lock] = {}
         self._iens2jobid: dict[int, str] = {}
         self._jobs: dict[str, JobData] = {}
@@ -110,15 +122,23 @@ def _submit_cmd(
         runpath: Path | None = None,
         num_cpu: int | None = 1,
         realization_memory: int | None = 0,
+        array_size: int | None = None,
     ) -> list[str]:
         sbatch_with_args = [
             str(self._sbatch),
             f"--job-name={name}",
             f"--chdir={runpath}",
             "--parsable",
-            f"--output={name}.stdout",
-            f"--error={name}.stderr",
         ]
+        if array_size is None:
+            sbatch_with_args += [f"--output={name}.stdout", f"--error={name}.stderr"]
+        else:
+            # Elements redirect their output into their own runpath
+            sbatch_with_args += [
+                "--output=/dev/null",
+                "--error=/dev/null",
+                f"--array=0-{array_size - 1}",
+            ]
         if num_cpu:
             sbatch_with_args.append(f"--ntasks={num_cpu}")
         if realization_memory and realization_memory > 0:
@@ -150,10 +170,19 @@ async def submit(
         num_cpu: int | None = 1,
         realization_memory: int | None = 0,
     ) -> None:
-        if runpath is None:
-            runpath = Path.cwd()
-        if name is None:
-            name = Path(executable).name
+        request = SubmitRequest(
+            iens, executable, args, name, runpath, num_cpu, realization_memory
+        )
+        if self._job_arrays:
+            await self._submit_batcher.submit(request)
+        else:
+            await self._submit_one(request)
+
+    async def _submit_one(self, request: SubmitRequest) -> None:
+        iens, executable, args = request.iens, request.executable, request.args
+        num_cpu, realization_memory = request.num_cpu, request.realization_memory
+        runpath = request.runpath or Path.cwd()
+        name = request.name or Path(executable).name
 
         script = create_submit_script(runpath, executable, args, self.activate_script)
         script_path: Path | None = None
@@ -207,6 +236,83 @@ async def submit(
             )
             self._iens2jobid[iens] = job_id
 
+    async def _submit_array(
+        self, requests: Sequence[SubmitRequest]
+    ) -> dict[int, FailedSubmit]:
+        """Submit requests, which share program and resources, as one job
+        array. Element i of array id is tracked as the job id_i, which is how
+        squeue -r, scontrol, sacct and scancel refer to array elements."""
+        first = requests[0]
+        runpath = first.runpath or Path.cwd()
+        names = [
+            request.name or Path(request.executable).name for request in requests
+        ]
+        script = create_array_submit_script(
+            "SLURM_ARRAY_TASK_ID",
+            requests,
+            self.activate_script,
+            [(f"{name}.stdout", f"{name}.stderr") for name in names],
+        )
+        try:
+            with NamedTemporaryFile(
+                dir=runpath,
+                prefix=".slurm_submit_array_",
+                suffix=".sh",
+                mode="w",
+                encoding="utf-8",
+                delete=False,
+            ) as script_handle:
+                script_handle.write(script)
+                script_path = Path(script_handle.name)
+        except OSError as err:
+            error_message = f"Could not create submit script: {err}"
+            for request in requests:
+                self._job_error_message_by_iens[request.iens] = error_message
+            return {request.iens: FailedSubmit(error_message) for request in requests}
+        script_path.chmod(script_path.stat().st_mode | stat.S_IEXEC)
+        sbatch_with_args = [
+            *self._submit_cmd(
+                names[0],
+                runpath,
+                first.num_cpu,
+                first.realization_memory,
+                array_size=len(requests),
+            ),
+            str(script_path),
+        ]
+
+        async with AsyncExitStack() as locks:
+            for request in requests:
+                lock = self._submit_locks.setdefault(request.iens, asyncio.Lock())
+                await locks.enter_async_context(lock)
+            logger.debug(
+                f"Submitting array to SLURM with command {shlex.join(sbatch_with_args)}"
+            )
+            process_success, process_message = await self._execute_with_retry(
+                sbatch_with_args,
+                retry_on_empty_stdout=True,
+                retry_codes=(),
+                total_attempts=self._max_sbatch_attempts,
+                retry_interval=self._sleep_time_between_cmd_retries,
+            )
+            if not process_success or not process_message:
+                error_message = process_message or "sbatch returned empty jobid"
+                for request in requests:
+                    self._job_error_message_by_iens[request.iens] = error_message
+                return {
+                    request.iens: FailedSubmit(error_message) for request in requests
+                }
+            array_id = process_message
+            logger.info(
+                f"Realizations {[request.iens for request in requests]} accepted "
+                f"by SLURM as job array {array_id}"
+            )
+            for index, request in enumerate(requests):
+                job_id = f"{array_id}_{index}"
+                self._jobs[job_id] = JobData(iens=request.iens)
+                self._iens2jobid[request.iens] = job_id
+        return {}
+
     async def kill(self, iens: int) -> None:
         if iens not in self._submit_locks:
             logger.error(f"scancel failed, realization {iens} has never been submitted")
@@ -232,9 +338,10 @@ async def kill(self, iens: int) -> None:
     async def poll(self) -> None:
         while True:
             if not self._jobs.keys():
-                await asyncio.sleep(self._poll_period)
+                await self._wait_for_next_poll(0)
                 continue
-            arguments = ["-h", "--format=%i %T"]
+            # -r lists pending array elements one by one, with their own ids
+            arguments = ["-h", "-r", "--format=%i %T"]
             if self._user:
                 arguments.append(f"--user={self._user}")
             try:
@@ -284,7 +391,7 @@ async def poll(self) -> None:
                 logger.debug(
                     f"scontrol did not give status for job_ids {missing_in_squeue_and_scontrol}, giving up for now."
                 )
-            await asyncio.sleep(self._poll_period)
+            await self._wait_for_next_poll(len(self._jobs))
 
     async def _process_job_update(self, job_id: str, new_info: JobInfo) -> None:
         new_state = new_info.status
@@ -319,6 +426,7 @@ async def _process_job_update(self, job_id: str, new_info: JobInfo) -> None:
             if isinstance(event, FinishedEvent):
                 del self._jobs[job_id]
                 del self._iens2jobid[iens]
+                self._job_finished(iens)
             await self.event_queue.put(event)
 
     async def _get_exit_code(self, job_id: str) -> int:
@@ -0,0 +1,281 @@
+from __future__ import annotations
+
+import logging
+import os
+import shutil
+import threading
+import time
+from enum import StrEnum
+from pathlib import Path
+from tempfile import mkdtemp
+from typing import TYPE_CHECKING, Any
+
+import numpy as np
+import xarray as xr
+from pydantic import BaseModel
+
+if TYPE_CHECKING:
+    import numpy.typing as npt
+
+logger = logging.getLogger(__name__)
+
+
+class ParameterLayout(StrEnum):
+    """How the parameters of an ensemble are laid out on disk.
+
+    REALIZATION stores one NetCDF file per realization and parameter group,
+    ENSEMBLE stores one (realization, parameter) array per parameter group
+    for the whole ensemble, see :class:`EnsembleParameterStore`.
+    """
+
+    REALIZATION = "realization"
+    ENSEMBLE = "ensemble"
+
+
+class _VariableSchema(BaseModel):
+    dims: list[str]
+    shape: list[int]
+    dtype: str
+
+
+class _CoordinateSchema(BaseModel):
+    dims: list[str]
+    values: list[Any]
+
+
+class _GroupSchema(BaseModel):
+    data_vars: dict[str, _VariableSchema]
+    coords: dict[str, _CoordinateSchema]
+    attrs: dict[str, Any]
+
+
+class EnsembleParameterStore:
+    """
+    Ensemble-wide storage of parameter groups.
+
+    Every data variable of a parameter group is stored as one uncompressed
+    ``.npy`` array of shape (ensemble_size, \\*variable_shape), so that the
+    values of one realization form a single contiguous chunk. Loading a group
+    for the whole ensemble becomes one contiguous read of a memory-mapped file,
+    while loading a single realization only touches its own chunk.
+
+    The layout of a group is fixed by the first dataset saved to it, and is
+    kept in ``schema.json`` next to the arrays. Which realizations have been
+    written is tracked in ``realizations.npy``. That mask is only set after the
+    values of the realization have been flushed, and is cleared before the
+    values of a saved realization are overwritten, so a write that is
+    interrupted leaves the realization without parameters rather than with
+    partial ones.
+
+    The arrays are written in place, so the modification time of the directory
+    of a group is updated after every realization that is saved, for readers
+    that tell changes to the ensemble by the modification times of its
+    directories.
+    """
+
+    SCHEMA_FILE = "schema.json"
+    REALIZATIONS_FILE = "realizations.npy"
+
+    def __init__(self, path: Path, ensemble_size: int, swap_path: Path) -> None:
+        self._path = path
+        self._ensemble_size = ensemble_size
+        self._swap_path = swap_path
+        self._schemas: dict[str, _GroupSchema] = {}
+        self._masks: dict[str, npt.NDArray[np.bool_]] = {}
+        self._lock = threading.Lock()
+
+    @staticmethod
+    def supports(dataset: xr.Dataset) -> bool:
+        """Only numeric datasets can be memory-mapped, anything else (e.g.
+        design matrices with string values) is kept per realization."""
+        return all(
+            np.issubdtype(dataset[name].dtype, np.number) for name in dataset.data_vars
+        )
+
+    def _group_path(self, group: str) -> Path:
+        return self._path / _escape_filename(group)
+
+    def _schema(self, group: str) -> _GroupSchema | None:
+        if group not in self._schemas:
+            try:
+                self._schemas[group] = _GroupSchema.model_validate_json(
+                    (self._group_path(group) / self.SCHEMA_FILE).read_text(
+                        encoding="utf-8"
+                    )
+                )
+            except FileNotFoundError:
+                return None
+        return self._schemas[group]
+
+    def has_group(self, group: str) -> bool:
+        return self._schema(group) is not None
+
+    def realization_mask(self, group: str) -> npt.NDArray[np.bool_]:
+        """Boolean mask of the realizations that have been saved for group"""
+        if not self.has_group(group):
+            return np.zeros(self._ensemble_size, dtype=np.bool_)
+        mask = np.load(self._group_path(group) / self.REALIZATIONS_FILE)
+        self._masks[group] = mask
+        return mask.copy()
+
+    def has_realization(self, group: str, realization: int) -> bool:
+        if not self.has_group(group):
+            return False
+        # Realizations are only cleared while they are being overwritten, so
+        # a saved realization in the cached mask is only reread on a miss,
+        # which may have been saved by another process since.
+        mask = self._masks.get(group)
+        if mask is None or not mask[realization]:
+            mask = np.load(self._group_path(group) / self.REALIZATIONS_FILE)
+            self._masks[group] = mask
+        return bool(mask[realization])
+
+    def _set_saved(self, group: str, realization: int, value: bool) -> None:
+        with self._lock:
+            saved = np.load(
+                self._group_path(group) / self.REALIZATIONS_FILE, mmap_mode="r+"
+            )
+            saved[realization] = value
+            saved.flush()
+            self._masks[group] = np.array(saved)
+            del saved
+
+    def _create_group(self, group: str, dataset: xr.Dataset) -> _GroupSchema:
+        schema = _GroupSchema(
+            data_vars={
+                str(name): _VariableSchema(
+                    dims=[str(d) for d in var.dims],
+                    shape=list(var.shape),
+                    dtype=var.dtype.str,
+                )
+                for name, var in dataset.data_vars.items()
+            },
+            coords={
+                str(name): _CoordinateSchema(
+                    dims=[str(d) for d in coord.dims],
+                    values=coord.values.tolist(),
+                )
+                for name, coord in dataset.coords.items()
+            },
+            attrs=dict(dataset.attrs),
+        )
+
+        # The group is built in the swap directory and moved into place in one
+        # rename, so readers never observe a group with missing arrays.
+        self._swap_path.mkdir(parents=True, exist_ok=True)
+        tmp_dir = Path(mkdtemp(dir=self._swap_path))
+        try:
+            for name, var in schema.data_vars.items():
+                np.lib.format.open_memmap(
+                    tmp_dir / f"{_escape_filename(name)}.npy",
+                    mode="w+",
+                    dtype=np.dtype(var.dtype),
+                    shape=(self._ensemble_size, *var.shape),
+                ).flush()
+            np.save(
+                tmp_dir / self.REALIZATIONS_FILE,
+                np.zeros(self._ensemble_size, dtype=np.bool_),
+            )
+            (tmp_dir / self.SCHEMA_FILE).write_text(
+                schema.model_dump_json(indent=2), encoding="utf-8"
+            )
+            for file in tmp_dir.iterdir():
+                os.chmod(file, 0o660)
+            os.chmod(tmp_dir, 0o770)
+            self._path.mkdir(parents=True, exist_ok=True)
+            os.rename(tmp_dir, self._group_path(group))
+        except Exception:
+            shutil.rmtree(tmp_dir, ignore_errors=True)
+            raise
+        logger.debug(f"Created ensemble parameter store for {group}")
+        return schema
+
+    def save(self, group: str, realization: int, dataset: xr.Dataset) -> None:
+        """Save the dataset of a single realization, the dataset must not have a
+        realizations dimension."""
+        with self._lock:
+            schema = self._schema(group)
+            if schema is None:
+                schema = self._schemas[group] = self._create_group(group, dataset)
+
+        if set(schema.data_vars) != {str(name) for name in dataset.data_vars}:
+            raise ValueError(
+                f"Parameters for {group} in realization {realization} have variables "
+                f"{sorted(map(str, dataset.data_vars))}, expected "
+                f"{sorted(schema.data_vars)}"
+            )
+        for name, var in schema.data_vars.items():
+            if list(dataset[name].shape) != var.shape:
+                raise ValueError(
+                    f"Parameters {group}/{name} in realization {realization} have "
+                    f"shape {dataset[name].shape}, expected {tuple(var.shape)}"
+                )
+
+        if self.has_realization(group, realization):
+            self._set_saved(group, realization, False)
+
+        group_path = self._group_path(group)
+        for name in schema.data_vars:
+            values = np.load(group_path / f"{_escape_filename(name)}.npy", mmap_mode="r+")
+            values[realization] = dataset[name].values
+            values.flush()
+            del values
+
+        self._set_saved(group, realization, True)
+        _touch(group_path)
+
+    def load(
+        self, group: str, realizations: npt.NDArray[np.int_] | None
+    ) -> xr.Dataset:
+        """Load group for the given realizations, or all saved realizations if
+        None, into a dataset with a leading realizations dimension.
+
+        When the requested realizations are a contiguous range, the variables
+        are lazily read views into the memory-mapped arrays."""
+        schema = self._schema(group)
+        if schema is None:
+            raise KeyError(f"No dataset '{group}' in storage")
+
+        saved = self.realization_mask(group)
+        if realizations is None:
+            realizations = np.flatnonzero(saved)
+        realizations = np.asarray(realizations, dtype=np.int_)
+        if missing := [int(r) for r in realizations if not saved[r]]:
+            raise KeyError(
+                f"No dataset '{group}' in storage for realization {missing[0]}"
+            )
+
+        if len(realizations) == 0:
+            index: slice | npt.NDArray[np.int_] = realizations
+        elif np.all(np.diff(realizations) == 1):
+            index = slice(int(realizations[0]), int(realizations[-1]) + 1)
+        else:
+            index = realizations
+
+        group_path = self._group_path(group)
+        data_vars = {
+            name: (
+                ["realizations", *var.dims],
+                np.load(group_path / f"{_escape_filename(name)}.npy", mmap_mode="r")[
+                    index
+                ],
+            )
+            for name, var in schema.data_vars.items()
+        }
+        coords: dict[str, Any] = {
+            name: (coord.dims, np.asarray(coord.values))
+            for name, coord in schema.coords.items()
+        }
+        coords["realizations"] = realizations
+        return xr.Dataset(data_vars, coords=coords, attrs=schema.attrs)
+
+
+def _touch(path: Path) -> None:
+    """Update the modification time of path, always past its previous one even
+    when the clock has not advanced since"""
+    mtime = max(time.time_ns(), os.stat(path).st_mtime_ns + 1)
+    os.utime(path, ns=(mtime, mtime))
+
+
+def _escape_filename(filename: str) -> str:
+    return filename.replace("%", "%25").replace("/", "%2F")
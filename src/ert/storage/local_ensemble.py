@@ -3,11 +3,11 @@
 import contextlib
 import logging
 import os
-from collections.abc import Iterable
+from collections.abc import Iterable, Iterator, Sequence
 from datetime import datetime
-from functools import cache, lru_cache
+from functools import cache
 from pathlib import Path
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Any
 from uuid import UUID
 
 import numpy as np
@@ -17,9 +17,15 @@
 from pydantic import BaseModel
 from typing_extensions import TypedDict
 
-from ert.config import GenKwConfig
+from ert.config import Field, GenKwConfig
 from ert.storage.mode import BaseMode, Mode, require_write
+from ert.trace import trace, tracer
 
+from .ensemble_parameter_store import (
+    EnsembleParameterStore,
+    ParameterLayout,
+    _escape_filename,
+)
 from .realization_storage_state import RealizationStorageState
 
 if TYPE_CHECKING:
@@ -30,6 +36,15 @@
 
 logger = logging.getLogger(__name__)
 
+# Number of realizations whose responses are aligned with the
+# observations at a time in get_observations_and_responses
+OBSERVATION_RESPONSE_CHUNK_SIZE = 100
+
+# Responses are saved sorted by response key in row groups of this many rows,
+# so that the statistics of the row groups lets the responses of a single key
+# be read without reading the whole file
+RESPONSE_ROW_GROUP_SIZE = 16384
+
 
 class EverestRealizationInfo(TypedDict):
     model_realization: int
@@ -45,6 +60,7 @@ class _Index(BaseModel):
     prior_ensemble_id: UUID | None
     started_at: datetime
     everest_realization_info: dict[int, EverestRealizationInfo] | None = None
+    parameter_layout: ParameterLayout = ParameterLayout.REALIZATION
 
 
 class _Failure(BaseModel):
@@ -53,8 +69,13 @@ class _Failure(BaseModel):
     time: datetime
 
 
-def _escape_filename(filename: str) -> str:
-    return filename.replace("%", "%25").replace("/", "%2F")
+class _EnsembleState(BaseModel):
+    """The realizations each parameter group and response type has been saved
+    for, and the realizations that have failed"""
+
+    parameters: dict[str, set[int]] = {}
+    responses: dict[str, set[int]] = {}
+    failures: dict[int, RealizationStorageState] = {}
 
 
 class LocalEnsemble(BaseMode):
@@ -91,12 +112,18 @@ def __init__(
             (path / "index.json").read_text(encoding="utf-8")
         )
         self._error_log_name = "error.json"
+        self._state_file_name = "state.json"
 
         @cache
         def create_realization_dir(realization: int) -> Path:
             return self._path / f"realization-{realization}"
 
         self._realization_dir = create_realization_dir
+        self._parameter_store = EnsembleParameterStore(
+            self._path / "parameters",
+            self.ensemble_size,
+            storage._swap_path,
+        )
 
     @classmethod
     def create(
@@ -110,6 +137,7 @@ def create(
         iteration: int = 0,
         name: str,
         prior_ensemble_id: UUID | None,
+        parameter_layout: ParameterLayout = ParameterLayout.REALIZATION,
     ) -> LocalEnsemble:
         """
         Create a new ensemble in local storage.
@@ -132,6 +160,8 @@ def create(
             Name of ensemble.
         prior_ensemble_id : UUID, optional
             Identifier of prior ensemble.
+        parameter_layout : ParameterLayout
+            Whether parameters are stored per realization or per ensemble.
 
         Returns
         -------
@@ -149,11 +179,15 @@ def create(
             name=name,
             prior_ensemble_id=prior_ensemble_id,
             started_at=datetime.now(),
+            parameter_layout=parameter_layout,
         )
 
         storage._write_transaction(
             path / "index.json", index.model_dump_json(indent=2).encode("utf-8")
         )
+        storage._write_transaction(
+            path / "state.json", _EnsembleState().model_dump_json().encode("utf-8")
+        )
 
         return cls(storage, path, Mode.WRITE)
 
@@ -189,6 +223,10 @@ def iteration(self) -> int:
     def parent(self) -> UUID | None:
         return self._index.prior_ensemble_id
 
+    @property
+    def parameter_layout(self) -> ParameterLayout:
+        return self._index.parameter_layout
+
     @property
     def experiment(self) -> LocalExperiment:
         return self._storage.get_experiment(self.experiment_id)
@@ -277,10 +315,7 @@ def is_initalized(self) -> list[int]:
             i
             for i in range(self.ensemble_size)
             if all(
-                (
-                    self._realization_dir(i)
-                    / (_escape_filename(parameter.name) + ".nc")
-                ).exists()
+                self._has_parameter_group(i, parameter.name)
                 for parameter in self.experiment.parameter_configuration.values()
                 if not parameter.forward_init
             )
@@ -346,6 +381,8 @@ def set_failure(
         self._storage._write_transaction(
             filename, error.model_dump_json(indent=2).encode("utf-8")
         )
+        with self._update_state() as state:
+            state.failures[realization] = failure_type
 
     def unset_failure(
         self,
@@ -354,6 +391,9 @@ def unset_failure(
         filename: Path = self._realization_dir(realization) / self._error_log_name
         if filename.exists():
             filename.unlink()
+        if realization in self._state().failures:
+            with self._update_state() as state:
+                del state.failures[realization]
 
     def has_failure(self, realization: int) -> bool:
         """
@@ -370,7 +410,7 @@ def has_failure(self, realization: int) -> bool:
             True if realization has a recorded failure.
         """
 
-        return (self._realization_dir(realization) / self._error_log_name).exists()
+        return realization in self._state().failures
 
     def get_failure(self, realization: int) -> _Failure | None:
         """
@@ -396,10 +436,17 @@ def get_failure(self, realization: int) -> _Failure | None:
         return None
 
     def refresh_ensemble_state(self) -> None:
-        self.get_ensemble_state.cache_clear()
-        self.get_ensemble_state()
+        """
+        Reload the state of the realizations from storage, so that the state
+        saved by the process that writes to the ensemble is seen. The state
+        of ensembles opened for writing is always up to date.
+        """
+        if self.can_write:
+            return
+        with self._storage._ensemble_state_lock(self.id):
+            self._storage._ensemble_states.pop(self.id, None)
+        self._state()
 
-    @lru_cache  # noqa: B019
     def get_ensemble_state(self) -> list[set[RealizationStorageState]]:
         """
         Retrieve the state of each realization within ensemble.
@@ -410,91 +457,27 @@ def get_ensemble_state(self) -> list[set[RealizationStorageState]]:
             list of realization states.
         """
 
-        response_configs = self.experiment.response_configuration
-
-        def _parameters_exist_for_realization(realization: int) -> bool:
-            """
-            Returns true if all parameters in the experiment have
-            all been saved in the ensemble. If no parameters, return True
-
-            Parameters
-            ----------
-            realization : int
-                Realization index.
-
-            Returns
-            -------
-            exists : bool
-                True if parameters exist for realization.
-            """
-            if not self.experiment.parameter_configuration:
-                return True
-            path = self._realization_dir(realization)
-            return all(
-                (path / (_escape_filename(parameter) + ".nc")).exists()
-                for parameter in self.experiment.parameter_configuration
-            )
-
-        def _responses_exist_for_realization(
-            realization: int, key: str | None = None
-        ) -> bool:
-            """
-            Returns true if there are responses in the experiment and they have
-            all been saved in the ensemble
-
-            Parameters
-            ----------
-            realization : int
-                Realization index.
-            key : str, optional
-                Response key to filter realizations. If None, all responses are considered.
-
-            Returns
-            -------
-            exists : bool
-                True if responses exist for realization.
-            """
-
-            if not response_configs:
-                return True
-            path = self._realization_dir(realization)
-
-            def _has_response(key_: str) -> bool:
-                if key_ in self.experiment.response_key_to_response_type:
-                    response_type = self.experiment.response_key_to_response_type[key_]
-                    return (path / f"{response_type}.parquet").exists()
-
-                return (path / f"{key_}.parquet").exists()
-
-            if key:
-                return _has_response(key)
-
-            is_expecting_any_responses = any(
-                bool(config.keys) for config in response_configs.values()
-            )
-
-            if not is_expecting_any_responses:
-                return True
-
-            non_empty_response_configs = [
-                response
-                for response, config in response_configs.items()
-                if bool(config.keys)
-            ]
-
-            return all(
-                _has_response(response) for response in non_empty_response_configs
-            )
+        saved = self._state()
+        parameters = list(self.experiment.parameter_configuration)
+        expected_responses = [
+            response_type
+            for response_type, config in self.experiment.response_configuration.items()
+            if config.keys
+        ]
 
         def _find_state(realization: int) -> set[RealizationStorageState]:
             state = set()
-            if self.has_failure(realization):
-                failure = self.get_failure(realization)
-                assert failure
-                state.add(failure.type)
-            if _responses_exist_for_realization(realization):
+            if realization in saved.failures:
+                state.add(saved.failures[realization])
+            if all(
+                realization in saved.responses.get(response_type, ())
+                for response_type in expected_responses
+            ):
                 state.add(RealizationStorageState.RESPONSES_LOADED)
-            if _parameters_exist_for_realization(realization):
+            if all(
+                realization in saved.parameters.get(parameter, ())
+                for parameter in parameters
+            ):
                 state.add(RealizationStorageState.PARAMETERS_LOADED)
 
             if len(state) == 0:
@@ -504,6 +487,80 @@ def _find_state(realization: int) -> set[RealizationStorageState]:
 
         return [_find_state(i) for i in range(self.ensemble_size)]
 
+    def _state(self) -> _EnsembleState:
+        """
+        The saved state of the realizations, which is kept in memory by the
+        storage and in the ensemble state file, so that the state of an
+        ensemble is known without probing the files of every realization.
+        """
+        states = self._storage._ensemble_states
+        with self._storage._ensemble_state_lock(self.id):
+            if self.id not in states:
+                states[self.id] = self._load_state()
+            return states[self.id]
+
+    @contextlib.contextmanager
+    def _update_state(self) -> Iterator[_EnsembleState]:
+        """Update the saved state and write it to the ensemble state file, or
+        within LocalStorage.write_behind_context, when the context exits"""
+        with self._storage._ensemble_state_lock(self.id):
+            state = self._state()
+            yield state
+            if self._storage._defers_ensemble_states:
+                self._storage._defer_ensemble_state(self)
+            else:
+                self._save_state()
+
+    def _save_state(self) -> None:
+        with self._storage._ensemble_state_lock(self.id):
+            self._storage._ordered_write_transaction(
+                self._path / self._state_file_name,
+                self._state().model_dump_json().encode("utf-8"),
+            )
+
+    def _remove_state_file(self) -> None:
+        (self._path / self._state_file_name).unlink(missing_ok=True)
+
+    def _load_state(self) -> _EnsembleState:
+        try:
+            return _EnsembleState.model_validate_json(
+                (self._path / self._state_file_name).read_text(encoding="utf-8")
+            )
+        except FileNotFoundError:
+            pass
+        # Ensembles saved before the state file was introduced
+        state = self._probe_state()
+        if self.can_write:
+            self._storage._write_transaction(
+                self._path / self._state_file_name,
+                state.model_dump_json().encode("utf-8"),
+            )
+        return state
+
+    def _probe_state(self) -> _EnsembleState:
+        """The state of the realizations from the files saved for each of them"""
+        state = _EnsembleState()
+        for realization in range(self.ensemble_size):
+            path = self._realization_dir(realization)
+            for group in self.experiment.parameter_configuration:
+                if (
+                    self.parameter_layout == ParameterLayout.ENSEMBLE
+                    and self._parameter_store.has_realization(group, realization)
+                ) or (path / (_escape_filename(group) + ".nc")).exists():
+                    state.parameters.setdefault(group, set()).add(realization)
+            for response_type in self.experiment.response_configuration:
+                if (path / f"{response_type}.parquet").exists():
+                    state.responses.setdefault(response_type, set()).add(realization)
+            if (path / self._error_log_name).exists():
+                failure = _Failure.model_validate_json(
+                    (path / self._error_log_name).read_text(encoding="utf-8")
+                )
+                state.failures[realization] = failure.type
+        return state
+
+    def _has_parameter_group(self, realization: int, group: str) -> bool:
+        return realization in self._state().parameters.get(group, ())
+
     def _load_single_dataset(
         self,
         group: str,
@@ -526,6 +583,16 @@ def _load_dataset(
         group: str,
         realizations: int | np.int64 | npt.NDArray[np.int_] | None,
     ) -> xr.Dataset:
+        if (
+            self.parameter_layout == ParameterLayout.ENSEMBLE
+            and self._parameter_store.has_group(group)
+        ):
+            if isinstance(realizations, int | np.int64):
+                return self._parameter_store.load(
+                    group, np.array([realizations])
+                ).isel(realizations=0, drop=True)
+            return self._parameter_store.load(group, realizations)
+
         if isinstance(realizations, int | np.int64):
             return self._load_single_dataset(group, int(realizations)).isel(
                 realizations=0, drop=True
@@ -574,6 +641,80 @@ def load_cross_correlations(self) -> xr.Dataset:
         logger.info("Loading cross correlations")
         return xr.open_dataset(input_path, engine="scipy")
 
+    @require_write
+    def save_sparse_cross_correlations(
+        self, param_group: str, batch: int, cross_correlations: pl.DataFrame
+    ) -> None:
+        """
+        Save the thresholded cross-correlations of one batch of parameters.
+
+        Each batch is written as its own parquet file under
+        ``cross_correlations/<param_group>``, so correlations can be written
+        incrementally while the update is running.
+
+        Parameters
+        ----------
+        param_group : str
+            Name of the parameter group.
+        batch : int
+            Index of the parameter batch.
+        cross_correlations : DataFrame
+            polars DataFrame with one row per significant correlation, see
+            load_sparse_cross_correlations for the columns.
+        """
+        path = self.mount_point / "cross_correlations" / _escape_filename(param_group)
+        path.mkdir(parents=True, exist_ok=True)
+        self._storage._to_parquet_transaction(
+            path / f"batch-{batch:05d}.parquet", cross_correlations
+        )
+
+    def load_sparse_cross_correlations(
+        self,
+        param_group: str,
+        *,
+        parameters: Iterable[str | int] | None = None,
+        observations: Iterable[str] | None = None,
+    ) -> pl.DataFrame:
+        """
+        Load the cross-correlations above the localization threshold, written
+        by the update when STREAMING_LOCALIZATION is enabled.
+
+        Parameters
+        ----------
+        param_group : str
+            Name of the parameter group.
+        parameters : iterable of str or int, optional
+            Only load correlations of these parameters, given by name or by
+            index into the parameter group.
+        observations : iterable of str, optional
+            Only load correlations with these observation keys.
+
+        Returns
+        -------
+        cross_correlations : DataFrame
+            polars DataFrame with the columns parameter_index, parameter,
+            observation_key, index and correlation.
+        """
+        path = self.mount_point / "cross_correlations" / _escape_filename(param_group)
+        if not path.exists():
+            raise FileNotFoundError(
+                f"No cross-correlation data for {param_group} available at "
+                f"'{path}'. Make sure to run the update with Adaptive "
+                "Localization and STREAMING_LOCALIZATION enabled."
+            )
+        df = pl.scan_parquet(path / "batch-*.parquet")
+        if parameters is not None:
+            parameters = list(parameters)
+            names = [p for p in parameters if isinstance(p, str)]
+            indices = [p for p in parameters if isinstance(p, int)]
+            df = df.filter(
+                pl.col("parameter").is_in(names)
+                | pl.col("parameter_index").is_in(indices)
+            )
+        if observations is not None:
+            df = df.filter(pl.col("observation_key").is_in(list(observations)))
+        return df.collect()
+
     @require_write
     def save_observation_scaling_factors(self, dataset: pl.DataFrame) -> None:
         self._storage._to_parquet_transaction(
@@ -589,6 +730,30 @@ def load_observation_scaling_factors(
 
         return None
 
+    @require_write
+    def save_resource_usage(self, usage: pl.DataFrame) -> None:
+        """Save the runtime and peak memory usage of the forward model steps
+        of each realization, with one row per realization and step.
+
+        Parameters
+        ----------
+        usage : DataFrame
+            The columns realization, fm_step, name, runtime (seconds) and
+            max_memory_usage (bytes).
+        """
+        self._storage._to_parquet_transaction(
+            self.mount_point / "resource_usage.parquet", usage
+        )
+
+    def load_resource_usage(self) -> pl.DataFrame | None:
+        """Load the resource usage saved by save_resource_usage, or None if
+        the ensemble has not been run"""
+        usage_path = self.mount_point / "resource_usage.parquet"
+        if usage_path.exists():
+            return pl.read_parquet(usage_path)
+
+        return None
+
     @require_write
     def save_cross_correlations(
         self,
@@ -607,7 +772,41 @@ def save_cross_correlations(
         file_path = os.path.join(self.mount_point, "corr_XY.nc")
         self._storage._to_netcdf_transaction(file_path, dataset)
 
-    def load_responses(self, key: str, realizations: tuple[int, ...]) -> pl.DataFrame:
+    @require_write
+    def save_update_cache(self, key: str, arrays: dict[str, npt.NDArray[Any]]) -> None:
+        """
+        Save the intermediate results of the update into this ensemble, so
+        that a later update with the same key can reuse them.
+
+        Parameters
+        ----------
+        key : str
+            Key identifying the inputs of the update.
+        arrays : dict of str to ndarray
+            Arrays to cache, must not be object arrays.
+        """
+        path = self.mount_point / "update_cache"
+        path.mkdir(exist_ok=True)
+        self._storage._to_npz_transaction(path / f"{key}.npz", arrays)
+
+    def load_update_cache(self, key: str) -> dict[str, npt.NDArray[Any]] | None:
+        """
+        Load the arrays saved with save_update_cache, or None if there is no
+        cache for key in this ensemble.
+        """
+        path = self.mount_point / "update_cache" / f"{key}.npz"
+        try:
+            with np.load(path, allow_pickle=False) as npz:
+                return {name: npz[name] for name in npz.files}
+        except FileNotFoundError:
+            return None
+
+    def load_responses(
+        self,
+        key: str,
+        realizations: tuple[int, ...],
+        columns: Sequence[str] | None = None,
+    ) -> pl.DataFrame:
         """Load responses for key and realizations into xarray Dataset.
 
         For each given realization, response data is loaded from the NetCDF
@@ -619,6 +818,8 @@ def load_responses(self, key: str, realizations: tuple[int, ...]) -> pl.DataFram
             Response key to load.
         realizations : tuple of int
             Realization indices to load.
+        columns : sequence of str, optional
+            Only read these columns, all columns are read if None.
 
         Returns
         -------
@@ -626,7 +827,10 @@ def load_responses(self, key: str, realizations: tuple[int, ...]) -> pl.DataFram
             Loaded polars DataFrame with responses.
         """
 
-        return self._load_responses_lazy(key, realizations).collect()
+        responses = self._load_responses_lazy(key, realizations)
+        if columns is not None and realizations:
+            responses = responses.select(columns)
+        return responses.collect()
 
     def _load_responses_lazy(
         self, key: str, realizations: tuple[int, ...]
@@ -721,9 +925,16 @@ def load_all_gen_kw_data(
                 da["names"] = np.char.add(f"{key.name}:", da["names"].astype(np.str_))
                 df = da.to_dataframe().unstack(level="names")
                 df.columns = df.columns.droplevel()
-                for parameter in df.columns:
-                    if key.shouldUseLogScale(parameter.split(":")[1]):
-                        df[f"LOG10_{parameter}"] = np.log10(df[parameter])
+                log_scale = {tf.name for tf in key.transform_functions if tf.use_log}
+                log_columns = [
+                    parameter
+                    for parameter in df.columns
+                    if parameter.split(":")[1] in log_scale
+                ]
+                if log_columns:
+                    df = pd.concat(
+                        [df, np.log10(df[log_columns]).add_prefix("LOG10_")], axis=1
+                    )
                 dataframes.append(df)
         if not dataframes:
             return pd.DataFrame()
@@ -766,6 +977,17 @@ def save_parameters(
         if group not in self.experiment.parameter_configuration:
             raise ValueError(f"{group} is not registered to the experiment.")
 
+        if (
+            self.parameter_layout == ParameterLayout.ENSEMBLE
+            and EnsembleParameterStore.supports(dataset)
+        ):
+            if "realizations" in dataset.dims:
+                dataset = dataset.sel(realizations=realization, drop=True)
+            self._parameter_store.save(group, realization, dataset)
+            with self._update_state() as state:
+                state.parameters.setdefault(group, set()).add(realization)
+            return
+
         path = self._realization_dir(realization) / f"{_escape_filename(group)}.nc"
         path.parent.mkdir(exist_ok=True)
         if "realizations" in dataset.dims:
@@ -773,6 +995,8 @@ def save_parameters(
         else:
             data_to_save = dataset.expand_dims(realizations=[realization])
         self._storage._to_netcdf_transaction(path, data_to_save)
+        with self._update_state() as state:
+            state.parameters.setdefault(group, set()).add(realization)
 
     @require_write
     def save_response(
@@ -814,27 +1038,38 @@ def save_response(
         Path.mkdir(output_path, parents=True, exist_ok=True)
 
         self._storage._to_parquet_transaction(
-            output_path / f"{response_type}.parquet", data
+            output_path / f"{response_type}.parquet",
+            data.sort("response_key", maintain_order=True),
+            row_group_size=RESPONSE_ROW_GROUP_SIZE,
         )
+        with self._update_state() as state:
+            state.responses.setdefault(response_type, set()).add(realization)
 
-        if not self.experiment._has_finalized_response_keys(response_type):
-            response_keys = data["response_key"].unique().to_list()
-            self.experiment._update_response_keys(response_type, response_keys)
+        experiment = self.experiment
+        with experiment._response_keys_lock:
+            if not experiment._has_finalized_response_keys(response_type):
+                response_keys = data["response_key"].unique().to_list()
+                experiment._update_response_keys(response_type, response_keys)
 
     def calculate_std_dev_for_parameter(self, parameter_group: str) -> xr.Dataset:
         if parameter_group not in self.experiment.parameter_configuration:
             raise ValueError(f"{parameter_group} is not registered to the experiment.")
 
         ds = self.load_parameters(parameter_group)
+        config = self.experiment.parameter_configuration[parameter_group]
+        if isinstance(config, Field) and "cells" in ds["values"].dims:
+            std = ds["values"].std("realizations")
+            return xr.Dataset(
+                {"values": (["x", "y", "z"], config.to_grid(std.values))}
+            )
         return ds.std("realizations")
 
     def get_parameter_state(
         self, realization: int
     ) -> dict[str, RealizationStorageState]:
-        path = self._realization_dir(realization)
         return {
             e: RealizationStorageState.PARAMETERS_LOADED
-            if (path / (_escape_filename(e) + ".nc")).exists()
+            if self._has_parameter_group(realization, e)
             else RealizationStorageState.UNDEFINED
             for e in self.experiment.parameter_configuration
         }
@@ -842,22 +1077,35 @@ def get_parameter_state(
     def get_response_state(
         self, realization: int
     ) -> dict[str, RealizationStorageState]:
-        response_configs = self.experiment.response_configuration
-        path = self._realization_dir(realization)
+        responses = self._state().responses
         return {
             e: RealizationStorageState.RESPONSES_LOADED
-            if (path / f"{e}.parquet").exists()
+            if realization in responses.get(e, ())
             else RealizationStorageState.UNDEFINED
-            for e in response_configs
+            for e in self.experiment.response_configuration
         }
 
+    @tracer.start_as_current_span(f"{__name__}.get_observations_and_responses")
     def get_observations_and_responses(
         self,
         selected_observations: Iterable[str],
         iens_active_index: npt.NDArray[np.int_],
+        realization_chunk_size: int = OBSERVATION_RESPONSE_CHUNK_SIZE,
     ) -> pl.DataFrame:
-        """Fetches and aligns selected observations with their corresponding simulated responses from an ensemble."""
+        """Fetches and aligns selected observations with their corresponding
+        simulated responses from an ensemble.
+
+        The responses of ``realization_chunk_size`` realizations are scanned
+        and as-of joined against the observations in one query, and written
+        into a preallocated (observations, realizations) float32 matrix, so
+        memory use is bounded by the chunk size rather than the number of
+        realizations.
+        """
         observations_by_type = self.experiment.observations
+        reals = sorted(iens_active_index.tolist())
+        selected_observations = list(selected_observations)
+        current_span = trace.get_current_span()
+        current_span.set_attribute("ert.realization_count", len(reals))
 
         with pl.StringCache():
             dfs_per_response_type = []
@@ -865,133 +1113,153 @@ def get_observations_and_responses(
                 response_type,
                 response_cls,
             ) in self.experiment.response_configuration.items():
-                if response_type not in observations_by_type:
+                if response_type not in observations_by_type or not reals:
                     continue
 
                 observations_for_type = (
                     observations_by_type[response_type]
-                    .filter(
-                        pl.col("observation_key").is_in(list(selected_observations))
-                    )
+                    .filter(pl.col("observation_key").is_in(selected_observations))
                     .with_columns(
-                        [
-                            pl.col("response_key")
-                            .cast(pl.Categorical)
-                            .alias("response_key")
-                        ]
+                        pl.col("response_key").cast(pl.Categorical),
                     )
                 )
+                responses_matrix = np.full(
+                    (len(observations_for_type), len(reals)),
+                    np.nan,
+                    dtype=np.float32,
+                )
+                for chunk_start in range(0, len(reals), realization_chunk_size):
+                    chunk = reals[chunk_start : chunk_start + realization_chunk_size]
+                    obs_rows, real_columns, values = self._align_responses(
+                        response_type,
+                        response_cls.primary_key,
+                        observations_for_type,
+                        chunk,
+                    )
+                    responses_matrix[obs_rows, real_columns + chunk_start] = values
 
-                observed_cols = {
-                    k: observations_for_type[k].unique()
-                    for k in ["response_key", *response_cls.primary_key]
-                }
-
-                reals = iens_active_index.tolist()
-                reals.sort()
-                # too much memory to do it all at once, go per realization
-                first_columns: pl.DataFrame | None = None
-                realization_columns: list[pl.DataFrame] = []
-                for real in reals:
-                    responses = self._load_responses_lazy(
-                        response_type, (real,)
-                    ).with_columns(
+                first_columns = (
+                    observations_for_type.with_columns(
+                        pl.concat_str(response_cls.primary_key, separator=", ").alias(
+                            "__tmp_index_key__"
+                            # Avoid potential collisions w/ primary key
+                        )
+                    )
+                    .drop(response_cls.primary_key)
+                    .rename({"__tmp_index_key__": "index"})
+                    .select(
                         [
-                            pl.col("response_key")
-                            .cast(pl.Categorical)
-                            .alias("response_key")
+                            "response_key",
+                            "index",
+                            "observation_key",
+                            "observations",
+                            "std",
                         ]
                     )
-
-                    # Filter out responses without observations
-                    for col, observed_values in observed_cols.items():
-                        if col != "time":
-                            responses = responses.filter(
-                                pl.col(col).is_in(observed_values)
-                            )
-
-                    pivoted = responses.collect().pivot(
-                        on="realization",
-                        index=["response_key", *response_cls.primary_key],
-                        values="values",
-                        aggregate_function="mean",
-                    )
-
-                    if pivoted.is_empty():
-                        # There are no responses for this realization,
-                        # so we explicitly create a column of nans
-                        # to represent this. We are basically saying that
-                        # for this realization, each observation points
-                        # to a NaN response.
-                        joined = observations_for_type.with_columns(
-                            pl.Series(
-                                str(real),
-                                [np.nan] * len(observations_for_type),
-                                dtype=pl.Float32,
-                            )
-                        )
-                    elif "time" in pivoted:
-                        joined = observations_for_type.join_asof(
-                            pivoted,
-                            by=[
-                                "response_key",
-                                *[k for k in response_cls.primary_key if k != "time"],
-                            ],
-                            on="time",
-                            strategy="nearest",
-                            tolerance="1s",
-                        )
-                    else:
-                        joined = observations_for_type.join(
-                            pivoted,
-                            how="left",
-                            on=["response_key", *response_cls.primary_key],
-                        )
-
-                    joined = (
-                        joined.with_columns(
-                            pl.concat_str(
-                                response_cls.primary_key, separator=", "
-                            ).alias(
-                                "__tmp_index_key__"
-                                # Avoid potential collisions w/ primary key
-                            )
-                        )
-                        .drop(response_cls.primary_key)
-                        .rename({"__tmp_index_key__": "index"})
+                )
+                dfs_per_response_type.append(
+                    pl.concat(
+                        [
+                            first_columns,
+                            pl.from_numpy(
+                                responses_matrix,
+                                schema=[str(real) for real in reals],
+                                orient="row",
+                            ),
+                        ],
+                        how="horizontal",
                     )
+                )
 
-                    if first_columns is None:
-                        # The "leftmost" index columns are not yet collected.
-                        # They are the same for all iterations, and indexed the same
-                        # because we do a left join for the observations.
-                        # Hence, we select these columns only once.
-                        first_columns = joined.select(
-                            [
-                                "response_key",
-                                "index",
-                                "observation_key",
-                                "observations",
-                                "std",
-                            ]
-                        )
-
-                    realization_columns.append(joined.select(str(real)))
+            aligned = pl.concat(dfs_per_response_type, how="vertical").with_columns(
+                pl.col("response_key").cast(pl.String).alias("response_key")
+            )
+            current_span.set_attribute("ert.observation_count", len(aligned))
+            return aligned
 
-                if first_columns is None:
-                    # Not a single realization had any responses to the
-                    # observations. Hence, there is no need to include
-                    # it in the dataset
-                    continue
+    def _align_responses(
+        self,
+        response_type: str,
+        primary_key: list[str],
+        observations: pl.DataFrame,
+        realizations: list[int],
+    ) -> tuple[npt.NDArray[np.int_], npt.NDArray[np.int_], npt.NDArray[np.float32]]:
+        """Joins the responses of the given realizations onto the observations
+        in a single lazy query. Returns, for every observation and realization
+        that has a response, the observation row, the realization position in
+        ``realizations`` and the response value."""
+        paths = [
+            self._realization_dir(real) / f"{response_type}.parquet"
+            for real in realizations
+        ]
+        for real, path in zip(realizations, paths, strict=True):
+            if not path.exists():
+                raise KeyError(
+                    f"No response for key {response_type}, realization: {real}"
+                )
 
-                dfs_per_response_type.append(
-                    pl.concat([first_columns, *realization_columns], how="horizontal")
+        observed = observations.with_row_index("__obs_row__").lazy()
+        join_keys = ["response_key", *primary_key]
+        responses = (
+            pl.scan_parquet(paths)
+            .filter(
+                pl.col("response_key").is_in(
+                    observations["response_key"].cast(pl.String).unique()
                 )
+            )
+            .with_columns(
+                pl.col("response_key").cast(pl.Categorical),
+                pl.col("realization").cast(pl.Int64),
+            )
+        )
+        for col in primary_key:
+            if col != "time":
+                responses = responses.filter(
+                    pl.col(col).is_in(observations[col].unique())
+                )
+        # Duplicate responses for the same key are averaged, as when pivoting
+        responses = responses.group_by(["realization", *join_keys]).agg(
+            pl.col("values").mean()
+        )
 
-            return pl.concat(dfs_per_response_type, how="vertical").with_columns(
-                pl.col("response_key").cast(pl.String).alias("response_key")
+        # Every observation is paired with every realization of the chunk,
+        # so that one join aligns the whole chunk
+        observed = observed.join(
+            pl.LazyFrame(
+                {
+                    "realization": pl.Series(realizations, dtype=pl.Int64),
+                    "__real_column__": pl.Series(
+                        range(len(realizations)), dtype=pl.Int64
+                    ),
+                }
+            ),
+            how="cross",
+        )
+
+        if "time" in primary_key:
+            joined = observed.sort("time").join_asof(
+                responses.sort("time"),
+                by=["realization", *[k for k in join_keys if k != "time"]],
+                on="time",
+                strategy="nearest",
+                tolerance="1s",
+            )
+        else:
+            joined = observed.join(
+                responses, how="left", on=["realization", *join_keys]
             )
 
+        aligned = (
+            joined.select("__obs_row__", "__real_column__", "values")
+            .drop_nulls("values")
+            .collect()
+        )
+        return (
+            aligned["__obs_row__"].to_numpy().astype(np.int_),
+            aligned["__real_column__"].to_numpy().astype(np.int_),
+            aligned["values"].to_numpy().astype(np.float32),
+        )
+
     @property
     def everest_realization_info(self) -> dict[int, EverestRealizationInfo] | None:
         return self._index.everest_realization_info
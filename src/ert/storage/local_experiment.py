@@ -1,6 +1,7 @@
 from __future__ import annotations
 
 import json
+import threading
 from collections.abc import Generator
 from datetime import datetime
 from functools import cached_property
@@ -73,6 +74,9 @@ def __init__(
         self._index = _Index.model_validate_json(
             (path / "index.json").read_text(encoding="utf-8")
         )
+        # Responses of several realizations may be saved concurrently, see
+        # LocalEnsemble.save_response
+        self._response_keys_lock = threading.Lock()
 
     @classmethod
     def create(
@@ -1,20 +1,23 @@
 from __future__ import annotations
 
 import contextlib
+import io
 import json
 import logging
 import os
 import shutil
-from collections.abc import Generator, MutableSequence
+import threading
+from collections.abc import Generator, Iterator, MutableSequence
 from datetime import datetime
 from functools import cached_property
 from pathlib import Path
 from tempfile import NamedTemporaryFile
 from textwrap import dedent
 from types import TracebackType
-from typing import Any
+from typing import TYPE_CHECKING, Any
 from uuid import UUID, uuid4
 
+import numpy as np
 import polars as pl
 import xarray as xr
 from filelock import FileLock, Timeout
@@ -22,14 +25,20 @@
 
 from ert.config import ErtConfig, ParameterConfig, ResponseConfig
 from ert.shared import __version__
-from ert.storage.local_ensemble import LocalEnsemble
+from ert.storage.ensemble_parameter_store import ParameterLayout
+from ert.storage.local_ensemble import LocalEnsemble, _EnsembleState
 from ert.storage.local_experiment import LocalExperiment
 from ert.storage.mode import BaseMode, Mode, require_write
 from ert.storage.realization_storage_state import RealizationStorageState
+from ert.storage.write_behind import WriteBehind
+from ert.trace import trace, tracer
+
+if TYPE_CHECKING:
+    import numpy.typing as npt
 
 logger = logging.getLogger(__name__)
 
-_LOCAL_STORAGE_VERSION = 9
+_LOCAL_STORAGE_VERSION = 10
 
 
 class _Migrations(BaseModel):
@@ -65,6 +74,7 @@ def __init__(
         mode: Mode,
         *,
         ignore_migration_check: bool = False,
+        write_behind: bool | None = None,
     ) -> None:
         """
         Initializes the LocalStorage instance.
@@ -77,10 +87,27 @@ def __init__(
             The access mode for the storage (read/write).
         ignore_migration_check : bool
             If True, skips migration checks during initialization.
+        write_behind : bool, optional
+            If True, the NetCDF and Parquet files written within
+            :meth:`write_behind_context` are written by a background thread.
+            Defaults to the ERT_STORAGE_WRITE_BEHIND environment variable.
         """
 
         super().__init__(mode)
         self.path = Path(path).absolute()
+        self._write_behind_enabled = (
+            write_behind if write_behind is not None else _default_write_behind()
+        )
+        self._writer: WriteBehind | None = None
+        self._writer_users = 0
+        self._writer_lock = threading.Lock()
+        # The saved state of the realizations of each ensemble, see
+        # LocalEnsemble._state, each guarded by the lock of its ensemble
+        self._ensemble_states: dict[UUID, _EnsembleState] = {}
+        self._ensemble_state_locks: dict[UUID, threading.RLock] = {}
+        # Ensembles whose state has changed since their state file was
+        # written, see write_behind_context
+        self._unsaved_ensemble_states: dict[UUID, LocalEnsemble] = {}
 
         self._experiments: dict[UUID, LocalExperiment]
         self._ensembles: dict[UUID, LocalEnsemble]
@@ -288,6 +315,7 @@ def close(self) -> None:
         if not self.can_write:
             return
 
+        self.flush()
         self._save_index()
         self._release_lock()
 
@@ -354,6 +382,7 @@ def create_ensemble(
         iteration: int = 0,
         name: str | None = None,
         prior_ensemble: LocalEnsemble | UUID | None = None,
+        parameter_layout: ParameterLayout | None = None,
     ) -> LocalEnsemble:
         """
         Creates a new ensemble in the storage.
@@ -373,6 +402,10 @@ def create_ensemble(
             The name of the ensemble.
         prior_ensemble : {LocalEnsemble, UUID}, optional
             An optional ensemble to use as a prior.
+        parameter_layout : ParameterLayout, optional
+            How parameters are laid out on disk. Defaults to the layout of the
+            prior ensemble, or the ERT_STORAGE_PARAMETER_LAYOUT environment
+            variable if there is no prior.
 
         Returns
         -------
@@ -399,6 +432,12 @@ def create_ensemble(
                 f"New ensemble ({ensemble_size}) must be of equal or "
                 f"smaller size than parent ensemble ({prior_ensemble.ensemble_size})"
             )
+        if parameter_layout is None:
+            parameter_layout = (
+                prior_ensemble.parameter_layout
+                if prior_ensemble
+                else _default_parameter_layout()
+            )
         ens = LocalEnsemble.create(
             self,
             path,
@@ -408,6 +447,7 @@ def create_ensemble(
             iteration=iteration,
             name=str(name),
             prior_ensemble_id=prior_ensemble_id,
+            parameter_layout=parameter_layout,
         )
         if prior_ensemble:
             for realization, state in enumerate(prior_ensemble.get_ensemble_state()):
@@ -456,6 +496,7 @@ def _migrate(self, version: int) -> None:
             to7,
             to8,
             to9,
+            to10,
         )
 
         try:
@@ -500,7 +541,9 @@ def _migrate(self, version: int) -> None:
 
             elif version < _LOCAL_STORAGE_VERSION:
                 migrations = list(
-                    enumerate([to2, to3, to4, to5, to6, to7, to8, to9], start=1)
+                    enumerate(
+                        [to2, to3, to4, to5, to6, to7, to8, to9, to10], start=1
+                    )
                 )
                 for from_version, migration in migrations[version - 1 :]:
                     print(f"* Updating storage to version: {from_version + 1}")
@@ -546,6 +589,95 @@ def get_unique_experiment_name(self, experiment_name: str) -> str:
         else:
             return experiment_name + "_0"
 
+    @contextlib.contextmanager
+    def write_behind_context(self) -> Iterator[None]:
+        """
+        Writes the NetCDF and Parquet files saved within the context in a
+        background thread, if write-behind is enabled for the storage.
+
+        The files are saved as transactions as usual, but callers continue
+        while the files are written, and the files may not be on disk until
+        :meth:`flush` is called or the context exits. The context is meant to
+        be entered around the parts of a run that only write to storage, such
+        as internalizing the results of an ensemble, or saving the posterior
+        of an update.
+
+        Whether or not write-behind is enabled, the state files of the
+        ensembles saved to within the context are written once when the
+        context exits or :meth:`flush` is called, instead of on every save.
+        """
+        if not self.can_write:
+            yield
+            return
+        with self._writer_lock:
+            if self._write_behind_enabled and self._writer is None:
+                self._writer = WriteBehind(self._swap_path)
+            self._writer_users += 1
+        try:
+            yield
+        except BaseException:
+            # The error of the context is raised, the writer has logged
+            # its own errors
+            with contextlib.suppress(Exception):
+                self._release_writer()
+            raise
+        self._release_writer()
+
+    def _release_writer(self) -> None:
+        with self._writer_lock:
+            self._writer_users -= 1
+            last_user = self._writer_users == 0
+            writer = self._writer if last_user else None
+            if writer is not None:
+                self._writer = None
+        if writer is not None:
+            writer.close()
+        if last_user:
+            self._save_ensemble_states()
+
+    def flush(self) -> None:
+        """
+        Waits until the files queued by write-behind have been written, and
+        writes the state files of the ensembles that have changed.
+
+        Raises the first error that occurred while writing them.
+        """
+        # The state files are queued behind the files they describe, so they
+        # are saved before waiting for the writer
+        self._save_ensemble_states()
+        if (writer := self._writer) is not None:
+            writer.flush()
+
+    @property
+    def _defers_ensemble_states(self) -> bool:
+        return self._writer_users > 0
+
+    def _ensemble_state_lock(self, ensemble_id: UUID) -> threading.RLock:
+        if (lock := self._ensemble_state_locks.get(ensemble_id)) is None:
+            lock = self._ensemble_state_locks.setdefault(
+                ensemble_id, threading.RLock()
+            )
+        return lock
+
+    def _defer_ensemble_state(self, ensemble: LocalEnsemble) -> None:
+        """Mark the state of the ensemble as changed since its state file was
+        written. The state file is removed until it is written again, so that
+        the ensemble is probed instead of its state being lost if the process
+        dies before then."""
+        with self._writer_lock:
+            unsaved = ensemble.id in self._unsaved_ensemble_states
+            self._unsaved_ensemble_states[ensemble.id] = ensemble
+        if not unsaved:
+            ensemble._remove_state_file()
+
+    def _save_ensemble_states(self) -> None:
+        with self._writer_lock:
+            unsaved = list(self._unsaved_ensemble_states.values())
+            self._unsaved_ensemble_states.clear()
+        for ensemble in unsaved:
+            ensemble._save_state()
+
+    @tracer.start_as_current_span(f"{__name__}.write_transaction")
     def _write_transaction(self, filename: str | os.PathLike[str], data: bytes) -> None:
         """
         Writes the data to the filename as a transaction.
@@ -553,12 +685,30 @@ def _write_transaction(self, filename: str | os.PathLike[str], data: bytes) -> N
         Guarantees to not leave half-written or empty files on disk if the write
         fails or the process is killed.
         """
+        if (writer := self._writer) is not None and writer.is_queued(filename):
+            # Do not let a queued write overwrite this one
+            writer.flush()
+        _set_transaction_attributes(filename, len(data))
         self._swap_path.mkdir(parents=True, exist_ok=True)
         with NamedTemporaryFile(dir=self._swap_path, delete=False) as f:
             f.write(data)
             os.chmod(f.name, 0o660)
             os.rename(f.name, filename)
 
+    def _ordered_write_transaction(
+        self, filename: str | os.PathLike[str], data: bytes
+    ) -> None:
+        """
+        Writes the data to the filename as a transaction, after the files that
+        are queued to be written behind, so that it is never on disk before
+        the files it describes.
+        """
+        if (writer := self._writer) is not None:
+            writer.write(filename, data)
+            return
+        self._write_transaction(filename, data)
+
+    @tracer.start_as_current_span(f"{__name__}.to_netcdf_transaction")
     def _to_netcdf_transaction(
         self, filename: str | os.PathLike[str], dataset: xr.Dataset
     ) -> None:
@@ -568,14 +718,24 @@ def _to_netcdf_transaction(
         Guarantees to not leave half-written or empty files on disk if the write
         fails or the process is killed.
         """
+        if (writer := self._writer) is not None:
+            data = bytes(dataset.to_netcdf(engine="scipy"))
+            _set_transaction_attributes(filename, len(data))
+            writer.write(filename, data)
+            return
         self._swap_path.mkdir(parents=True, exist_ok=True)
         with NamedTemporaryFile(dir=self._swap_path, delete=False) as f:
             dataset.to_netcdf(f, engine="scipy")
             os.chmod(f.name, 0o660)
             os.rename(f.name, filename)
+        _set_transaction_attributes(filename, os.path.getsize(filename))
 
+    @tracer.start_as_current_span(f"{__name__}.to_parquet_transaction")
     def _to_parquet_transaction(
-        self, filename: str | os.PathLike[str], dataframe: pl.DataFrame
+        self,
+        filename: str | os.PathLike[str],
+        dataframe: pl.DataFrame,
+        row_group_size: int | None = None,
     ) -> None:
         """
         Writes the dataset to the filename as a transaction.
@@ -583,11 +743,49 @@ def _to_parquet_transaction(
         Guarantees to not leave half-written or empty files on disk if the write
         fails or the process is killed.
         """
+        if (writer := self._writer) is not None:
+            buffer = io.BytesIO()
+            dataframe.write_parquet(buffer, row_group_size=row_group_size)
+            _set_transaction_attributes(filename, buffer.getbuffer().nbytes)
+            writer.write(filename, buffer.getvalue())
+            return
+        self._swap_path.mkdir(parents=True, exist_ok=True)
+        with NamedTemporaryFile(dir=self._swap_path, delete=False) as f:
+            dataframe.write_parquet(f.name, row_group_size=row_group_size)
+            os.chmod(f.name, 0o660)
+            os.rename(f.name, filename)
+        _set_transaction_attributes(filename, os.path.getsize(filename))
+
+    @tracer.start_as_current_span(f"{__name__}.to_npz_transaction")
+    def _to_npz_transaction(
+        self, filename: str | os.PathLike[str], arrays: dict[str, npt.NDArray[Any]]
+    ) -> None:
+        """
+        Writes the arrays to the filename as an uncompressed npz archive in a
+        transaction.
+
+        Guarantees to not leave half-written or empty files on disk if the write
+        fails or the process is killed.
+        """
+        if (writer := self._writer) is not None:
+            buffer = io.BytesIO()
+            np.savez(buffer, **arrays)
+            _set_transaction_attributes(filename, buffer.getbuffer().nbytes)
+            writer.write(filename, buffer.getvalue())
+            return
         self._swap_path.mkdir(parents=True, exist_ok=True)
         with NamedTemporaryFile(dir=self._swap_path, delete=False) as f:
-            dataframe.write_parquet(f.name)
+            np.savez(f, **arrays)
+            f.flush()
             os.chmod(f.name, 0o660)
             os.rename(f.name, filename)
+        _set_transaction_attributes(filename, os.path.getsize(filename))
+
+
+def _set_transaction_attributes(filename: str | os.PathLike[str], size: int) -> None:
+    current_span = trace.get_current_span()
+    current_span.set_attribute("ert.storage.file", os.fspath(filename))
+    current_span.set_attribute("ert.bytes", size)
 
 
 def _storage_version(path: Path) -> int:
@@ -605,6 +803,28 @@ def _storage_version(path: Path) -> int:
             raise
 
 
+def _default_write_behind() -> bool:
+    return os.environ.get("ERT_STORAGE_WRITE_BEHIND", "").lower() in {
+        "1",
+        "true",
+        "yes",
+    }
+
+
+def _default_parameter_layout() -> ParameterLayout:
+    layout = os.environ.get("ERT_STORAGE_PARAMETER_LAYOUT")
+    if layout is None:
+        return ParameterLayout.REALIZATION
+    try:
+        return ParameterLayout(layout.lower())
+    except ValueError:
+        logger.warning(
+            f"Unknown ERT_STORAGE_PARAMETER_LAYOUT {layout!r}, valid layouts "
+            f"are {[e.value for e in ParameterLayout]}"
+        )
+        return ParameterLayout.REALIZATION
+
+
 _migration_ert_config: ErtConfig | None = None
 
 
@@ -0,0 +1,53 @@
+import json
+import os
+from pathlib import Path
+
+import xarray as xr
+
+from ert.storage.ensemble_parameter_store import (
+    EnsembleParameterStore,
+    ParameterLayout,
+    _escape_filename,
+)
+from ert.storage.local_storage import _default_parameter_layout
+
+info = "Record parameter layout of ensembles"
+
+
+def _convert_to_ensemble_layout(
+    path: Path, ensemble: Path, ensemble_size: int, parameter_groups: list[str]
+) -> None:
+    store = EnsembleParameterStore(
+        ensemble / "parameters", ensemble_size, path / "swp"
+    )
+    for group in parameter_groups:
+        for real_dir in sorted(ensemble.glob("realization-*")):
+            nc_file = real_dir / f"{_escape_filename(group)}.nc"
+            if not nc_file.exists():
+                continue
+            realization = int(real_dir.name.removeprefix("realization-"))
+            with xr.open_dataset(nc_file, engine="scipy") as ds:
+                dataset = ds.isel(realizations=0, drop=True).load()
+            if not EnsembleParameterStore.supports(dataset):
+                break
+            store.save(group, realization, dataset)
+            os.remove(nc_file)
+
+
+def migrate(path: Path) -> None:
+    layout = _default_parameter_layout()
+    for ensemble in path.glob("ensembles/*"):
+        with open(ensemble / "index.json", encoding="utf-8") as f:
+            index = json.load(f)
+
+        if layout == ParameterLayout.ENSEMBLE:
+            experiment = path / "experiments" / index["experiment_id"]
+            with open(experiment / "parameter.json", encoding="utf-8") as f:
+                parameter_groups = list(json.load(f))
+            _convert_to_ensemble_layout(
+                path, ensemble, index["ensemble_size"], parameter_groups
+            )
+
+        index["parameter_layout"] = layout.value
+        with open(ensemble / "index.json", "w", encoding="utf-8") as f:
+            f.write(json.dumps(index, indent=2))
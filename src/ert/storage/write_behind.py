@@ -0,0 +1,141 @@
+from __future__ import annotations
+
+import contextlib
+import logging
+import os
+import queue
+import threading
+from collections import Counter
+from pathlib import Path
+from tempfile import NamedTemporaryFile
+from typing import Final
+
+logger = logging.getLogger(__name__)
+
+WRITE_BEHIND_QUEUE_SIZE: Final = 256
+"""Number of writes that may be queued before writers have to wait"""
+WRITE_BEHIND_BATCH_SIZE: Final = 32
+"""Number of queued writes that are written before they are renamed in place"""
+
+
+class WriteBehind:
+    """Writes files as transactions in a single background thread.
+
+    Writers queue the serialized content of a file, and continue while it is
+    written. The writer thread writes each file to a temporary file in the swap
+    directory, and renames all files written in a batch in place at once,
+    in the order they were queued. As with LocalStorage._write_transaction,
+    no half-written or empty files are left on disk if a write fails or the
+    process is killed, but the writes that are still queued are lost.
+
+    If writing a file of a batch fails, the files queued after it in the batch
+    are not written, so that no file is put in place after a write that was
+    lost. An error raised while writing is raised from the next call to write
+    or flush.
+    """
+
+    def __init__(
+        self,
+        swap_path: Path,
+        max_queued: int = WRITE_BEHIND_QUEUE_SIZE,
+        batch_size: int = WRITE_BEHIND_BATCH_SIZE,
+    ) -> None:
+        self._swap_path = swap_path
+        self._batch_size = batch_size
+        self._queue: queue.Queue[tuple[Path, bytes] | None] = queue.Queue(
+            maxsize=max_queued
+        )
+        self._lock = threading.Lock()
+        self._queued: Counter[Path] = Counter()
+        self._error: Exception | None = None
+        self._thread = threading.Thread(
+            target=self._run, name="storage_writer", daemon=True
+        )
+        self._thread.start()
+
+    def write(self, filename: str | os.PathLike[str], data: bytes) -> None:
+        """Queue the data to be written to filename, waits if the queue is full"""
+        self._raise_error()
+        path = Path(filename)
+        with self._lock:
+            self._queued[path] += 1
+        self._queue.put((path, data))
+
+    def is_queued(self, filename: str | os.PathLike[str]) -> bool:
+        with self._lock:
+            return Path(filename) in self._queued
+
+    def flush(self) -> None:
+        """Wait until all queued writes are on disk"""
+        self._queue.join()
+        self._raise_error()
+
+    def close(self) -> None:
+        """Flush the queued writes and stop the writer thread"""
+        self._queue.put(None)
+        self._thread.join()
+        self._raise_error()
+
+    def _raise_error(self) -> None:
+        with self._lock:
+            error, self._error = self._error, None
+        if error is not None:
+            raise error
+
+    def _set_error(self, error: Exception) -> None:
+        logger.error(f"Failed to write to storage: {error}")
+        with self._lock:
+            if self._error is None:
+                self._error = error
+
+    def _run(self) -> None:
+        while True:
+            batch = [self._queue.get()]
+            while batch[-1] is not None and len(batch) < self._batch_size:
+                try:
+                    batch.append(self._queue.get_nowait())
+                except queue.Empty:
+                    break
+            writes = [item for item in batch if item is not None]
+            try:
+                self._write_batch(writes)
+            finally:
+                with self._lock:
+                    for path, _ in writes:
+                        self._queued[path] -= 1
+                        if not self._queued[path]:
+                            del self._queued[path]
+                for _ in batch:
+                    self._queue.task_done()
+            if batch[-1] is None:
+                return
+
+    def _write_batch(self, writes: list[tuple[Path, bytes]]) -> None:
+        # Only the last of the writes to the same file in a batch is on disk
+        # after the batch, and the ones before it need not be written at all
+        last_write = {path: i for i, (path, _) in enumerate(writes)}
+        written: list[tuple[str, Path]] = []
+        for path, data in (
+            write for i, write in enumerate(writes) if last_write[write[0]] == i
+        ):
+            temporary: str | None = None
+            try:
+                self._swap_path.mkdir(parents=True, exist_ok=True)
+                with NamedTemporaryFile(dir=self._swap_path, delete=False) as f:
+                    temporary = f.name
+                    f.write(data)
+                os.chmod(temporary, 0o660)
+                written.append((temporary, path))
+            except Exception as err:
+                self._set_error(err)
+                if temporary is not None:
+                    with contextlib.suppress(OSError):
+                        os.unlink(temporary)
+                break
+        for temporary, path in written:
+            try:
+                os.rename(temporary, path)
+            except Exception as err:
+                self._set_error(err)
+                with contextlib.suppress(OSError):
+                    os.unlink(temporary)
@@ -12,6 +12,7 @@
 
 logger = logging.getLogger(__name__)
 _PATTERN = re.compile(r"<[^<>]+>")
+_REALIZATION_KEYS = frozenset(("<IENS>", "<ITER>", "<GEO_ID>"))
 
 
 class Substitutions(UserDict[str, str]):
@@ -41,6 +42,18 @@ def substitute_real_iter(
         copy_substituter["<ITER>"] = str(iteration)
         return copy_substituter.substitute(to_substitute)
 
+    def without_real_iter(self) -> Substitutions:
+        """The substitutions that do not depend on the realization and
+        iteration, i.e. all but <IENS>, <ITER> and <GEO_ID>.
+
+        A string substituted with these, and then with substitute_real_iter,
+        is equal to the string substituted with substitute_real_iter alone,
+        so the first step can be shared between realizations.
+        """
+        return Substitutions(
+            {key: value for key, value in self.items() if key not in _REALIZATION_KEYS}
+        )
+
     def _concise_representation(self) -> str:
         return (
             "[" + ",\n".join([f"({key}, {value})" for key, value in self.items()]) + "]"
@@ -88,6 +101,12 @@ def __get_pydantic_json_schema__(
         return handler(core_schema.str_schema())
 
 
+def has_substitution_keys(string: str) -> bool:
+    """Whether the string contains anything that looks like <KEY>, and so
+    might change when substituted"""
+    return _PATTERN.search(string) is not None
+
+
 def _substitute(
     substitutions: Mapping[str, str],
     to_substitute: str,
@@ -1,3 +1,8 @@
+import contextvars
+import functools
+from collections.abc import Callable
+from typing import ParamSpec, TypeVar
+
 from opentelemetry import trace
 from opentelemetry.sdk.resources import SERVICE_NAME, Resource
 from opentelemetry.sdk.trace import SpanLimits, TracerProvider
@@ -11,6 +16,9 @@
 
 tracer = trace.get_tracer("ert.main")
 
+P = ParamSpec("P")
+T = TypeVar("T")
+
 
 def get_trace_id() -> str:
     return trace.format_trace_id(trace.get_current_span().get_span_context().trace_id)
@@ -21,3 +29,16 @@ def get_traceparent() -> str | None:
     # Write the current context into the carrier.
     TraceContextTextMapPropagator().inject(carrier)
     return carrier.get("traceparent")
+
+
+def with_current_context(func: Callable[P, T]) -> Callable[P, T]:
+    """func, for calling once in another thread, e.g. through an executor,
+    where spans it starts are children of the current span of the caller
+    instead of starting new traces"""
+    context = contextvars.copy_context()
+
+    @functools.wraps(func)
+    def run_in_context(*args: P.args, **kwargs: P.kwargs) -> T:
+        return context.run(func, *args, **kwargs)
+
+    return run_in_context
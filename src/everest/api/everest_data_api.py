@@ -53,27 +53,25 @@ def output_constraint_names(self) -> list[str]:
             else []
         )
 
-    @property
-    def realizations(self) -> list[int]:
-        if not self._ever_storage.data.batches_with_function_results:
+    def _first_batch_realization_objectives(self, column: str) -> list[int]:
+        realization_objectives = self._ever_storage.data.scan(
+            "realization_objectives", self.batches[:1]
+        )
+        if realization_objectives is None:
             return []
         return sorted(
-            self._ever_storage.data.batches_with_function_results[0]
-            .realization_objectives["realization"]
-            .unique()
+            realization_objectives.select(pl.col(column).unique())
+            .collect()[column]
             .to_list()
         )
 
+    @property
+    def realizations(self) -> list[int]:
+        return self._first_batch_realization_objectives("realization")
+
     @property
     def simulations(self) -> list[int]:
-        if not self._ever_storage.data.batches_with_function_results:
-            return []
-        return sorted(
-            self._ever_storage.data.batches_with_function_results[0]
-            .realization_objectives["simulation_id"]
-            .unique()
-            .to_list()
-        )
+        return self._first_batch_realization_objectives("simulation_id")
 
     @property
     def control_names(self) -> list[str]:
@@ -89,70 +87,108 @@ def control_values(self) -> list[dict[str, Any]]:
             if self._ever_storage.data.controls is not None
             else []
         )
-        new = []
-        for batch in self._ever_storage.data.batches_with_function_results:
-            for controls_dict in batch.realization_controls.to_dicts():
-                for name in all_control_names:
-                    new.append(
-                        {
-                            "control": name,
-                            "batch": batch.batch_id,
-                            "value": controls_dict[name],
-                        }
-                    )
+        realization_controls = self._ever_storage.data.scan(
+            "realization_controls", self.batches
+        )
+        if realization_controls is None or not all_control_names:
+            return []
 
-        return new
+        # One row per control of each realization, in order of the controls
+        return (
+            realization_controls.select(
+                pl.col("batch_id").cast(pl.Int64).alias("batch"), *all_control_names
+            )
+            .with_row_index("row")
+            .unpivot(
+                on=all_control_names,
+                index=["row", "batch"],
+                variable_name="control",
+                value_name="value",
+            )
+            .with_columns(
+                pl.col("control")
+                .replace_strict(
+                    {name: i for i, name in enumerate(all_control_names)},
+                    return_dtype=pl.UInt32,
+                )
+                .alias("control_index")
+            )
+            .sort("row", "control_index")
+            .select("control", "batch", "value")
+            .collect()
+            .to_dicts()
+        )
 
     @property
     def objective_values(self) -> list[dict[str, Any]]:
-        obj_values = []
-        for b in self._ever_storage.data.batches_with_function_results:
-            for (
-                geo_realization,
-                simulation_id,
-            ), df in b.realization_objectives.sort(
-                ["realization", "simulation_id"]
-            ).group_by(["realization", "simulation_id"], maintain_order=True):
-                for obj_dict in (
-                    self._ever_storage.data.objective_functions.sort(
-                        ["objective_name"]
-                    ).to_dicts()
-                    if self._ever_storage.data.objective_functions is not None
-                    else []
-                ):
-                    obj_name = obj_dict["objective_name"]
-                    obj_values.append(
-                        {
-                            "batch": int(b.batch_id),
-                            "realization": int(geo_realization),  # type: ignore
-                            "simulation": int(simulation_id),  # type: ignore
-                            "function": obj_name,
-                            "scale": float(obj_dict["scale"]),
-                            "value": float(df[obj_name].item()),
-                            "weight": float(obj_dict["weight"]),
-                        }
-                    )
+        objectives = self._ever_storage.data.objective_functions
+        realization_objectives = self._ever_storage.data.scan(
+            "realization_objectives", self.batches
+        )
+        if objectives is None or realization_objectives is None:
+            return []
+
+        objectives = objectives.sort("objective_name")
+        names = objectives["objective_name"].to_list()
+        index = ["batch", "realization", "simulation"]
+
+        def by_name(column: str) -> pl.Expr:
+            return pl.col("function").replace_strict(
+                dict(zip(names, objectives[column].to_list(), strict=True)),
+                return_dtype=pl.Float64,
+            )
 
-        return obj_values
+        # One row per objective of each simulation, in order of the names
+        return (
+            realization_objectives.select(
+                pl.col("batch_id").cast(pl.Int64).alias("batch"),
+                pl.col("realization").cast(pl.Int64),
+                pl.col("simulation_id").cast(pl.Int64).alias("simulation"),
+                *names,
+            )
+            .unpivot(
+                on=names, index=index, variable_name="function", value_name="value"
+            )
+            .with_columns(
+                pl.col("function")
+                .replace_strict(
+                    {name: i for i, name in enumerate(names)}, return_dtype=pl.UInt32
+                )
+                .alias("function_index")
+            )
+            .sort(*index, "function_index")
+            .select(
+                *index,
+                "function",
+                by_name("scale").alias("scale"),
+                pl.col("value").cast(pl.Float64),
+                by_name("weight").alias("weight"),
+            )
+            .collect()
+            .to_dicts()
+        )
 
     @property
     def single_objective_values(self) -> list[dict[str, Any]]:
-        batch_datas = pl.concat(
-            [
-                b.batch_objectives.select(
-                    c for c in b.batch_objectives.columns if c != "merit_value"
-                ).with_columns(pl.lit(1 if b.is_improvement else 0).alias("accepted"))
-                for b in self._ever_storage.data.batches_with_function_results
-            ]
-        )
         objectives = self._ever_storage.data.objective_functions
         assert objectives is not None
+        batch_objectives = self._ever_storage.data.scan(
+            "batch_objectives", self.batches
+        )
+        if batch_objectives is None:
+            return []
         objective_names = objectives["objective_name"].unique().to_list()
 
-        for o in objectives.to_dicts():
-            batch_datas = batch_datas.with_columns(
+        batch_objectives = batch_objectives.with_columns(
+            pl.col("batch_id")
+            .is_in(self.accepted_batches)
+            .cast(pl.Int32)
+            .alias("accepted"),
+            *(
                 pl.col(o["objective_name"]) * o["weight"] / o["scale"]
-            )
+                for o in objectives.to_dicts()
+            ),
+        )
 
         columns = [
             "batch",
@@ -162,32 +198,31 @@ def single_objective_values(self) -> list[dict[str, Any]]:
         ]
 
         return (
-            batch_datas.rename(
+            batch_objectives.rename(
                 {"total_objective_value": "objective", "batch_id": "batch"}
             )
             .select(columns)
+            .collect()
             .to_dicts()
         )
 
     @property
     def gradient_values(self) -> list[dict[str, Any]]:
-        all_batch_data = [
-            b.batch_objective_gradient
-            for b in self._ever_storage.data.batches_with_gradient_results
-            if b.batch_objective_gradient is not None
-            and b.is_improvement  # Note: This part might not be sensible
-        ]
-        if not all_batch_data:
+        gradients = self._ever_storage.data.scan(
+            "batch_objective_gradient",
+            # Note: This part might not be sensible
+            (b.batch_id for b in self._ever_storage.data.batches if b.is_improvement),
+        )
+        if gradients is None:
             return []
 
-        all_info = pl.concat(all_batch_data)
         objective_columns = [
             c
-            for c in all_info.drop(["batch_id", "control_name"]).columns
-            if not c.endswith(".total")
+            for c in gradients.collect_schema().names()
+            if c not in {"batch_id", "control_name"} and not c.endswith(".total")
         ]
         return (
-            all_info.select("batch_id", "control_name", *objective_columns)
+            gradients.select("batch_id", "control_name", *objective_columns)
             .unpivot(
                 on=objective_columns,
                 index=["batch_id", "control_name"],
@@ -197,6 +232,7 @@ def gradient_values(self) -> list[dict[str, Any]]:
             .rename({"control_name": "control", "batch_id": "batch"})
             .sort(by=["batch", "control"])
             .select(["batch", "function", "control", "value"])
+            .collect()
             .to_dicts()
         )
 
@@ -51,17 +51,17 @@ def opt_controls_by_batch(optimization_dir: str, batch: int) -> dict[str, Any] |
     assert storage.data is not None
     assert storage.data.controls is not None
     control_names = storage.data.controls["control_name"]
-    function_batch = next(
-        (b for b in storage.data.batches_with_function_results if b.batch_id == batch),
-        None,
-    )
+    realization_controls = storage.data.scan("realization_controls", [batch])
 
-    if function_batch:
+    if realization_controls is not None:
         # All geo-realizations should have the same unperturbed control values per batch
         # hence it does not matter which realization we select the controls for
-        return function_batch.realization_controls.select(
-            control_names.to_list()
-        ).to_dicts()[0]
+        return (
+            realization_controls.select(control_names.to_list())
+            .head(1)
+            .collect()
+            .to_dicts()[0]
+        )
 
     return None
 
@@ -163,7 +163,10 @@ def update(self, status: dict[str, Any]) -> None:
                                 if pert != -1
                                 else f"Function evaluation for realization {real}"
                             )
-                            end = f": re-using results from simulation {src_sim_id} of batch {src_batch}."
+                            end = f": re-using results from simulation {src_sim_id} of batch {src_batch}"
+                            if c["from_earlier_optimization"]:
+                                end += " of an earlier optimization"
+                            end += "."
 
                             cache_hit_strs.append(start + end)
 
@@ -1,10 +1,12 @@
 from __future__ import annotations
 
+import hashlib
 import json
 import logging
 import os
 import traceback
-from collections.abc import Callable
+from collections import OrderedDict
+from collections.abc import Callable, Iterable
 from dataclasses import dataclass
 from functools import cached_property
 from pathlib import Path
@@ -31,6 +33,284 @@ def try_read_df(path: Path) -> pl.DataFrame | None:
     return pl.read_parquet(path) if path.exists() else None
 
 
+class BatchTable:
+    """
+    Append-only table of the dataframes of all batches, partitioned by batch
+    with one parquet file per batch, batch_<batch_id>.parquet, that is never
+    rewritten.
+
+    Reading a batch reads only the file of that batch. The most recently
+    read and appended partitions are kept in a cache of at most
+    MAX_CACHED_PARTITIONS partitions, so that the memory used by the table
+    does not grow with the number of batches. Queries over many batches
+    should use scan, which pushes filters and selections down to the files.
+    """
+
+    MAX_CACHED_PARTITIONS: ClassVar[int] = 32
+
+    def __init__(self, path: Path) -> None:
+        self._path = path
+        self._partitions: OrderedDict[int, pl.DataFrame] = OrderedDict()
+
+    def _file(self, batch_id: int) -> Path:
+        return self._path / f"batch_{batch_id}.parquet"
+
+    def _cache(self, batch_id: int, df: pl.DataFrame) -> None:
+        self._partitions[batch_id] = df
+        self._partitions.move_to_end(batch_id)
+        while len(self._partitions) > self.MAX_CACHED_PARTITIONS:
+            self._partitions.popitem(last=False)
+
+    def batch_ids(self) -> list[int]:
+        if not self._path.exists():
+            return []
+        return sorted(
+            int(name.removeprefix("batch_").removesuffix(".parquet"))
+            for name in os.listdir(self._path)
+            if name.startswith("batch_") and name.endswith(".parquet")
+        )
+
+    def has_batch(self, batch_id: int) -> bool:
+        return batch_id in self._partitions or self._file(batch_id).exists()
+
+    def append(self, batch_id: int, df: pl.DataFrame) -> None:
+        self._path.mkdir(parents=True, exist_ok=True)
+        # Written next to the partition and moved into place, so that readers
+        # never see a partially written partition
+        tmp_file = self._path / f".batch_{batch_id}.parquet.{os.getpid()}"
+        df.write_parquet(tmp_file, statistics=True)
+        tmp_file.replace(self._file(batch_id))
+        self._cache(batch_id, df)
+
+    def scan(self, batch_ids: Iterable[int] | None = None) -> pl.LazyFrame | None:
+        """The table of the given batches, or of all batches, for queries that
+        are pushed down to the parquet files"""
+        existing = self.batch_ids()
+        if batch_ids is not None:
+            existing = sorted(set(existing).intersection(batch_ids))
+        if not existing:
+            return None
+        return pl.concat(
+            [pl.scan_parquet(self._file(batch_id)) for batch_id in existing],
+            how="diagonal_relaxed",
+        )
+
+    def read(self, batch_id: int) -> pl.DataFrame | None:
+        if batch_id in self._partitions:
+            self._partitions.move_to_end(batch_id)
+            return self._partitions[batch_id]
+        if not self._file(batch_id).exists():
+            return None
+        df = pl.read_parquet(self._file(batch_id))
+        self._cache(batch_id, df)
+        return df
+
+    def read_all(self) -> pl.DataFrame | None:
+        """The table of all batches, in order of the batches"""
+        table = self.scan()
+        return None if table is None else table.collect()
+
+
+class EvaluationCache:
+    """
+    Persistent cache of the objectives and constraints of simulated control
+    vectors, by model realization and the configuration of the simulations.
+
+    The cache is kept in the optimization output directory, so that control
+    vectors that were simulated by an earlier optimization with the same
+    simulation configuration, e.g. before a restart, are not simulated again.
+    Each set of added results is a partition of a batch table, with the
+    columns of Experiment.all_parameters_and_gen_data, together with the
+    hash of the configuration it was simulated with and the id of the
+    optimization that simulated it.
+
+    The configuration hash covers the contents of the files that are
+    installed into the runpaths, so that editing e.g. a job script or a
+    model file between optimizations does not reuse stale results. The batch
+    of a result from an earlier optimization is a batch of that optimization,
+    which is told by the from_earlier_optimization column of the results.
+    """
+
+    # The parts of the configuration that decide the results of simulations
+    SIMULATION_CONFIG_FIELDS: ClassVar[set[str]] = {
+        "model",
+        "wells",
+        "definitions",
+        "install_jobs",
+        "install_data",
+        "install_templates",
+        "forward_model",
+    }
+
+    # The parts of the control definitions that only decide how the optimizer
+    # moves the controls, and not the results of simulating a control vector
+    OPTIMIZER_CONTROL_FIELDS: ClassVar[set[str]] = {
+        "initial_guess",
+        "min",
+        "max",
+        "enabled",
+        "auto_scale",
+        "scaled_range",
+        "perturbation_type",
+        "perturbation_magnitude",
+        "sampler",
+    }
+
+    def __init__(self, path: Path, config_hash: str, optimization_id: str) -> None:
+        self._table = BatchTable(path)
+        self._config_hash = config_hash
+        self._optimization_id = optimization_id
+
+    @classmethod
+    def config_hash(cls, everest_config: EverestConfig) -> str:
+        config = everest_config.model_dump(
+            mode="json", include=cls.SIMULATION_CONFIG_FIELDS, exclude_none=True
+        )
+        # Cached results are looked up by the values of all controls, so they
+        # can not be reused when controls are added, renamed or removed
+        optimizer_fields = dict.fromkeys(cls.OPTIMIZER_CONTROL_FIELDS, True)
+        config.update(
+            everest_config.model_dump(
+                mode="json",
+                include={"controls"},
+                exclude={
+                    "controls": {
+                        "__all__": {
+                            **optimizer_fields,
+                            "variables": {"__all__": optimizer_fields},
+                        }
+                    }
+                },
+                exclude_none=True,
+            )
+        )
+        config["control_names"] = everest_config.formatted_control_names
+        config["objective_names"] = everest_config.objective_names
+        config["constraint_names"] = everest_config.constraint_names
+        config["file_digests"] = cls.file_digests(everest_config)
+        return hashlib.sha256(
+            json.dumps(config, sort_keys=True).encode("utf-8")
+        ).hexdigest()
+
+    @staticmethod
+    def _installed_sources(everest_config: EverestConfig) -> Iterable[str]:
+        """The configured paths of the files and directories that are
+        installed into the runpaths"""
+        for data in everest_config.install_data or []:
+            yield data.source
+        for template in everest_config.install_templates or []:
+            yield template.template
+            if template.extra_data is not None:
+                yield template.extra_data
+        for job in everest_config.install_jobs or []:
+            if job.source is not None:
+                yield job.source
+            if job.executable is not None:
+                yield job.executable
+        if everest_config.model.data_file is not None:
+            yield everest_config.model.data_file
+
+    @classmethod
+    def file_digests(cls, everest_config: EverestConfig) -> dict[str, str | None]:
+        """The sha256 digests of the contents of the installed sources, and of
+        the executables named by the installed job configuration files, by
+        the path relative to the configuration directory, with <GEO_ID>
+        expanded for every model realization. Missing sources have no digest.
+        """
+        config_dir = Path(everest_config.config_directory or ".")
+        realizations = everest_config.model.realizations
+
+        def expand(source: str) -> list[str]:
+            source = source.replace("<CONFIG_PATH>", str(config_dir))
+            if "<GEO_ID>" in source:
+                return [source.replace("<GEO_ID>", str(r)) for r in realizations]
+            return [source]
+
+        digests: dict[str, str | None] = {
+            path: _content_digest(config_dir / path)
+            for source in cls._installed_sources(everest_config)
+            for path in expand(source)
+        }
+        for job in everest_config.install_jobs or []:
+            if job.source is None:
+                continue
+            job_path = config_dir / job.source
+            executable = _job_executable(job_path)
+            if executable is not None:
+                digests[str(Path(job.source).parent / executable)] = _content_digest(
+                    job_path.parent / executable
+                )
+        return digests
+
+    def results(self) -> pl.DataFrame | None:
+        """The cached results of simulations with this configuration, where
+        from_earlier_optimization is true for results of other optimizations"""
+        table = self._table.scan()
+        if table is None:
+            return None
+        schema = table.collect_schema()
+        from_earlier_optimization = (
+            (pl.col("optimization_id") != self._optimization_id).fill_null(True)
+            if "optimization_id" in schema
+            else pl.lit(True)
+        )
+        results = (
+            table.filter(pl.col("config_hash") == self._config_hash)
+            .with_columns(from_earlier_optimization.alias("from_earlier_optimization"))
+            .drop("config_hash", "optimization_id", strict=False)
+            .collect()
+        )
+        return None if results.is_empty() else results
+
+    def add(self, results: pl.DataFrame) -> None:
+        """Add the results of simulations, where results that are not finite,
+        e.g. of failed simulations, are left out to be simulated again"""
+        value_columns = [
+            c
+            for c in results.columns
+            if c not in {"batch", "model_realization", "perturbation", "realization"}
+        ]
+        results = results.filter(
+            pl.all_horizontal(pl.col(value_columns).is_finite())
+        ).with_columns(
+            pl.lit(self._config_hash).alias("config_hash"),
+            pl.lit(self._optimization_id).alias("optimization_id"),
+        )
+        if not results.is_empty():
+            self._table.append(max(self._table.batch_ids(), default=-1) + 1, results)
+
+
+def _content_digest(path: Path) -> str | None:
+    """The sha256 digest of the contents of a file, or of the relative paths
+    and contents of all files below a directory"""
+    if path.is_file():
+        with open(path, "rb") as f:
+            return hashlib.file_digest(f, "sha256").hexdigest()
+    if not path.is_dir():
+        return None
+    digest = hashlib.sha256()
+    for file in sorted(p for p in path.rglob("*") if p.is_file()):
+        digest.update(str(file.relative_to(path)).encode("utf-8"))
+        with open(file, "rb") as f:
+            digest.update(hashlib.file_digest(f, "sha256").digest())
+    return digest.hexdigest()
+
+
+def _job_executable(path: Path) -> str | None:
+    """The EXECUTABLE of a forward model step configuration file"""
+    if not path.is_file():
+        return None
+    try:
+        lines = path.read_text(encoding="utf-8").splitlines()
+    except UnicodeDecodeError:
+        return None
+    for line in lines:
+        keyword, _, value = line.strip().partition(" ")
+        if keyword == "EXECUTABLE" and value.strip():
+            return value.strip()
+    return None
+
+
 class BatchDataframes(TypedDict, total=False):
     realization_controls: pl.DataFrame | None
     batch_objectives: pl.DataFrame | None
@@ -63,28 +343,45 @@ class BatchStorageData:
         "perturbation_constraints",
     ]
 
-    def __init__(self, path: Path):
+    def __init__(
+        self,
+        path: Path,
+        tables: dict[str, BatchTable],
+        batch_id: int | None = None,
+    ) -> None:
         self._path = path
+        self._tables = tables
+        if batch_id is not None:
+            # Saves reading it from batch.json
+            self.batch_id = batch_id
+
+    def _has_df(self, df_name: str) -> bool:
+        return (
+            self._tables[df_name].has_batch(self.batch_id)
+            or (self._path / f"{df_name}.parquet").exists()
+        )
+
+    def _read_df(self, df_name: str) -> pl.DataFrame | None:
+        df = self._tables[df_name].read(self.batch_id)
+        if df is None:
+            # Batches stored before the dataframes were stored in batch tables
+            return self._read_df_if_exists(self._path / f"{df_name}.parquet")
+        return df
 
     @property
     def has_data(self) -> bool:
-        return any(
-            (self._path / f"{df_name}.parquet").exists()
-            for df_name in self.BATCH_DATAFRAMES
-        )
+        return any(self._has_df(df_name) for df_name in self.BATCH_DATAFRAMES)
 
     @property
     def has_function_results(self) -> bool:
         return any(
-            (self._path / f"{df_name}.parquet").exists()
-            for df_name in _FunctionResults.__annotations__
+            self._has_df(df_name) for df_name in _FunctionResults.__annotations__
         )
 
     @property
     def has_gradient_results(self) -> bool:
         return any(
-            (self._path / f"{df_name}.parquet").exists()
-            for df_name in _GradientResults.__annotations__
+            self._has_df(df_name) for df_name in _GradientResults.__annotations__
         )
 
     @staticmethod
@@ -95,45 +392,62 @@ def _read_df_if_exists(path: Path) -> pl.DataFrame | None:
 
     @property
     def realization_controls(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "realization_controls.parquet")
+        return self._read_df("realization_controls")
 
     @property
     def batch_objectives(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "batch_objectives.parquet")
+        df = self._read_df("batch_objectives")
+        merit_values = self._tables["merit_values"].read(self.batch_id)
+        if df is not None and merit_values is not None:
+            return df.with_columns(
+                pl.lit(merit_values["merit_value"].item()).alias("merit_value")
+            )
+        return df
 
     @property
     def realization_objectives(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "realization_objectives.parquet")
+        return self._read_df("realization_objectives")
 
     @property
     def batch_constraints(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "batch_constraints.parquet")
+        return self._read_df("batch_constraints")
 
     @property
     def realization_constraints(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "realization_constraints.parquet")
+        return self._read_df("realization_constraints")
 
     @property
     def batch_objective_gradient(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "batch_objective_gradient.parquet")
+        return self._read_df("batch_objective_gradient")
 
     @property
     def perturbation_objectives(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "perturbation_objectives.parquet")
+        return self._read_df("perturbation_objectives")
 
     @property
     def batch_constraint_gradient(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "batch_constraint_gradient.parquet")
+        return self._read_df("batch_constraint_gradient")
 
     @property
     def perturbation_constraints(self) -> pl.DataFrame | None:
-        return self._read_df_if_exists(self._path / "perturbation_constraints.parquet")
+        return self._read_df("perturbation_constraints")
 
     def save_dataframes(self, dataframes: BatchDataframes) -> None:
         for df_name in self.BATCH_DATAFRAMES:
             df = dataframes.get(df_name)
             if isinstance(df, pl.DataFrame):
-                df.write_parquet(self._path / f"{df_name}.parquet")
+                self._tables[df_name].append(self.batch_id, df)
+
+    def save_merit_value(self, merit_value: float) -> None:
+        self._tables["merit_values"].append(
+            self.batch_id,
+            pl.DataFrame(
+                {
+                    "batch_id": pl.Series([self.batch_id], dtype=pl.UInt32),
+                    "merit_value": pl.Series([merit_value], dtype=pl.Float64),
+                }
+            ),
+        )
 
     @cached_property
     def is_improvement(self) -> bool:
@@ -143,7 +457,7 @@ def is_improvement(self) -> bool:
         return bool(info["is_improvement"])
 
     @cached_property
-    def batch_id(self) -> bool:
+    def batch_id(self) -> int:
         with open(self._path / "batch.json", encoding="utf-8") as f:
             info = json.load(f)
 
@@ -254,14 +568,23 @@ class OptimizationStorageData:
         "realization_weights",
     ]
 
+    BATCH_TABLES: ClassVar[list[str]] = [
+        *BatchStorageData.BATCH_DATAFRAMES,
+        "merit_values",
+    ]
+
     def __init__(self, path: Path) -> None:
         self._path = path
         self.batches: list[BatchStorageData] = []
+        self.tables = {
+            table_name: BatchTable(path / table_name)
+            for table_name in self.BATCH_TABLES
+        }
 
     @property
     def batches_with_function_results(self) -> list[FunctionBatchStorageData]:
         return [
-            FunctionBatchStorageData(b._path)
+            FunctionBatchStorageData(b._path, self.tables, b.batch_id)
             for b in self.batches
             if b.has_function_results
         ]
@@ -269,7 +592,7 @@ def batches_with_function_results(self) -> list[FunctionBatchStorageData]:
     @property
     def batches_with_gradient_results(self) -> list[GradientBatchStorageData]:
         return [
-            GradientBatchStorageData(b._path)
+            GradientBatchStorageData(b._path, self.tables, b.batch_id)
             for b in self.batches
             if b.has_gradient_results
         ]
@@ -296,24 +619,45 @@ def save_dataframes(self, dataframes: OptimizationDataframes) -> None:
             if isinstance(df, pl.DataFrame):
                 df.write_parquet(self._path / f"{df_name}.parquet")
 
-    def simulation_to_geo_realization_map(self, batch_id: int) -> dict[int, int]:
+    def scan(
+        self, table_name: str, batch_ids: Iterable[int] | None = None
+    ) -> pl.LazyFrame | None:
         """
-        Mapping from simulation ID to geo-realization
+        The batch table of the given batches, or of all batches, in order of
+        the batches, for queries that are pushed down to the parquet files.
+        Batches stored before the dataframes were stored in batch tables are
+        scanned from the batch directories.
         """
-        dummy_df = next(
-            (
-                b.realization_controls
-                for b in self.batches_with_function_results
-                if b.batch_id == batch_id
-            ),
-            None,
+        table = self.tables[table_name]
+        wanted = None if batch_ids is None else set(batch_ids)
+        files = []
+        for batch in self.batches:
+            if wanted is not None and batch.batch_id not in wanted:
+                continue
+            if table.has_batch(batch.batch_id):
+                files.append(table._file(batch.batch_id))
+            elif (batch._path / f"{table_name}.parquet").exists():
+                files.append(batch._path / f"{table_name}.parquet")
+        if not files:
+            return None
+        return pl.concat(
+            [pl.scan_parquet(file) for file in files], how="diagonal_relaxed"
         )
 
-        if dummy_df is None:
+    def simulation_to_geo_realization_map(self, batch_id: int) -> dict[int, int]:
+        """
+        Mapping from simulation ID to geo-realization
+        """
+        realization_controls = self.scan("realization_controls", [batch_id])
+        if realization_controls is None:
             return {}
 
         mapping = {}
-        for d in dummy_df.select("realization", "simulation_id").to_dicts():
+        for d in (
+            realization_controls.select("realization", "simulation_id")
+            .collect()
+            .to_dicts()
+        ):
             mapping[int(d["simulation_id"])] = int(d["realization"])
 
         return mapping
@@ -321,9 +665,7 @@ def simulation_to_geo_realization_map(self, batch_id: int) -> dict[int, int]:
     def read_from_experiment(self, experiment: _OptimizerOnlyExperiment) -> None:
         for ens in experiment.ensembles.values():
             self.batches.append(
-                BatchStorageData(
-                    path=ens.optimizer_mount_point,
-                )
+                BatchStorageData(path=ens.optimizer_mount_point, tables=self.tables)
             )
 
         self.batches.sort(key=lambda b: b.batch_id)
@@ -868,7 +1210,11 @@ def on_batch_evaluation_finished(
                     f,
                 )
 
-            batch_data = BatchStorageData(path=target_ensemble.optimizer_mount_point)
+            batch_data = BatchStorageData(
+                path=target_ensemble.optimizer_mount_point,
+                tables=self.data.tables,
+                batch_id=batch_id,
+            )
 
             batch_data.save_dataframes(
                 {
@@ -913,13 +1259,7 @@ def on_optimization_finished(self) -> None:
                 if merit_value is None:
                     continue
 
-                b.save_dataframes(
-                    {
-                        "batch_objectives": b.batch_objectives.with_columns(
-                            pl.lit(merit_value).alias("merit_value")
-                        )
-                    }
-                )
+                b.save_merit_value(merit_value)
                 b.write_metadata(is_improvement=True)
         else:
             max_total_objective = -np.inf
@@ -1,5 +1,6 @@
 import hashlib
 import json
+import time
 from argparse import ArgumentParser
 
 import pytest
@@ -11,8 +12,10 @@
 from ert.mode_definitions import ENSEMBLE_EXPERIMENT_MODE
 
 from .performance_utils import make_poly_template
+from .scaling import PeakRss, ScalingPoint, format_scaling_curves
 
 template_config_path = None
+scaling_points: list[ScalingPoint] = []
 
 
 def make_case(reals, x_size, marks):
@@ -103,3 +106,45 @@ def pytest_addoption(parser):
         default=None,
         help="specify to share previously generated template-config runs",
     )
+
+
+@fixture
+def scaling_benchmark(benchmark):
+    """Benchmarks one point of a scaling curve, the wall time and the peak
+    increase in resident set size of calling func on a case of the given size.
+
+    The points of a curve share a pytest-benchmark group, and their size and
+    peak RSS are saved as extra info, so they are compared against the
+    baseline like any other benchmark. The curves are summarized at the end
+    of the session. Each point is measured for the given number of rounds,
+    calling setup before each round.
+    """
+
+    def run(curve, size, func, *args, setup=None, rounds=3, **kwargs):
+        seconds = []
+
+        def timed():
+            start = time.perf_counter()
+            result = func(*args, **kwargs)
+            seconds.append(time.perf_counter() - start)
+            return result
+
+        # pytest-codspeed, which replaces pytest-benchmark in the codspeed
+        # workflow, does not keep extra info
+        extra_info = getattr(benchmark, "extra_info", {})
+        benchmark.group = curve
+        extra_info["size"] = size
+        with PeakRss() as rss:
+            result = benchmark.pedantic(timed, setup=setup, rounds=rounds, iterations=1)
+        extra_info["peak_rss_bytes"] = rss.peak_bytes
+        scaling_points.append(ScalingPoint(curve, size, min(seconds), rss.peak_bytes))
+        return result
+
+    return run
+
+
+def pytest_terminal_summary(terminalreporter):
+    if scaling_points:
+        terminalreporter.section("scaling curves")
+        for line in format_scaling_curves(scaling_points):
+            terminalreporter.write_line(line)
@@ -0,0 +1,124 @@
+"""
+Measuring how the wall time and memory use of ert scale with the size of
+the case. See the scaling_benchmark fixture in conftest.py.
+"""
+
+from __future__ import annotations
+
+import math
+import threading
+from collections import defaultdict
+from collections.abc import Iterable, Sequence
+from dataclasses import dataclass
+from types import TracebackType
+
+import psutil
+import pytest
+
+
+@dataclass(frozen=True)
+class ScalingPoint:
+    curve: str
+    size: int
+    seconds: float
+    peak_rss_bytes: int
+
+
+class PeakRss:
+    """Samples the resident set size of the process in a background thread
+    while in the context, and keeps the peak increase from the size at entry.
+
+    Unlike memray, this also sees memory allocated outside of the python
+    allocators and in other threads, e.g. by polars and numpy."""
+
+    def __init__(self, interval: float = 0.005) -> None:
+        self.interval = interval
+        self.peak_bytes = 0
+        self._process = psutil.Process()
+        self._baseline = 0
+        self._stop = threading.Event()
+        self._thread: threading.Thread | None = None
+
+    def __enter__(self) -> PeakRss:
+        self._baseline = self._process.memory_info().rss
+        self.peak_bytes = 0
+        self._stop.clear()
+        self._thread = threading.Thread(target=self._sample_until_stopped)
+        self._thread.start()
+        return self
+
+    def __exit__(
+        self,
+        exc_type: type[BaseException] | None,
+        exc_value: BaseException | None,
+        traceback: TracebackType | None,
+    ) -> None:
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join()
+        self._sample()
+
+    def _sample(self) -> None:
+        rss = self._process.memory_info().rss
+        self.peak_bytes = max(self.peak_bytes, rss - self._baseline)
+
+    def _sample_until_stopped(self) -> None:
+        while True:
+            self._sample()
+            if self._stop.wait(self.interval):
+                return
+
+
+def scaling_sizes(
+    argname: str, sizes: Sequence[int], slow_above: int
+) -> pytest.MarkDecorator:
+    """Parametrizes argname over the sizes of the points of a scaling curve.
+    Sizes above slow_above are production sizes, and are only run with
+    --runslow."""
+    return pytest.mark.parametrize(
+        argname,
+        [
+            pytest.param(
+                size,
+                id=f"{argname}={size}",
+                marks=[pytest.mark.slow] if size > slow_above else [],
+            )
+            for size in sizes
+        ],
+    )
+
+
+def format_scaling_curves(points: Iterable[ScalingPoint]) -> list[str]:
+    """One table per curve of the time and peak memory of each size, and
+    the exponent of the growth of the time from the previous size, i.e. 1 for
+    linear and 2 for quadratic scaling"""
+    curves: defaultdict[str, list[ScalingPoint]] = defaultdict(list)
+    for point in points:
+        curves[point.curve].append(point)
+
+    lines = []
+    for curve, curve_points in sorted(curves.items()):
+        lines.append(curve)
+        lines.append(
+            f"{'size':>12} {'seconds':>12} {'peak RSS MiB':>14} {'exponent':>10}"
+        )
+        previous: ScalingPoint | None = None
+        for point in sorted(curve_points, key=lambda p: p.size):
+            exponent = ""
+            if (
+                previous is not None
+                and point.size > previous.size
+                and point.seconds > 0
+                and previous.seconds > 0
+            ):
+                exponent = format(
+                    math.log(point.seconds / previous.seconds)
+                    / math.log(point.size / previous.size),
+                    ".2f",
+                )
+            lines.append(
+                f"{point.size:>12} {point.seconds:>12.4f} "
+                f"{point.peak_rss_bytes / 1024**2:>14.1f} {exponent:>10}"
+            )
+            previous = point
+    return lines
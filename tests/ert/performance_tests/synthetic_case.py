@@ -0,0 +1,309 @@
+"""
+Synthetic cases of any size for the scaling benchmarks.
+
+A SyntheticCase gives the sizes of a case, and create_prior puts an
+experiment with those sizes in storage: parameters (GEN_KW and FIELD),
+responses (summary and gen_data) for every realization, and observations of
+a random subset of the responses. The values are random, so the cases are
+only good for measuring time and memory, not for checking the results of an
+update.
+"""
+
+from __future__ import annotations
+
+import dataclasses
+from dataclasses import dataclass
+from datetime import datetime, timedelta
+from pathlib import Path
+
+import numpy as np
+import polars as pl
+import xarray as xr
+import xtgeo
+
+from ert.config import Field, GenDataConfig, GenKwConfig, SummaryConfig
+from ert.config.gen_kw_config import TransformFunctionDefinition
+from ert.enkf_main import sample_prior
+from ert.field_utils import Shape
+from ert.storage import Ensemble, Storage
+from tests.ert.unit_tests.config.summary_generator import (
+    Date,
+    Simulator,
+    Smspec,
+    SmspecIntehead,
+    SummaryMiniStep,
+    SummaryStep,
+    UnitSystem,
+    Unsmry,
+)
+
+GEN_KW_NAME = "COEFFS"
+FIELD_NAME = "PORO"
+START_DATE = datetime(2000, 1, 1)
+TIME_STEP = timedelta(days=30)
+
+
+@dataclass(frozen=True)
+class SyntheticCase:
+    """The sizes of a synthetic case. Observations are spread over distinct
+    responses, so there are at most as many observations of a kind as there
+    are responses of that kind in one realization."""
+
+    realizations: int = 10
+    gen_kw_parameters: int = 10
+    field_cells: int = 0
+    summary_keys: int = 10
+    summary_timesteps: int = 100
+    summary_observations: int = 100
+    gen_data_keys: int = 10
+    gen_data_index: int = 100
+    gen_data_observations: int = 100
+    seed: int = 0
+
+    def __post_init__(self) -> None:
+        if self.summary_observations > self.summary_keys * self.summary_timesteps:
+            raise ValueError("More summary observations than summary responses")
+        if self.gen_data_observations > self.gen_data_keys * self.gen_data_index:
+            raise ValueError("More gen_data observations than gen_data responses")
+        if self.field_cells % 100 != 0:
+            raise ValueError("The number of field cells must be a multiple of 100")
+
+    def scaled(self, **sizes: int) -> SyntheticCase:
+        return dataclasses.replace(self, **sizes)
+
+    @property
+    def summary_response_keys(self) -> list[str]:
+        return [f"WOPR:W{i}" for i in range(self.summary_keys)]
+
+    @property
+    def summary_times(self) -> list[datetime]:
+        return [START_DATE + TIME_STEP * i for i in range(self.summary_timesteps)]
+
+    @property
+    def gen_data_response_keys(self) -> list[str]:
+        return [f"GEN_{i}" for i in range(self.gen_data_keys)]
+
+    @property
+    def field_shape(self) -> Shape:
+        return Shape(self.field_cells // 100, 10, 10)
+
+
+def create_prior(storage: Storage, case: SyntheticCase, path: Path) -> Ensemble:
+    """An experiment of the size of the case, with a prior ensemble where
+    every realization has parameters and responses. The grid of the field
+    is written to path."""
+    rng = np.random.default_rng(case.seed)
+    parameters: list[GenKwConfig | Field] = []
+    if case.gen_kw_parameters:
+        parameters.append(_gen_kw_config(case))
+    if case.field_cells:
+        parameters.append(_field_config(case, path))
+    experiment = storage.create_experiment(
+        parameters=parameters,
+        responses=[
+            GenDataConfig(
+                keys=case.gen_data_response_keys,
+                report_steps_list=[[0] for _ in range(case.gen_data_keys)],
+            ),
+            SummaryConfig(keys=["*"]),
+        ],
+        observations={
+            "gen_data": _gen_data_observations(case, rng),
+            "summary": _summary_observations(case, rng),
+        },
+        name="synthetic",
+    )
+    prior = storage.create_ensemble(
+        experiment, ensemble_size=case.realizations, iteration=0, name="prior"
+    )
+    if case.gen_kw_parameters:
+        sample_prior(prior, range(case.realizations), [GEN_KW_NAME], case.seed)
+
+    summary = _summary_responses(case)
+    gen_data = _gen_data_responses(case)
+    for realization in range(case.realizations):
+        if case.field_cells:
+            prior.save_parameters(
+                FIELD_NAME,
+                realization,
+                xr.Dataset(
+                    {
+                        "values": xr.DataArray(
+                            rng.standard_normal(case.field_shape, dtype=np.float32),
+                            dims=("x", "y", "z"),
+                        )
+                    }
+                ),
+            )
+        prior.save_response("summary", _with_noise(summary, rng), realization)
+        prior.save_response("gen_data", _with_noise(gen_data, rng), realization)
+    return prior
+
+
+def create_posterior(prior: Ensemble) -> Ensemble:
+    return prior.experiment.create_ensemble(
+        ensemble_size=prior.ensemble_size,
+        iteration=prior.iteration + 1,
+        name="posterior",
+        prior_ensemble=prior,
+    )
+
+
+def write_summary_files(basename: Path, case: SyntheticCase) -> None:
+    """Writes basename.SMSPEC and basename.UNSMRY with the summary
+    responses of the case, one report step per time step"""
+    rng = np.random.default_rng(case.seed)
+    wells = [key.split(":")[1] for key in case.summary_response_keys]
+    Smspec(
+        nx=10,
+        ny=10,
+        nz=10,
+        restarted_from_step=0,
+        num_keywords=case.summary_keys + 1,
+        restart="        ",
+        keywords=["TIME    "] + ["WOPR    "] * case.summary_keys,
+        well_names=[":+:+:+:+", *wells],
+        region_numbers=[-32676] + [0] * case.summary_keys,
+        units=["DAYS    "] + ["SM3/DAY "] * case.summary_keys,
+        start_date=Date.from_datetime(START_DATE),
+        intehead=SmspecIntehead(
+            unit=UnitSystem.METRIC,
+            simulator=Simulator.ECLIPSE_100,
+        ),
+    ).to_file(basename.with_suffix(".SMSPEC"))
+    days = TIME_STEP.days
+    Unsmry(
+        steps=[
+            SummaryStep(
+                seqnum=step,
+                ministeps=[
+                    SummaryMiniStep(
+                        mini_step=step,
+                        params=np.concatenate(
+                            [
+                                [step * days],
+                                rng.uniform(0, 100, case.summary_keys),
+                            ]
+                        ),
+                    )
+                ],
+            )
+            for step in range(case.summary_timesteps)
+        ]
+    ).to_file(basename.with_suffix(".UNSMRY"))
+
+
+def _gen_kw_config(case: SyntheticCase) -> GenKwConfig:
+    return GenKwConfig(
+        name=GEN_KW_NAME,
+        template_file=None,
+        output_file=None,
+        forward_init=False,
+        update=True,
+        transform_function_definitions=[
+            TransformFunctionDefinition(
+                f"COEFF_{i}", param_name="NORMAL", values=[0, 1]
+            )
+            for i in range(case.gen_kw_parameters)
+        ],
+    )
+
+
+def _field_config(case: SyntheticCase, path: Path) -> Field:
+    shape = case.field_shape
+    grid_file = str(path / "SYNTHETIC.EGRID")
+    xtgeo.create_box_grid(dimension=(shape.nx, shape.ny, shape.nz)).to_file(
+        grid_file, "egrid"
+    )
+    return Field.from_config_list(
+        grid_file,
+        shape,
+        [
+            FIELD_NAME,
+            FIELD_NAME,
+            "poro.GRDECL",
+            {"INIT_FILES": "poro_%d.GRDECL", "FORWARD_INIT": "False"},
+        ],
+    )
+
+
+def _summary_responses(case: SyntheticCase) -> pl.DataFrame:
+    keys = case.summary_response_keys
+    times = case.summary_times
+    return pl.DataFrame(
+        {
+            "response_key": np.repeat(keys, len(times)),
+            "time": pl.Series(times * len(keys), dtype=pl.Datetime("ms")),
+            "values": pl.Series(
+                np.full(len(keys) * len(times), 10.0), dtype=pl.Float32
+            ),
+        }
+    )
+
+
+def _gen_data_responses(case: SyntheticCase) -> pl.DataFrame:
+    keys = case.gen_data_response_keys
+    return pl.DataFrame(
+        {
+            "response_key": np.repeat(keys, case.gen_data_index),
+            "report_step": pl.Series(
+                np.zeros(len(keys) * case.gen_data_index), dtype=pl.UInt16
+            ),
+            "index": pl.Series(
+                np.tile(np.arange(case.gen_data_index), len(keys)), dtype=pl.UInt16
+            ),
+            "values": pl.Series(
+                np.full(len(keys) * case.gen_data_index, 10.0), dtype=pl.Float32
+            ),
+        }
+    )
+
+
+def _with_noise(responses: pl.DataFrame, rng: np.random.Generator) -> pl.DataFrame:
+    # Responses that vary between realizations, without outliers that would
+    # deactivate the observations in an update
+    return responses.with_columns(
+        pl.col("values")
+        + pl.Series(rng.standard_normal(len(responses)), dtype=pl.Float32)
+    )
+
+
+def _observed(
+    responses: pl.DataFrame, num_observations: int, rng: np.random.Generator
+) -> pl.DataFrame:
+    rows = np.sort(rng.choice(len(responses), size=num_observations, replace=False))
+    return responses[rows].with_columns(
+        pl.Series(
+            "observations",
+            rng.normal(10, 1, num_observations),
+            dtype=pl.Float32,
+        ),
+        pl.Series("std", np.ones(num_observations), dtype=pl.Float32),
+    )
+
+
+def _summary_observations(
+    case: SyntheticCase, rng: np.random.Generator
+) -> pl.DataFrame:
+    observed = _observed(_summary_responses(case), case.summary_observations, rng)
+    return observed.select(
+        pl.format("SUMMARY_OBS_{}", pl.int_range(pl.len())).alias("observation_key"),
+        "response_key",
+        "time",
+        "observations",
+        "std",
+    )
+
+
+def _gen_data_observations(
+    case: SyntheticCase, rng: np.random.Generator
+) -> pl.DataFrame:
+    observed = _observed(_gen_data_responses(case), case.gen_data_observations, rng)
+    return observed.select(
+        pl.format("GEN_OBS_{}", pl.int_range(pl.len())).alias("observation_key"),
+        "response_key",
+        "report_step",
+        "index",
+        "observations",
+        "std",
+    )
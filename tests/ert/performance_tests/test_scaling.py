@@ -0,0 +1,310 @@
+"""
+Scaling curves of the parts of ert that grow with the size of the case.
+
+Each test measures one point of a curve with the scaling_benchmark fixture.
+The smallest sizes run with the other performance tests, while the
+production sizes, e.g. 10^7 field cells, 10^5 summary observations and
+thousands of realizations, are marked slow and need --runslow.
+"""
+
+import asyncio
+from pathlib import Path
+
+import numpy as np
+import pytest
+
+from _ert.events import (
+    ForwardModelStepRunning,
+    ForwardModelStepStart,
+    ForwardModelStepSuccess,
+    event_to_json,
+)
+from ert.analysis import smoother_update
+from ert.config import ErtConfig, ESSettings, UpdateSettings
+from ert.config._read_summary import read_summary
+from ert.dark_storage.cache import get_record_cache
+from ert.dark_storage.endpoints import records
+from ert.enkf_main import create_run_path, sample_prior
+from ert.ensemble_evaluator import EnsembleEvaluator
+from ert.ensemble_evaluator.config import EvaluatorServerConfig
+from ert.ensemble_evaluator.state import FORWARD_MODEL_STATE_FINISHED
+from ert.run_arg import create_run_arguments
+from ert.runpaths import Runpaths
+from tests.ert.unit_tests.ensemble_evaluator.ensemble_evaluator_utils import (
+    TestEnsemble,
+)
+
+from .scaling import scaling_sizes
+from .synthetic_case import (
+    FIELD_NAME,
+    GEN_KW_NAME,
+    SyntheticCase,
+    create_posterior,
+    create_prior,
+    write_summary_files,
+)
+
+
+def _summary_case(summary_observations: int, **sizes: int) -> SyntheticCase:
+    # Twenty observations per summary vector of 200 time steps
+    return SyntheticCase(
+        summary_keys=max(summary_observations // 20, 1),
+        summary_timesteps=200,
+        summary_observations=summary_observations,
+        **sizes,
+    )
+
+
+@pytest.mark.parametrize("localization", [False, True])
+@scaling_sizes("field_cells", [10**4, 10**5, 10**6, 10**7], slow_above=10**4)
+def test_scaling_of_analysis_es_with_field_cells(
+    scaling_benchmark, storage, tmp_path, field_cells, localization
+):
+    prior = create_prior(
+        storage,
+        SyntheticCase(realizations=100, gen_kw_parameters=0, field_cells=field_cells),
+        tmp_path,
+    )
+    posterior = create_posterior(prior)
+    scaling_benchmark(
+        f"analysis_ES field cells (localization={localization})",
+        field_cells,
+        smoother_update,
+        prior,
+        posterior,
+        prior.experiment.observation_keys,
+        [FIELD_NAME],
+        UpdateSettings(),
+        ESSettings(localization=localization),
+        rounds=1,
+    )
+    assert posterior.load_parameters(FIELD_NAME, 0)["values"].size == field_cells
+
+
+@pytest.mark.parametrize("localization", [False, True])
+@scaling_sizes("summary_observations", [10**3, 10**4, 10**5], slow_above=10**3)
+def test_scaling_of_analysis_es_with_summary_observations(
+    scaling_benchmark, storage, tmp_path, summary_observations, localization
+):
+    prior = create_prior(
+        storage,
+        _summary_case(summary_observations, realizations=100, gen_kw_parameters=100),
+        tmp_path,
+    )
+    posterior = create_posterior(prior)
+    scaling_benchmark(
+        f"analysis_ES summary observations (localization={localization})",
+        summary_observations,
+        smoother_update,
+        prior,
+        posterior,
+        prior.experiment.observation_keys,
+        [GEN_KW_NAME],
+        UpdateSettings(),
+        ESSettings(localization=localization),
+        rounds=1,
+    )
+
+
+@scaling_sizes("realizations", [10, 100, 1000, 2000], slow_above=100)
+def test_scaling_of_get_observations_and_responses_with_realizations(
+    scaling_benchmark, storage, tmp_path, realizations
+):
+    prior = create_prior(
+        storage, _summary_case(1000, realizations=realizations), tmp_path
+    )
+    observations = prior.experiment.observation_keys
+    aligned = scaling_benchmark(
+        "get_observations_and_responses realizations",
+        realizations,
+        prior.get_observations_and_responses,
+        observations,
+        np.arange(realizations),
+    )
+    assert aligned.width == 5 + realizations
+
+
+@scaling_sizes("summary_observations", [10**3, 10**4, 10**5], slow_above=10**4)
+def test_scaling_of_get_observations_and_responses_with_observations(
+    scaling_benchmark, storage, tmp_path, summary_observations
+):
+    prior = create_prior(
+        storage, _summary_case(summary_observations, realizations=100), tmp_path
+    )
+    aligned = scaling_benchmark(
+        "get_observations_and_responses summary observations",
+        summary_observations,
+        prior.get_observations_and_responses,
+        prior.experiment.observation_keys,
+        np.arange(100),
+    )
+    observations = prior.experiment.observations.values()
+    assert len(aligned) == sum(len(observation) for observation in observations)
+
+
+@scaling_sizes("summary_keys", [10**2, 10**3, 10**4], slow_above=10**3)
+def test_scaling_of_reading_summary_files(scaling_benchmark, tmp_path, summary_keys):
+    case = SyntheticCase(summary_keys=summary_keys, summary_timesteps=1000)
+    write_summary_files(tmp_path / "CASE", case)
+    _, keys, times, values = scaling_benchmark(
+        "read_summary keys",
+        summary_keys,
+        read_summary,
+        str(tmp_path / "CASE"),
+        ["WOPR:*"],
+    )
+    assert len(keys) == summary_keys
+    assert len(times) == case.summary_timesteps
+    assert values.shape == (summary_keys, case.summary_timesteps)
+
+
+@scaling_sizes("realizations", [10, 100, 1000], slow_above=100)
+def test_scaling_of_create_run_path(
+    scaling_benchmark, storage, tmp_path, monkeypatch, realizations
+):
+    monkeypatch.chdir(tmp_path)
+    Path("coeffs_priors").write_text(
+        "".join(f"COEFF_{i} UNIFORM 0 1\n" for i in range(100)), encoding="utf-8"
+    )
+    Path("template.tmpl").write_text("<IENS> <ITER>\n" * 1000, encoding="utf-8")
+    Path("ECHO").write_text("EXECUTABLE echo\nARGLIST <IENS>\n", encoding="utf-8")
+    forward_model = "FORWARD_MODEL echo\n" * 10
+    ert_config = ErtConfig.from_file_contents(
+        f"NUM_REALIZATIONS {realizations}\n"
+        "GEN_KW COEFFS coeffs_priors\n"
+        "RUN_TEMPLATE template.tmpl result.txt\n"
+        "INSTALL_JOB echo ECHO\n"
+        f"{forward_model}"
+    )
+    experiment = storage.create_experiment(
+        parameters=ert_config.ensemble_config.parameter_configuration
+    )
+    prior = storage.create_ensemble(
+        experiment, name="prior", ensemble_size=realizations
+    )
+    sample_prior(prior, range(realizations))
+    runpaths = Runpaths(
+        jobname_format=ert_config.runpath_config.jobname_format_string,
+        runpath_format=ert_config.runpath_config.runpath_format_string,
+        filename=str(ert_config.runpath_file),
+        substitutions=ert_config.substitutions,
+    )
+    run_args = create_run_arguments(runpaths, [True] * realizations, prior)
+    scaling_benchmark(
+        "create_run_path realizations",
+        realizations,
+        create_run_path,
+        run_args=run_args,
+        ensemble=prior,
+        user_config_file=ert_config.user_config_file,
+        env_vars=ert_config.env_vars,
+        env_pr_fm_step=ert_config.env_pr_fm_step,
+        forward_model_steps=ert_config.forward_model_steps,
+        substitutions=ert_config.substitutions,
+        templates=ert_config.ert_templates,
+        parameters_file="parameters",
+        runpaths=runpaths,
+    )
+    assert (Path(run_args[-1].runpath) / "result.txt").exists()
+
+
+@scaling_sizes("realizations", [10, 100, 1000], slow_above=100)
+def test_scaling_of_dark_storage_records(
+    scaling_benchmark, storage, tmp_path, realizations
+):
+    prior = create_prior(
+        storage,
+        SyntheticCase(realizations=realizations, summary_timesteps=1000),
+        tmp_path,
+    )
+    key = prior.experiment.observations["summary"]["response_key"][0]
+
+    def get_record():
+        return asyncio.run(
+            records.get_ensemble_record(
+                storage=storage,
+                name=key,
+                ensemble_id=prior.id,
+                accept="application/x-parquet",
+            )
+        )
+
+    def get_observations():
+        return asyncio.run(
+            records.get_record_observations(
+                storage=storage, ensemble_id=prior.id, response_name=key
+            )
+        )
+
+    # The records are cached, and it is reading them that is measured
+    cache = get_record_cache()
+    scaling_benchmark(
+        "dark_storage records realizations",
+        realizations,
+        get_record,
+        setup=cache.clear,
+    )
+    assert scaling_benchmark(
+        "dark_storage record observations realizations",
+        realizations,
+        get_observations,
+        setup=cache.clear,
+    )
+
+
+async def _handle_burst_of_events(
+    realizations: int, fm_steps: int, frames: list[bytes]
+) -> EnsembleEvaluator:
+    evaluator = EnsembleEvaluator(
+        TestEnsemble(0, realizations, fm_steps, id_="0"),
+        EvaluatorServerConfig(use_token=False),
+    )
+    # The deadline of the last partial batch is not part of the throughput
+    evaluator._batching_interval = 0.01
+    tasks = [
+        asyncio.create_task(evaluator._batch_events_into_buffer()),
+        asyncio.create_task(evaluator._process_event_buffer()),
+    ]
+    try:
+        for frame in frames:
+            await evaluator.handle_dispatch(b"dispatcher", frame)
+        await evaluator._events.join()
+        await evaluator._complete_batch.wait()
+        await evaluator._batch_processing_queue.join()
+    finally:
+        for task in tasks:
+            task.cancel()
+    return evaluator
+
+
+@scaling_sizes("events", [3_000, 30_000, 300_000], slow_above=30_000)
+def test_scaling_of_ensemble_evaluator_event_throughput(scaling_benchmark, events):
+    fm_steps = 10
+    realizations = events // (3 * fm_steps)
+    frames = [
+        event_to_json(event).encode("utf-8")
+        for real in range(realizations)
+        for step in range(fm_steps)
+        for event in (
+            ForwardModelStepStart(ensemble="0", real=str(real), fm_step=str(step)),
+            ForwardModelStepRunning(
+                ensemble="0",
+                real=str(real),
+                fm_step=str(step),
+                current_memory_usage=1000,
+                max_memory_usage=1000,
+            ),
+            ForwardModelStepSuccess(ensemble="0", real=str(real), fm_step=str(step)),
+        )
+    ]
+    evaluator = scaling_benchmark(
+        "EnsembleEvaluator events",
+        events,
+        lambda: asyncio.run(_handle_burst_of_events(realizations, fm_steps, frames)),
+    )
+    fm_step_snapshots = evaluator.ensemble.snapshot.get_all_fm_steps()
+    assert len(fm_step_snapshots) == realizations * fm_steps
+    assert all(
+        fm_step["status"] == FORWARD_MODEL_STATE_FINISHED
+        for fm_step in fm_step_snapshots.values()
+    )
@@ -1,3 +1,5 @@
+from itertools import count
+
 import pytest
 
 from _ert.events import (
@@ -14,6 +16,8 @@
     FMStepSnapshot,
     RealizationSnapshot,
 )
+from ert.gui.model.snapshot import SnapshotModel
+from tests.ert import SnapshotBuilder
 
 
 @pytest.mark.parametrize(
@@ -92,3 +96,44 @@ def simulate_forward_model_event_handling(
 
     for real in range(ensemble_size):
         snapshot.update_from_event(RealizationSuccess(ensemble=ens_id, real=str(real)))
+
+
+@pytest.mark.parametrize("ensemble_size, forward_models", [(1000, 30), (10000, 10)])
+def test_snapshot_model_update(benchmark, ensemble_size, forward_models):
+    builder = SnapshotBuilder()
+    for fm_idx in range(forward_models):
+        builder.add_fm_step(
+            fm_step_id=str(fm_idx),
+            index=str(fm_idx),
+            name=f"FM_{fm_idx}",
+            status=state.FORWARD_MODEL_STATE_INIT,
+        )
+    model = SnapshotModel()
+    model._add_snapshot(
+        SnapshotModel.prerender(
+            builder.build(
+                [str(real) for real in range(ensemble_size)],
+                state.REALIZATION_STATE_WAITING,
+            )
+        ),
+        "0",
+    )
+    memory_usage = count(1)
+
+    def running_update():
+        memory = next(memory_usage)
+        update = EnsembleSnapshot()
+        for real in range(ensemble_size):
+            update.update_realization(str(real), state.REALIZATION_STATE_RUNNING)
+            update.update_fm_step(
+                str(real),
+                str(memory % forward_models),
+                FMStepSnapshot(
+                    status=state.FORWARD_MODEL_STATE_RUNNING,
+                    current_memory_usage=memory,
+                    max_memory_usage=memory,
+                ),
+            )
+        return (SnapshotModel.prerender(update), "0"), {}
+
+    benchmark.pedantic(model._update_snapshot, setup=running_update, rounds=5)
@@ -277,7 +277,7 @@ def test_that_setenv_sets_environment_variables_in_steps(setenv_config):
     with open("simulations/realization-0/iter-0/jobs.json", encoding="utf-8") as f:
         data = json.load(f)
         global_env = data.get("global_environment")
-        for key in ["_ERT_ENSEMBLE_ID", "_ERT_EXPERIMENT_ID"]:
+        for key in ["_ERT_ENSEMBLE_ID", "_ERT_EXPERIMENT_ID", "TRACEPARENT"]:
             assert key in global_env
             global_env.pop(key)
         assert global_env["_ERT_SIMULATION_MODE"] == TEST_RUN_MODE
@@ -600,6 +600,40 @@ def test_ensemble_smoother():
     )
 
 
+@pytest.mark.parametrize("compact", [True, False])
+@pytest.mark.usefixtures("copy_poly_case")
+def test_that_compact_jobs_json_is_kept_compact_through_the_run(compact):
+    with open("poly.ert", "a", encoding="utf-8") as fout:
+        fout.write(f"QUEUE_OPTION GENERIC COMPACT_JOBS_JSON {compact}\n")
+    run_cli(TEST_RUN_MODE, "--disable-monitoring", "poly.ert")
+
+    jobs_json = Path("poly_out/realization-0/iter-0/jobs.json").read_bytes()
+    assert (b"\n" not in jobs_json) == compact
+    assert json.loads(jobs_json)["dispatch_url"]
+    assert Path("poly_out/realization-0/iter-0/poly.out").exists()
+
+
+@pytest.mark.usefixtures("copy_poly_case")
+def test_that_realizations_submitted_when_their_runpath_is_ready_are_dispatched():
+    with open("poly.ert", "a", encoding="utf-8") as fout:
+        fout.write("QUEUE_OPTION GENERIC SUBMIT_WHEN_RUNPATH_READY True\n")
+    run_cli(
+        ENSEMBLE_EXPERIMENT_MODE,
+        "--disable-monitoring",
+        "--realizations",
+        "0-9",
+        "poly.ert",
+    )
+
+    for iens in range(10):
+        runpath = Path(f"poly_out/realization-{iens}/iter-0")
+        jobs_json = json.loads((runpath / "jobs.json").read_bytes())
+        assert jobs_json["dispatch_url"]
+        assert jobs_json["ens_id"]
+        assert jobs_json["real_id"] == iens
+        assert (runpath / "poly.out").exists()
+
+
 @pytest.mark.usefixtures("copy_poly_case")
 def test_cli_test_run(mock_cli_run):
     run_cli(TEST_RUN_MODE, "--disable-monitoring", "poly.ert")
@@ -1,3 +1,5 @@
+import threading
+import time
 from contextlib import ExitStack as does_not_raise
 from unittest.mock import patch
 
@@ -6,6 +8,7 @@
 import pytest
 import xarray as xr
 import xtgeo
+from iterative_ensemble_smoother.experimental import AdaptiveESMDA
 from tabulate import tabulate
 
 from ert.analysis import (
@@ -14,9 +17,12 @@
     smoother_update,
 )
 from ert.analysis._es_update import (
+    _BatchAssimilator,
     _load_observations_and_responses,
     _load_param_ensemble_array,
+    _pipelined_update,
     _save_param_ensemble_array_to_disk,
+    _streaming_localization,
 )
 from ert.analysis.event import AnalysisCompleteEvent, AnalysisErrorEvent
 from ert.config import ESSettings, Field, GenDataConfig, GenKwConfig, UpdateSettings
@@ -647,8 +653,8 @@ def test_temporary_parameter_storage_with_inactive_fields(
     Tests that when FIELDS with inactive cells are stored in the temporary
     parameter storage the inactive cells are not stored along with the active cells.
 
-    Then test that we restore the inactive cells when saving the temporary
-    parameter storage to disk again.
+    Then test that only the active cells are saved when the temporary
+    parameter storage is written to disk again.
     """
     monkeypatch.chdir(tmp_path)
 
@@ -735,7 +741,10 @@ def test_temporary_parameter_storage_with_inactive_fields(
         ds = xr.open_dataset(
             ensemble._path / f"realization-{iens}" / f"{param_group}.nc", engine="scipy"
         )
-        np.testing.assert_array_equal(ds["values"].values[0], fields[iens]["values"])
+        np.testing.assert_array_equal(
+            ds["values"].values[0],
+            fields[iens]["values"].values[~config.mask].astype(np.float32),
+        )
 
 
 def _mock_load_observations_and_responses(
@@ -1081,3 +1090,208 @@ def test_update_subset_parameters(storage, uniform_parameter, obs):
     assert not prior.load_parameters("PARAMETER", 0)["values"].equals(
         posterior_ens.load_parameters("PARAMETER", 0)["values"]
     )
+
+
+@pytest.mark.parametrize("max_concurrent_groups", [1, 2, 3, 5])
+def test_pipelined_update_bounds_the_number_of_groups_in_memory(
+    max_concurrent_groups,
+):
+    groups = [f"GROUP_{i}" for i in range(8)]
+    lock = threading.Lock()
+    in_memory: set[str] = set()
+    max_in_memory = 0
+    saved = {}
+
+    def load(group):
+        nonlocal max_in_memory
+        with lock:
+            in_memory.add(group)
+            max_in_memory = max(max_in_memory, len(in_memory))
+        return np.full((2, 2), int(group.split("_")[1]), dtype=np.float64)
+
+    def update(group, array):
+        time.sleep(0.01)
+        return array + 1
+
+    def save(group, array):
+        time.sleep(0.02)
+        saved[group] = array
+        with lock:
+            in_memory.remove(group)
+
+    _pipelined_update(
+        groups, load, update, save, max_concurrent_groups, lambda _: None
+    )
+
+    assert max_in_memory <= max_concurrent_groups
+    assert not in_memory
+    assert sorted(saved) == groups
+    for i, group in enumerate(groups):
+        np.testing.assert_equal(saved[group], np.full((2, 2), i + 1))
+
+
+def test_that_errors_while_saving_a_group_in_the_pipeline_are_raised():
+    def save(group, array):
+        raise OSError(f"Could not save {group}")
+
+    with pytest.raises(OSError, match="Could not save A"):
+        _pipelined_update(
+            ["A", "B"],
+            lambda _: np.zeros(1),
+            lambda _, array: array,
+            save,
+            3,
+            lambda _: None,
+        )
+
+
+@pytest.mark.parametrize("processes", [1, 2])
+def test_that_streaming_localization_keeps_only_significant_correlations(processes):
+    rng = np.random.default_rng(42)
+    ensemble_size, num_params, num_obs = 20, 7, 4
+    X = rng.normal(size=(num_params, ensemble_size))
+    Y = rng.normal(size=(num_obs, ensemble_size))
+    Y[:2] += 2 * X[:2]
+    smoother = AdaptiveESMDA(
+        covariance=np.ones(num_obs), observations=np.zeros(num_obs), seed=rng
+    )
+    D = smoother.perturb_observations(ensemble_size=ensemble_size, alpha=1.0)
+    cov_YY = np.atleast_2d(np.cov(Y))
+    threshold = 0.5
+    expected = smoother.assimilate(
+        X=X.copy(),
+        Y=Y,
+        D=D,
+        alpha=1.0,
+        correlation_threshold=threshold,
+        cov_YY=cov_YY,
+    )
+    corr_XY = np.corrcoef(X, Y)[:num_params, num_params:]
+
+    saved = []
+    timed = []
+
+    def progress_callback(iterable):
+        timed.append(iterable)
+        return iterable
+
+    _streaming_localization(
+        X,
+        [np.arange(0, 3), np.arange(3, 6), np.arange(6, 7)],
+        _BatchAssimilator(smoother, Y, D, cov_YY, threshold),
+        processes,
+        lambda batch, idx, params, responses, corr: saved.append(
+            (batch, idx[params], responses, corr)
+        ),
+        progress_callback,
+    )
+
+    np.testing.assert_allclose(X, expected)
+    assert timed
+    saved.sort(key=lambda s: s[0])
+    assert [batch for batch, *_ in saved] == [0, 1, 2]
+    parameters = np.concatenate([p for _, p, _, _ in saved])
+    responses = np.concatenate([r for _, _, r, _ in saved])
+    correlations = np.concatenate([c for *_, c in saved])
+    np.testing.assert_equal(
+        np.stack([parameters, responses]),
+        np.stack(np.nonzero(np.abs(corr_XY) > threshold)),
+    )
+    np.testing.assert_allclose(
+        correlations, corr_XY[parameters, responses], rtol=1e-5
+    )
+
+
+def _prior_with_responses(storage, uniform_parameter, obs):
+    experiment = storage.create_experiment(
+        parameters=[uniform_parameter],
+        responses=[GenDataConfig(keys=["RESPONSE"])],
+        observations={"gen_data": obs},
+    )
+    prior = storage.create_ensemble(
+        experiment, ensemble_size=10, iteration=0, name="prior"
+    )
+    rng = np.random.default_rng(1234)
+    for iens in range(prior.ensemble_size):
+        data = rng.uniform(0, 1)
+        prior.save_parameters(
+            "PARAMETER",
+            iens,
+            xr.Dataset(
+                {
+                    "values": ("names", [data]),
+                    "transformed_values": ("names", [data]),
+                    "names": ["KEY_1"],
+                }
+            ),
+        )
+        prior.save_response(
+            "gen_data",
+            pl.DataFrame(
+                {
+                    "response_key": "RESPONSE",
+                    "report_step": pl.Series([0] * 3, dtype=pl.UInt16),
+                    "index": pl.Series(range(3), dtype=pl.UInt16),
+                    "values": pl.Series(data + rng.uniform(0, 1, 3), dtype=pl.Float32),
+                }
+            ),
+            iens,
+        )
+    return prior
+
+
+@pytest.mark.parametrize("localization", [False, True])
+def test_that_repeated_updates_from_the_same_prior_reuse_the_cached_update(
+    storage, uniform_parameter, obs, localization
+):
+    prior = _prior_with_responses(storage, uniform_parameter, obs)
+    experiment = prior.experiment
+
+    def update(name):
+        posterior = storage.create_ensemble(
+            experiment,
+            ensemble_size=prior.ensemble_size,
+            iteration=1,
+            name=name,
+            prior_ensemble=prior,
+        )
+        rng = np.random.default_rng(42)
+        smoother_update(
+            prior,
+            posterior,
+            ["OBSERVATION"],
+            ["PARAMETER"],
+            UpdateSettings(),
+            ESSettings(localization=localization, cache_update=True),
+            rng=rng,
+        )
+        return posterior, rng.bit_generator.state
+
+    first, first_rng_state = update("first")
+    with patch(
+        "ert.analysis._es_update._load_observations_and_responses",
+        side_effect=AssertionError("The update should have been cached"),
+    ):
+        second, second_rng_state = update("second")
+
+    assert list((second.mount_point / "update_cache").glob("*.npz"))
+    assert first_rng_state == second_rng_state
+    np.testing.assert_allclose(
+        first.load_parameters("PARAMETER")["values"].values,
+        second.load_parameters("PARAMETER")["values"].values,
+    )
+
+
+def test_that_the_update_is_not_cached_by_default(storage, uniform_parameter, obs):
+    prior = _prior_with_responses(storage, uniform_parameter, obs)
+    posterior = storage.create_ensemble(
+        prior.experiment,
+        ensemble_size=prior.ensemble_size,
+        iteration=1,
+        name="posterior",
+        prior_ensemble=prior,
+    )
+    smoother_update(
+        prior, posterior, ["OBSERVATION"], ["PARAMETER"], UpdateSettings(), ESSettings()
+    )
+    assert not (posterior.mount_point / "update_cache").exists()
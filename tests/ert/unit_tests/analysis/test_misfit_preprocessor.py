@@ -1,8 +1,14 @@
 import numpy as np
 import pytest
+from scipy.spatial.distance import pdist
+from scipy.stats import spearmanr
 
 from ert.analysis.misfit_preprocessor import (
+    _spearman_embedding,
+    cluster_responses,
+    cluster_responses_scalable,
     get_nr_primary_components,
+    get_nr_primary_components_scalable,
     get_scaling_factor,
     main,
 )
@@ -51,9 +57,10 @@ def test_that_get_nr_primary_components_is_according_to_theory():
     assert get_nr_primary_components(Y, threshold_3 + 0.01) == 3
 
 
+@pytest.mark.parametrize("method", ["hierarchical", "scalable"])
 @pytest.mark.parametrize("nr_observations", [4, 10, 100])
 @pytest.mark.integration_test
-def test_misfit_preprocessor(nr_observations):
+def test_misfit_preprocessor(nr_observations, method):
     """We create two independent parameters, a and b.
     Using the linear function y = ax.
     a has multiple observations, which are all strongly correlated, while
@@ -70,7 +77,7 @@ def test_misfit_preprocessor(nr_observations):
     obs_errors = Y.mean(axis=1)
     Y_original = Y.copy()
     obs_error_copy = obs_errors.copy()
-    result, *_ = main(Y, obs_errors)
+    result, *_ = main(Y, obs_errors, method)
     np.testing.assert_equal(
         result,
         np.array(
@@ -98,3 +105,73 @@ def test_misfit_preprocessor_single(nr_observations):
         result,
         np.array(nr_observations * [1.0]),
     )
+
+
+@pytest.mark.parametrize(
+    "nr_realizations, nr_observations", [(20, 200), (50, 10), (100, 100)]
+)
+def test_that_scalable_primary_components_match_the_full_svd(
+    nr_realizations, nr_observations
+):
+    rng = np.random.default_rng(1234)
+    latent = rng.standard_normal((nr_realizations, 3))
+    responses = latent @ rng.standard_normal((3, nr_observations))
+    responses += 0.1 * rng.standard_normal(responses.shape)
+    for threshold in [0.5, 0.9, 0.95, 0.99]:
+        assert get_nr_primary_components_scalable(
+            responses, threshold
+        ) == get_nr_primary_components(responses, threshold)
+
+
+def test_that_scalable_clustering_finds_the_same_clusters_as_hierarchical():
+    rng = np.random.default_rng(1234)
+    nr_realizations = 100
+    parameters = rng.standard_normal((4, nr_realizations))
+    cluster_of_observation = np.repeat(np.arange(4), [5, 30, 1, 14])
+    responses = parameters[cluster_of_observation] + 0.05 * rng.standard_normal(
+        (len(cluster_of_observation), nr_realizations)
+    )
+
+    hierarchical = cluster_responses(responses.T, nr_clusters=4)
+    scalable = cluster_responses_scalable(responses.T, nr_clusters=4)
+
+    def partition(clusters):
+        return {frozenset(np.flatnonzero(clusters == c)) for c in np.unique(clusters)}
+
+    assert partition(scalable) == partition(hierarchical)
+    assert partition(scalable) == partition(cluster_of_observation)
+    assert scalable[0] == 1
+
+
+@pytest.mark.parametrize(
+    "nr_realizations, nr_observations", [(20, 200), (50, 10), (100, 100)]
+)
+def test_that_the_spearman_embedding_keeps_the_distances_between_correlations(
+    nr_realizations, nr_observations
+):
+    # Overlapping clusters, where every observation mixes two of the
+    # parameters and is partially correlated with the neighbouring clusters
+    rng = np.random.default_rng(1234)
+    parameters = rng.standard_normal((nr_realizations, 4))
+    cluster_of_observation = rng.integers(0, 4, nr_observations)
+    weights = rng.uniform(0.5, 1.0, nr_observations)
+    responses = (
+        weights * parameters[:, cluster_of_observation]
+        + (1 - weights) * parameters[:, (cluster_of_observation + 1) % 4]
+        + 0.1 * rng.standard_normal((nr_realizations, nr_observations))
+    )
+
+    np.testing.assert_allclose(
+        pdist(_spearman_embedding(responses)),
+        pdist(spearmanr(responses).statistic),
+        atol=1e-8,
+    )
+
+
+@pytest.mark.parametrize("nr_observations", [0, 1, 2])
+def test_that_scalable_auto_scaling_does_not_scale_few_observations(
+    nr_observations,
+):
+    Y = np.ones((nr_observations, 10))
+    result, *_ = main(Y, np.ones(nr_observations), "scalable")
+    np.testing.assert_equal(result, np.ones(nr_observations))
@@ -1,3 +1,4 @@
+import pickle
 from contextlib import suppress
 from pathlib import Path
 
@@ -5,6 +6,8 @@
 import pytest
 from hypothesis import given
 
+from ert.config.parsing.file_context_token import FileContextToken
+from ert.config.parsing.lark_parser import FileContextTransformer
 from ert.config.parsing.observations_parser import (
     GenObsValues,
     HistoryValues,
@@ -12,6 +15,9 @@
     ObservationType,
     Segment,
     SummaryValues,
+    TreeToObservations,
+    _FastObservationParser,
+    _NotFastParsable,
     _parse_content_list,
     _validate_conf_content,
     observations_parser,
@@ -137,6 +143,82 @@ def test_that_double_comments_are_handled():
     ) == [(ObservationType.SUMMARY, "FOPR")]
 
 
+def _with_positions(parsed):
+    if isinstance(parsed, FileContextToken):
+        return (
+            parsed.value,
+            parsed.filename,
+            parsed.start_pos,
+            parsed.line,
+            parsed.column,
+            parsed.end_line,
+            parsed.end_column,
+            parsed.end_pos,
+        )
+    if isinstance(parsed, dict):
+        return [(_with_positions(k), _with_positions(v)) for k, v in parsed.items()]
+    if isinstance(parsed, list | tuple):
+        return [_with_positions(p) for p in parsed]
+    return parsed
+
+
+def _parse_with_lark(contents, filename):
+    return (FileContextTransformer(filename) * TreeToObservations()).transform(
+        observations_parser.parse(contents)
+    )
+
+
+@pytest.mark.integration_test
+@given(observation_contents)
+def test_that_the_fast_parser_gives_the_same_result_as_lark(contents):
+    with suppress(_NotFastParsable):
+        parsed = _FastObservationParser(contents, "obs.txt").parse()
+        assert _with_positions(parsed) == _with_positions(
+            _parse_with_lark(contents, "obs.txt")
+        )
+
+
+def test_that_the_fast_parser_gives_the_same_tokens_as_lark(file_contents):
+    assert _with_positions(
+        _FastObservationParser(file_contents, "obs.txt").parse()
+    ) == _with_positions(_parse_with_lark(file_contents, "obs.txt"))
+
+
+@pytest.mark.parametrize(
+    "contents",
+    [
+        "include a;",
+        "SUMMARY_OBSERVATION FOPR",
+        "SUMMARY_OBSERVATION FOPR {VALUE=1}",
+        "SUMMARY_OBSERVATION SEGMENT;",
+        "HISTORY_OBSERVATION FOPR;\r\n",
+    ],
+)
+def test_that_the_fast_parser_leaves_unusual_content_to_lark(contents):
+    with pytest.raises(_NotFastParsable):
+        _FastObservationParser(contents, "obs.txt").parse()
+
+
+def test_that_tokens_keep_their_position_when_pickled(file_contents):
+    parsed = _parse_content_list(file_contents, "obs.txt")
+    assert _with_positions(pickle.loads(pickle.dumps(parsed))) == _with_positions(
+        parsed
+    )
+
+
+@pytest.mark.usefixtures("use_tmpdir")
+def test_that_cached_observations_are_validated_when_files_are_removed():
+    Path("obs.txt").write_text("1.0 0.1", encoding="utf8")
+    contents = "GENERAL_OBSERVATION OBS {DATA = RESPONSE; OBS_FILE = obs.txt;};"
+    assert parse_content(contents, "observations") == parse_content(
+        contents, "observations"
+    )
+
+    Path("obs.txt").unlink()
+    with pytest.raises(ObservationConfigError, match="did not resolve to a valid"):
+        parse_content(contents, "observations")
+
+
 @pytest.mark.usefixtures("use_tmpdir")
 def test_validate(file_contents):
     Path("wpr_diff_idx.txt").write_text("", encoding="utf8")
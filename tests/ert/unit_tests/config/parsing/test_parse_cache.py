@@ -0,0 +1,87 @@
+import pickle
+import stat
+
+import pytest
+
+from ert.config.parsing.parse_cache import ParseCache
+
+
+def test_that_content_is_parsed_once_and_copies_are_returned():
+    parsed = []
+
+    def parse(content, filename):
+        parsed.append(filename)
+        return {"content": [content]}
+
+    cache = ParseCache()
+    first = cache.get("config", "config.ert", "NUM_REALIZATIONS 1", parse)
+    second = cache.get("config", "config.ert", "NUM_REALIZATIONS 1", parse)
+    assert first == second == {"content": ["NUM_REALIZATIONS 1"]}
+    assert first is not second
+    assert parsed == ["config.ert"]
+
+    cache.get("config", "config.ert", "NUM_REALIZATIONS 2", parse)
+    cache.get("config", "other.ert", "NUM_REALIZATIONS 2", parse)
+    cache.get("observations", "other.ert", "NUM_REALIZATIONS 2", parse)
+    assert parsed == ["config.ert", "config.ert", "other.ert", "other.ert"]
+
+
+def test_that_parse_results_are_shared_through_the_cache_directory(tmp_path):
+    ParseCache(directory=tmp_path).get(
+        "config", "config.ert", "content", lambda content, filename: [content]
+    )
+
+    def parse(content, filename):
+        raise AssertionError("Should have been read from the cache directory")
+
+    assert ParseCache(directory=tmp_path).get(
+        "config", "config.ert", "content", parse
+    ) == ["content"]
+
+
+def test_that_the_least_recently_used_results_are_evicted():
+    parsed = []
+
+    def parse(content, filename):
+        parsed.append(content)
+        return [content]
+
+    cache = ParseCache(max_size=len(pickle.dumps(["a"], pickle.HIGHEST_PROTOCOL)))
+    for content in ["a", "b", "b", "a"]:
+        cache.get("config", "config.ert", content, parse)
+    assert parsed == ["a", "b", "a"]
+
+
+def test_that_the_most_recent_result_is_kept_even_if_larger_than_the_cache():
+    parsed = []
+
+    def parse(content, filename):
+        parsed.append(content)
+        return [content] * 1000
+
+    cache = ParseCache(max_size=1)
+    for content in ["a", "a", "b", "b", "a"]:
+        cache.get("observations", "obs.txt", content, parse)
+    assert parsed == ["a", "b", "a"]
+
+
+@pytest.mark.parametrize("writable", ["file", "directory"])
+def test_that_cached_parses_others_can_write_are_not_unpickled(tmp_path, writable):
+    directory = tmp_path / "cache"
+    ParseCache(directory=directory).get(
+        "config", "config.ert", "content", lambda content, filename: [content]
+    )
+    (cached,) = directory.glob("*.pickle")
+    assert stat.S_IMODE(cached.stat().st_mode) == 0o600
+    (cached if writable == "file" else directory).chmod(0o777)
+
+    parsed = []
+
+    def parse(content, filename):
+        parsed.append(content)
+        return [content]
+
+    assert ParseCache(directory=directory).get(
+        "config", "config.ert", "content", parse
+    ) == ["content"]
+    assert parsed == ["content"]
@@ -344,6 +344,20 @@ def test_misfit_configuration(config, expected):
     assert analysis_config.observation_settings.auto_scale_observations == expected
 
 
+def test_that_auto_scale_method_is_read_from_observation_settings():
+    assert AnalysisConfig.from_dict({}).observation_settings.auto_scale_method == (
+        "hierarchical"
+    )
+    analysis_config = AnalysisConfig.from_dict(
+        {
+            ConfigKeys.ANALYSIS_SET_VAR: [
+                ["OBSERVATIONS", "AUTO_SCALE_METHOD", "SCALABLE"]
+            ],
+        }
+    )
+    assert analysis_config.observation_settings.auto_scale_method == "scalable"
+
+
 @pytest.mark.parametrize(
     "config, expectation",
     [
@@ -351,6 +365,10 @@ def test_misfit_configuration(config, expected):
             [["OBSERVATIONS", "SAUTO_SCALE", "OBS_*"]],
             pytest.raises(ConfigValidationError, match="Unknown variable"),
         ),
+        (
+            [["OBSERVATIONS", "AUTO_SCALE_METHOD", "KMEANS"]],
+            pytest.raises(ConfigValidationError, match="Invalid AUTO_SCALE_METHOD"),
+        ),
         (
             [["NOT_A_THING", "AUTO_SCALE", "OBS_*"]],
             pytest.raises(ConfigValidationError, match="ANALYSIS_SET_VAR NOT_A_THING"),
@@ -1,14 +1,16 @@
 import os
 from pathlib import Path
 
+import numpy as np
 import pytest
 import xtgeo
 
 from ert.config import ConfigValidationError, ConfigWarning, Field
-from ert.config.field import TRANSFORM_FUNCTIONS
+from ert.config.field import TRANSFORM_FUNCTIONS, _field_truncate
 from ert.config.parsing import init_user_config_schema, parse_contents
 from ert.enkf_main import sample_prior
 from ert.field_utils import Shape, read_field
+from ert.storage.ensemble_parameter_store import ParameterLayout
 
 
 def test_write_to_runpath_produces_the_transformed_field_in_storage(
@@ -56,6 +58,83 @@ def test_write_to_runpath_produces_the_transformed_field_in_storage(
         assert not os.path.isfile(f"export/with/path/{real}/permx.grdecl")
 
 
+@pytest.mark.parametrize("layout", list(ParameterLayout))
+def test_writing_fields_to_runpaths_matches_writing_each_realization(
+    snake_oil_field_example, storage, layout
+):
+    ensemble_config = snake_oil_field_example.ensemble_config
+    experiment = storage.create_experiment(
+        parameters=ensemble_config.parameter_configuration
+    )
+    prior_ensemble = storage.create_ensemble(
+        experiment, name="prior", ensemble_size=4, parameter_layout=layout
+    )
+    sample_prior(prior_ensemble, [0, 1, 3])
+    permx_field = ensemble_config["PERMX"]
+    permx_field.output_transformation = "EXP"
+    permx_field.truncation_min = 0.5
+    permx_field.truncation_max = 2.0
+
+    permx_field.write_to_runpaths(
+        {real: Path(f"batch/{real}") for real in [0, 1, 3]}, prior_ensemble
+    )
+    for real in [0, 1, 3]:
+        permx_field.write_to_runpath(Path(f"single/{real}"), real, prior_ensemble)
+        batch, single = (
+            read_field(
+                f"{directory}/{real}/permx.grdecl",
+                "PERMX",
+                permx_field.mask,
+                Shape(permx_field.nx, permx_field.ny, permx_field.nz),
+            )
+            for directory in ("batch", "single")
+        )
+        np.testing.assert_array_equal(batch, single)
+        assert batch.min() >= 0.5
+        assert batch.max() <= 2.0
+
+
+@pytest.mark.parametrize(
+    "min_, max_", [(None, None), (0.0, None), (None, 0.5), (-0.5, 0.5), (1.0, -1.0)]
+)
+def test_field_truncate_matches_truncating_each_value(min_, max_):
+    data = np.array([-1.0, -0.25, 0.0, 0.75, np.nan], dtype=np.float32)
+    expected = [v if max_ is None else min(v, max_) for v in data.tolist()]
+    expected = [v if min_ is None else max(v, min_) for v in expected]
+    np.testing.assert_array_equal(_field_truncate(data, min_, max_), expected)
+
+
+@pytest.mark.parametrize("layout", list(ParameterLayout))
+def test_fields_are_stored_as_active_cells_only(
+    snake_oil_field_example, storage, layout
+):
+    ensemble_config = snake_oil_field_example.ensemble_config
+    experiment = storage.create_experiment(
+        parameters=ensemble_config.parameter_configuration
+    )
+    prior_ensemble = storage.create_ensemble(
+        experiment, name="prior", ensemble_size=3, parameter_layout=layout
+    )
+    sample_prior(prior_ensemble, [0, 1, 2])
+    permx_field = ensemble_config["PERMX"]
+    num_active = np.count_nonzero(~permx_field.mask)
+
+    stored = prior_ensemble.load_parameters("PERMX", 0)["values"]
+    assert stored.dims == ("cells",)
+    assert stored.shape == (num_active,)
+
+    parameters = permx_field.load_parameters(prior_ensemble, np.array([0, 1, 2]))
+    assert parameters.shape == (num_active, 3)
+    assert parameters.dtype == np.float32
+    if layout == ParameterLayout.ENSEMBLE:
+        assert not parameters.flags.writeable
+
+    grid = permx_field._fetch_from_ensemble(1, prior_ensemble)
+    assert grid.shape == permx_field.mask.shape
+    assert np.isnan(grid.values[permx_field.mask]).all()
+    np.testing.assert_equal(grid.values[~permx_field.mask], parameters[:, 1])
+
+
 @pytest.fixture
 def grid_shape():
     return Shape(2, 3, 4)
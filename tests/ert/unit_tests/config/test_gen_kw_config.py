@@ -4,6 +4,7 @@
 from pathlib import Path
 from textwrap import dedent
 
+import numpy as np
 import pytest
 from lark import Token
 
@@ -436,6 +437,50 @@ def test_gen_kw_trans_func(tmpdir, params, xinput, expected):
         assert abs(tf.calculate(xinput, float_args) - expected) < 10**-15
 
 
+def test_that_transform_of_a_block_matches_transforming_each_parameter():
+    definitions = [
+        ("A", "NORMAL", ["1", "2"]),
+        ("B", "LOGNORMAL", ["0", "0.5"]),
+        ("C", "TRUNCATED_NORMAL", ["0", "1", "-0.5", "0.5"]),
+        ("D", "TRIANGULAR", ["0", "1", "3"]),
+        ("E", "UNIFORM", ["-1", "1"]),
+        ("F", "DUNIF", ["5", "0", "1"]),
+        ("G", "ERRF", ["1", "2", "0.1", "0.9"]),
+        ("H", "DERRF", ["4", "1", "2", "0.1", "0.9"]),
+        ("I", "DERRF", ["7", "1", "2", "0.0", "1.2"]),
+        ("J", "LOGUNIF", ["0.1", "10"]),
+        ("K", "CONST", ["3.5"]),
+        ("L", "RAW", []),
+        ("M", "NORMAL", ["-1", "0.1"]),
+    ]
+    gkw = GenKwConfig(
+        name="MY_PARAM",
+        forward_init=False,
+        update=False,
+        template_file=None,
+        output_file=None,
+        transform_function_definitions=[
+            TransformFunctionDefinition(name, distribution, values)
+            for name, distribution, values in definitions
+        ],
+    )
+    x = np.random.default_rng(42).standard_normal((len(definitions), 50))
+    x_copy = x.copy()
+
+    transformed = gkw.transform(x)
+
+    assert transformed.shape == x.shape
+    np.testing.assert_equal(x, x_copy)
+    for index, tf in enumerate(gkw.transform_functions):
+        arg = list(tf.parameter_list.values())
+        np.testing.assert_allclose(
+            transformed[index],
+            [tf.calculate(value, arg) for value in x[index]],
+            rtol=1e-14,
+        )
+    np.testing.assert_allclose(gkw.transform(x[:, 7]), transformed[:, 7], rtol=1e-14)
+
+
 def test_gen_kw_objects_equal(tmpdir):
     with tmpdir.as_cwd():
         with open("template.txt", "w", encoding="utf-8") as fh:
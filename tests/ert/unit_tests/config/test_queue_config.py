@@ -296,6 +296,18 @@ def test_wrong_max_submit_raises_validation_error(max_submit_value, error_msg):
         )
 
 
+@pytest.mark.parametrize("queue_system", ["LOCAL", "LSF", "SLURM", "TORQUE"])
+def test_compact_jobs_json_is_a_generic_queue_option(queue_system):
+    queue_config = ErtConfig.from_file_contents(
+        "NUM_REALIZATIONS 1\n"
+        f"QUEUE_SYSTEM {queue_system}\n"
+        "QUEUE_OPTION GENERIC COMPACT_JOBS_JSON True\n"
+    ).queue_config
+    assert queue_config.compact_jobs_json
+    assert queue_config.create_local_copy().compact_jobs_json
+    assert "compact_jobs_json" not in queue_config.queue_options.driver_options
+
+
 @pytest.mark.parametrize(
     "queue_system, key, value",
     [
@@ -3,16 +3,27 @@
 from itertools import zip_longest
 
 import hypothesis.strategies as st
+import numpy as np
 import pytest
 import resfo
 from hypothesis import given
 from resdata.summary import Summary, SummaryVarType
 
 from ert.config import InvalidResponseFile
-from ert.config._read_summary import make_summary_key, read_summary
+from ert.config._read_summary import (
+    DateUnit,
+    _read_summary_records,
+    _read_unformatted_summary,
+    _UnsupportedLayoutError,
+    make_summary_key,
+    read_summary,
+)
 from ert.summary_key_type import SummaryKeyType
 
 from .summary_generator import (
+    SummaryMiniStep,
+    SummaryStep,
+    Unsmry,
     inter_region_summary_variables,
     summaries,
     summary_variables,
@@ -485,3 +496,122 @@ def test_that_ambiguous_case_restart_raises_an_informative_error(tmp_path):
         match="Ambiguous reference to unified summary",
     ):
         read_summary(str(tmp_path / "test"), ["*"])
+
+
+def _large_unsmry(nr_params: int, nr_steps: int, ministeps: int = 1) -> Unsmry:
+    rng = np.random.default_rng(0)
+    return Unsmry(
+        steps=[
+            SummaryStep(
+                seqnum=step,
+                ministeps=[
+                    SummaryMiniStep(
+                        mini_step=step * ministeps + ministep,
+                        params=[
+                            step + ministep / ministeps,
+                            *rng.random(nr_params - 1, dtype=np.float32),
+                        ],
+                    )
+                    for ministep in range(ministeps)
+                ],
+            )
+            for step in range(nr_steps)
+        ]
+    )
+
+
+@given(summaries())
+def test_that_reading_unformatted_summaries_by_memory_mapping_is_the_same_as_by_records(
+    tmp_path_factory, summary
+):
+    tmp_path = tmp_path_factory.mktemp("summary")
+    smspec, unsmry = summary
+    unsmry.to_file(tmp_path / "TEST.UNSMRY")
+    indices = np.arange(len(smspec.keywords), dtype=np.int64)
+    unit = DateUnit[smspec.units[0].strip()]
+    start_date = smspec.start_date.to_datetime()
+    args = (str(tmp_path / "TEST.UNSMRY"), start_date, unit, indices, 0)
+
+    expected_values, expected_dates = _read_summary_records(*args)
+    try:
+        values, dates = _read_unformatted_summary(*args)
+    except _UnsupportedLayoutError:
+        # Files without any PARAMS are only read record by record
+        assert not any(step.ministeps for step in unsmry.steps)
+        return
+    np.testing.assert_array_equal(values, expected_values)
+    assert dates == expected_dates
+
+
+@pytest.mark.parametrize("unit", [DateUnit.DAYS, DateUnit.HOURS])
+def test_that_memory_mapped_reading_handles_params_spanning_several_blocks(
+    tmp_path, unit
+):
+    unsmry = _large_unsmry(nr_params=2500, nr_steps=30, ministeps=3)
+    unsmry.to_file(tmp_path / "TEST.UNSMRY")
+    indices = np.array([2499, 1, 999, 1000, 1001, 2000], dtype=np.int64)
+    args = (str(tmp_path / "TEST.UNSMRY"), datetime(2010, 1, 1), unit, indices, 0)
+
+    values, dates = _read_unformatted_summary(*args)
+    expected_values, expected_dates = _read_summary_records(*args)
+
+    assert values.shape == (len(indices), 30)
+    np.testing.assert_array_equal(values, expected_values)
+    np.testing.assert_array_equal(
+        values[:, 3],
+        np.array(unsmry.steps[3].ministeps[-1].params, dtype=np.float32)[indices],
+    )
+    assert dates == expected_dates
+
+
+def test_that_summaries_not_in_blocks_of_1000_are_read_record_by_record(tmp_path):
+    def record(keyword: bytes, data_type: bytes, blocks: list[bytes]) -> bytes:
+        length = sum(len(block) for block in blocks) // 4
+        header = keyword + length.to_bytes(4, "big") + data_type
+        marker = len(header).to_bytes(4, "big")
+        return (
+            marker
+            + header
+            + marker
+            + b"".join(
+                len(block).to_bytes(4, "big") + block + len(block).to_bytes(4, "big")
+                for block in blocks
+            )
+        )
+
+    values = np.arange(1500, dtype=">f4")
+    (tmp_path / "TEST.UNSMRY").write_bytes(
+        record(b"SEQHDR  ", b"INTE", [b"\x00" * 4])
+        + record(b"PARAMS  ", b"REAL", [values[:500].tobytes(), values[500:].tobytes()])
+    )
+    args = (
+        str(tmp_path / "TEST.UNSMRY"),
+        datetime(2010, 1, 1),
+        DateUnit.DAYS,
+        np.array([0, 1200], dtype=np.int64),
+        0,
+    )
+
+    with pytest.raises(_UnsupportedLayoutError):
+        _read_unformatted_summary(*args)
+    fetched, _ = _read_summary_records(*args)
+    np.testing.assert_array_equal(fetched, [[0.0], [1200.0]])
+
+
+@pytest.mark.parametrize(
+    "read", [_read_unformatted_summary, _read_summary_records], ids=["mmap", "records"]
+)
+def test_benchmark_reading_large_summary(tmp_path, benchmark, read):
+    _large_unsmry(nr_params=5000, nr_steps=500).to_file(tmp_path / "TEST.UNSMRY")
+    indices = np.arange(0, 5000, 7, dtype=np.int64)
+
+    values, dates = benchmark(
+        read,
+        str(tmp_path / "TEST.UNSMRY"),
+        datetime(2010, 1, 1),
+        DateUnit.DAYS,
+        indices,
+        0,
+    )
+    assert values.shape == (len(indices), 500)
+    assert len(dates) == 500
@@ -0,0 +1,121 @@
+import numpy as np
+import polars as pl
+import pytest
+
+from ert.config import GenDataConfig, GenKwConfig
+from ert.config.gen_kw_config import TransformFunctionDefinition
+from ert.dark_storage.cache import RecordCache, neighbouring_keys
+from ert.storage import open_storage
+from ert.storage.ensemble_parameter_store import ParameterLayout
+
+
+@pytest.fixture
+def ensemble(tmp_path):
+    with open_storage(tmp_path / "storage", mode="w") as storage:
+        experiment = storage.create_experiment(responses=[GenDataConfig(keys=["WOPR"])])
+        yield experiment.create_ensemble(name="ensemble", ensemble_size=2)
+
+
+def test_that_records_are_computed_once_until_the_ensemble_changes(ensemble):
+    computed = []
+
+    def compute(ensemble, key):
+        computed.append(key)
+        return np.zeros(10)
+
+    cache = RecordCache()
+    first = cache.get(ensemble, "records", "WOPR", compute)
+    assert cache.get(ensemble, "records", "WOPR", compute) is first
+    assert computed == ["WOPR"]
+
+    ensemble.save_response(
+        "gen_data",
+        pl.DataFrame(
+            {
+                "response_key": ["WOPR"],
+                "report_step": pl.Series([0], dtype=pl.UInt16),
+                "index": pl.Series([0], dtype=pl.UInt16),
+                "values": pl.Series([1.0], dtype=pl.Float32),
+            }
+        ),
+        1,
+    )
+    cache.get(ensemble, "records", "WOPR", compute)
+    assert computed == ["WOPR", "WOPR"]
+
+
+def test_that_records_are_computed_again_after_parameters_are_written_in_place(
+    tmp_path,
+):
+    parameter = GenKwConfig(
+        name="PARAMETER",
+        forward_init=False,
+        template_file="",
+        transform_function_definitions=[
+            TransformFunctionDefinition("KEY", "UNIFORM", [0, 1]),
+        ],
+        output_file="kw.txt",
+        update=True,
+    )
+    computed = []
+
+    def compute(ensemble, key):
+        computed.append(key)
+        return np.array(parameter.load_parameters(ensemble, np.array([0])))
+
+    with open_storage(tmp_path / "storage", mode="w") as storage:
+        experiment = storage.create_experiment(parameters=[parameter])
+        ensemble = storage.create_ensemble(
+            experiment,
+            name="ensemble",
+            ensemble_size=1,
+            parameter_layout=ParameterLayout.ENSEMBLE,
+        )
+        cache = RecordCache()
+        # The state file is only written when the context exits, so the
+        # parameters written in place are all that changes in between
+        with storage.write_behind_context():
+            parameter.save_parameters(ensemble, 0, np.array([1.0]))
+            np.testing.assert_equal(
+                cache.get(ensemble, "parameters", "KEY", compute), [[1.0]]
+            )
+            parameter.save_parameters(ensemble, 0, np.array([2.0]))
+            np.testing.assert_equal(
+                cache.get(ensemble, "parameters", "KEY", compute), [[2.0]]
+            )
+        assert computed == ["KEY", "KEY"]
+
+
+def test_that_the_least_recently_used_records_are_evicted(ensemble):
+    cache = RecordCache(max_size=2 * 80)
+
+    def compute(ensemble, key):
+        return np.zeros(10)
+
+    for key in ["A", "B"]:
+        cache.get(ensemble, "records", key, compute)
+    cache.get(ensemble, "records", "A", compute)
+    cache.get(ensemble, "records", "C", compute)
+
+    assert (ensemble.id, "records", "A") in cache
+    assert (ensemble.id, "records", "B") not in cache
+    assert (ensemble.id, "records", "C") in cache
+    assert cache.size == 2 * 80
+
+
+def test_that_neighbouring_keys_are_prefetched(ensemble):
+    keys = ["A", "B", "C", "D", "E", "F"]
+    assert neighbouring_keys(keys, "C") == ["D", "E", "B", "A"]
+    assert neighbouring_keys(keys, "UNKNOWN") == []
+
+    cache = RecordCache()
+    cache.prefetch(
+        ensemble,
+        "records",
+        neighbouring_keys(keys, "A"),
+        lambda ensemble, key: np.zeros(1),
+    )
+    cache._executor.shutdown(wait=True)
+    assert (ensemble.id, "records", "B") in cache
+    assert (ensemble.id, "records", "C") in cache
+    assert (ensemble.id, "records", "D") not in cache
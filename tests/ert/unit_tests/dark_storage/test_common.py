@@ -5,7 +5,7 @@
 import pytest
 
 from ert.config import GenDataConfig, SummaryConfig
-from ert.dark_storage.common import data_for_key
+from ert.dark_storage.common import data_for_key, records_for_key
 from ert.storage import open_storage
 from tests.ert.unit_tests.config.summary_generator import (
     Date,
@@ -129,3 +129,47 @@ def test_data_for_key_returns_empty_gen_data_config(tmp_path):
         ensemble.refresh_ensemble_state()
         data = data_for_key(ensemble, "response@0")
         assert not data.empty
+
+
+def test_records_for_key_are_the_data_for_key_without_pandas(tmp_path):
+    with open_storage(tmp_path / "storage", mode="w") as storage:
+        summary_config = SummaryConfig(
+            name="summary", input_files=["CASE"], keys=["FOPR", "FGPR"]
+        )
+        experiment = storage.create_experiment(responses=[summary_config])
+        ensemble = experiment.create_ensemble(name="ensemble", ensemble_size=2)
+        dates = [
+            datetime.datetime(2000, 1, 2),
+            datetime.datetime(2000, 1, 1),
+            datetime.datetime(2000, 1, 2),
+        ]
+        for realization in range(2):
+            ensemble.save_response(
+                "summary",
+                pl.DataFrame(
+                    {
+                        "response_key": ["FOPR", "FGPR", "FOPR", "FOPR"],
+                        "time": pl.Series(
+                            [dates[0], dates[0], dates[1], dates[2]],
+                            dtype=pl.Datetime("ms"),
+                        ),
+                        "values": pl.Series(
+                            [1.0, 5.0, 2.0, 3.0 + realization], dtype=pl.Float32
+                        ),
+                    }
+                ),
+                realization,
+            )
+        ensemble.refresh_ensemble_state()
+
+        records = records_for_key(ensemble, "FOPR")
+        assert records.columns == [
+            "Realization",
+            "2000-01-01 00:00:00",
+            "2000-01-02 00:00:00",
+        ]
+        assert records.rows() == [(0, 2.0, 2.0), (1, 2.0, 2.5)]
+        data = data_for_key(ensemble, "FOPR")
+        assert data.index.tolist() == records["Realization"].to_list()
+        assert data.values.tolist() == records.drop("Realization").rows()
+        assert records_for_key(ensemble, "FOPRH").is_empty()
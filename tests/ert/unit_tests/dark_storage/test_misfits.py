@@ -0,0 +1,67 @@
+import numpy as np
+import polars as pl
+import pytest
+
+from ert.config import GenDataConfig
+from ert.dark_storage.compute.misfits import (
+    calculate_misfits,
+    misfits_for_response,
+    summarize_misfits,
+)
+from ert.storage import open_storage
+
+
+def test_that_misfits_are_signed_squared_differences_in_units_of_the_error():
+    misfits = calculate_misfits(
+        np.array([1.0, 2.0]),
+        np.array([0.5, 2.0]),
+        np.array([[0.0, 1.5, 1.0], [6.0, 2.0, np.nan]]),
+    )
+    np.testing.assert_equal(misfits, [[-4.0, 1.0, 0.0], [4.0, 0.0, np.nan]])
+
+
+def test_misfits_for_response_uses_the_observations_of_the_report_step(tmp_path):
+    observations = pl.DataFrame(
+        {
+            "observation_key": ["OBS1", "OBS1", "OBS2"],
+            "response_key": ["R1", "R1", "R1"],
+            "report_step": pl.Series([0, 0, 1], dtype=pl.UInt16),
+            "index": pl.Series([1, 0, 0], dtype=pl.UInt16),
+            "observations": pl.Series([2.0, 1.0, 3.0], dtype=pl.Float32),
+            "std": pl.Series([0.5, 0.5, 1.0], dtype=pl.Float32),
+        }
+    )
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(
+            responses=[GenDataConfig(keys=["R1"], report_steps_list=[[0, 1]])],
+            observations={"gen_data": observations},
+        )
+        ensemble = storage.create_ensemble(experiment, ensemble_size=3, name="prior")
+        for realization in range(3):
+            ensemble.save_response(
+                "gen_data",
+                pl.DataFrame(
+                    {
+                        "response_key": ["R1", "R1", "R1"],
+                        "report_step": pl.Series([0, 0, 1], dtype=pl.UInt16),
+                        "index": pl.Series([0, 1, 0], dtype=pl.UInt16),
+                        "values": pl.Series(
+                            np.array([1.0, 2.0, 3.0]) * realization, dtype=pl.Float32
+                        ),
+                    }
+                ),
+                realization,
+            )
+
+        misfits = misfits_for_response(ensemble, "R1@0")
+        assert list(misfits.columns) == [0, 1]
+        assert list(misfits.index) == [0, 1, 2]
+        np.testing.assert_allclose(
+            misfits.to_numpy(), [[-4.0, -16.0], [0.0, 0.0], [4.0, 16.0]]
+        )
+        assert summarize_misfits(misfits)[0].to_list() == pytest.approx(
+            [20.0, 0.0, 20.0]
+        )
+
+        with pytest.raises(ValueError, match="No observations for key R1@2"):
+            misfits_for_response(ensemble, "R1@2")
@@ -18,6 +18,7 @@
     EnsembleSucceeded,
     ForwardModelStepFailure,
     ForwardModelStepRunning,
+    ForwardModelStepStart,
     ForwardModelStepSuccess,
     Id,
     RealizationSuccess,
@@ -31,6 +32,8 @@
     HEARTBEAT_MSG,
     Client,
 )
+from ert.config import QueueConfig
+from ert.config.queue_config import LocalQueueOptions
 from ert.ensemble_evaluator import (
     EnsembleEvaluator,
     EnsembleSnapshot,
@@ -38,7 +41,12 @@
     Monitor,
 )
 from ert.ensemble_evaluator._ensemble import LegacyEnsemble
-from ert.ensemble_evaluator.evaluator import detect_overspent_cpu
+from ert.ensemble_evaluator.evaluator import (
+    _Subscription,
+    coalesce_fm_step_running,
+    detect_overspent_cpu,
+)
+from ert.ensemble_evaluator.snapshot_delta import SNAPSHOT_DELTA_PREFIX
 from ert.ensemble_evaluator.state import (
     ENSEMBLE_STATE_STARTED,
     ENSEMBLE_STATE_STOPPED,
@@ -101,6 +109,96 @@ async def test_evaluator_handles_dispatchers_connected(
     assert evaluator._dispatchers_empty.is_set()
 
 
+@pytest.mark.parametrize("predictive_scheduling", [True, False])
+async def test_that_resource_usage_is_only_sent_to_the_scheduler_when_predicting(
+    make_ee_config, predictive_scheduling
+):
+    ensemble = TestEnsemble(0, 2, 2, id_="0")
+    ensemble._queue_config = QueueConfig(
+        queue_options=LocalQueueOptions(predictive_scheduling=predictive_scheduling)
+    )
+    evaluator = EnsembleEvaluator(ensemble, make_ee_config())
+
+    for event in [
+        ForwardModelStepStart(ensemble="0", real="0", fm_step="0"),
+        ForwardModelStepRunning(ensemble="0", real="0", fm_step="0"),
+        ForwardModelStepSuccess(ensemble="0", real="0", fm_step="0"),
+    ]:
+        await evaluator.handle_dispatch(
+            b"dispatcher-1", event_to_json(event).encode("utf-8")
+        )
+
+    forwarded = []
+    while not evaluator._manifest_queue.empty():
+        forwarded.append(type(evaluator._manifest_queue.get_nowait()))
+    assert forwarded == (
+        [ForwardModelStepStart, ForwardModelStepRunning, ForwardModelStepSuccess]
+        if predictive_scheduling
+        else [ForwardModelStepSuccess]
+    )
+
+
+async def test_that_batches_are_flushed_when_full(make_ee_config):
+    evaluator = EnsembleEvaluator(TestEnsemble(0, 2, 2, id_="0"), make_ee_config())
+    evaluator._batching_interval = 60
+    evaluator._max_batch_size = 3
+    batcher = asyncio.create_task(evaluator._batch_events_into_buffer())
+    try:
+        for real in range(4):
+            await evaluator._events.put(
+                ForwardModelStepRunning(ensemble="0", real=str(real), fm_step="0")
+            )
+        batch = await asyncio.wait_for(
+            evaluator._batch_processing_queue.get(), timeout=5
+        )
+        assert [event.real for _, event in batch] == ["0", "1", "2"]
+        assert not evaluator._complete_batch.is_set()
+    finally:
+        batcher.cancel()
+
+
+async def test_that_batches_are_flushed_at_the_deadline(make_ee_config):
+    evaluator = EnsembleEvaluator(TestEnsemble(0, 2, 2, id_="0"), make_ee_config())
+    evaluator._batching_interval = 0.05
+    batcher = asyncio.create_task(evaluator._batch_events_into_buffer())
+    try:
+        await asyncio.sleep(0.2)
+        # Nothing is flushed while there are no events
+        assert evaluator._batch_processing_queue.empty()
+        assert evaluator._complete_batch.is_set()
+
+        await evaluator._events.put(
+            ForwardModelStepRunning(ensemble="0", real="0", fm_step="0")
+        )
+        batch = await asyncio.wait_for(
+            evaluator._batch_processing_queue.get(), timeout=5
+        )
+        assert len(batch) == 1
+        await asyncio.sleep(0)
+        assert evaluator._complete_batch.is_set()
+    finally:
+        batcher.cancel()
+
+
+def test_that_running_events_for_the_same_step_are_coalesced():
+    events = [
+        ForwardModelStepRunning(
+            ensemble="0", real="0", fm_step="0", current_memory_usage=1
+        ),
+        ForwardModelStepRunning(
+            ensemble="0", real="0", fm_step="1", current_memory_usage=2
+        ),
+        ForwardModelStepRunning(
+            ensemble="0", real="0", fm_step="0", current_memory_usage=3
+        ),
+        ForwardModelStepSuccess(ensemble="0", real="0", fm_step="0"),
+        ForwardModelStepRunning(
+            ensemble="0", real="1", fm_step="0", current_memory_usage=4
+        ),
+    ]
+    assert coalesce_fm_step_running(events) == events[1:]
+
+
 async def test_evaluator_raises_on_start_with_address_in_use(make_ee_config):
     ee_config = make_ee_config(use_ipc_protocol=False)
     ctx = zmq.asyncio.Context()
@@ -416,6 +514,66 @@ async def mock_receiver(self):
     )
 
 
+@pytest.mark.integration_test
+@pytest.mark.timeout(20)
+async def test_subscribed_monitor_receives_snapshot_deltas(evaluator_to_use):
+    evaluator = evaluator_to_use
+    token = evaluator._config.token
+    url = evaluator._config.get_uri()
+    frames: list[bytes] = []
+    process_message = Monitor.process_message
+
+    async def recording_process_message(self, msg):
+        frames.append(msg)
+        await process_message(self, msg)
+
+    with patch.object(Monitor, "process_message", recording_process_message):
+        async with Monitor(url, token, snapshot_update_interval=0.0) as monitor:
+            events = monitor.track()
+            snapshot = EnsembleSnapshot.from_nested_dict((await anext(events)).snapshot)
+            async with Client(url, token=token) as dispatch:
+                await dispatch.send(
+                    event_to_json(
+                        ForwardModelStepRunning(
+                            ensemble=evaluator.ensemble.id_,
+                            real="1",
+                            fm_step="0",
+                            current_memory_usage=1000,
+                        )
+                    )
+                )
+            async for event in events:
+                assert type(event) is EESnapshotUpdate
+                snapshot.update_from_event(event)
+                if (
+                    snapshot.get_fm_step("1", "0").get("status")
+                    == FORWARD_MODEL_STATE_RUNNING
+                ):
+                    break
+            await monitor.signal_done()
+
+    assert snapshot.get_fm_step("1", "0")["current_memory_usage"] == 1000
+    assert any(frame.startswith(SNAPSHOT_DELTA_PREFIX) for frame in frames)
+
+
+def test_that_subscriptions_merge_updates_until_the_interval_has_passed():
+    subscription = _Subscription(update_interval=1.0)
+    assert subscription.due(0.0) is None
+
+    for fm_step_id, status in [("0", "Running"), ("1", "Running"), ("0", "Finished")]:
+        update = EnsembleSnapshot()
+        update.update_fm_step("0", fm_step_id, FMStepSnapshot(status=status))
+        subscription.add(update)
+    subscription.last_sent = 10.0
+
+    assert subscription.due(10.25) == 0.75
+    assert subscription.due(11.5) == 0.0
+    assert subscription.pending.get_fm_steps_for_all_reals() == {
+        ("0", "0"): "Finished",
+        ("0", "1"): "Running",
+    }
+
+
 async def test_dispatch_endpoint_clients_can_connect_and_monitor_can_shut_down_evaluator(
     evaluator_to_use,
 ):
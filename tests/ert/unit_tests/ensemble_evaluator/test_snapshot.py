@@ -1,13 +1,24 @@
+import copy
 from datetime import datetime
 
 from _ert.events import (
+    EESnapshotUpdate,
     ForwardModelStepFailure,
     ForwardModelStepRunning,
+    ForwardModelStepStart,
     ForwardModelStepSuccess,
+    RealizationResubmit,
+    RealizationRunning,
     RealizationSuccess,
+    event_from_json,
+    event_to_json,
 )
 from ert.ensemble_evaluator import state
 from ert.ensemble_evaluator.snapshot import EnsembleSnapshot, FMStepSnapshot
+from ert.ensemble_evaluator.snapshot_delta import (
+    decode_snapshot_update,
+    encode_snapshot_update,
+)
 from tests.ert import SnapshotBuilder
 
 
@@ -100,3 +111,103 @@ def test_that_realization_success_message_updates_state():
     assert (
         snapshot.to_dict()["reals"]["0"]["status"] == state.REALIZATION_STATE_FINISHED
     )
+
+
+def _snapshot_update(snapshot, events):
+    update = EnsembleSnapshot()
+    for event in events:
+        update.update_from_event(event, source_snapshot=snapshot)
+    return update
+
+
+_EVENTS = [
+    RealizationRunning(ensemble="1", real="0", exec_hosts="host"),
+    ForwardModelStepStart(
+        ensemble="1", real="0", fm_step="0", std_out="stdout", std_err="stderr"
+    ),
+    ForwardModelStepRunning(
+        ensemble="1",
+        real="0",
+        fm_step="0",
+        current_memory_usage=5,
+        max_memory_usage=6,
+        cpu_seconds=0.5,
+    ),
+    ForwardModelStepFailure(ensemble="1", real="3", fm_step="1", error_msg="fail"),
+    ForwardModelStepSuccess(ensemble="1", real="9", fm_step="2"),
+    RealizationSuccess(ensemble="1", real="9"),
+    RealizationResubmit(ensemble="1", real="3"),
+]
+
+
+def test_that_snapshot_delta_merges_like_the_snapshot_update_event(snapshot):
+    update = _snapshot_update(snapshot, _EVENTS)
+    update._ensemble_state = state.ENSEMBLE_STATE_STARTED
+
+    json_event = event_from_json(
+        event_to_json(EESnapshotUpdate(snapshot=update.to_dict(), ensemble="1"))
+    )
+    delta_event = decode_snapshot_update(encode_snapshot_update(update, "1"))
+    assert delta_event.ensemble == "1"
+
+    from_json = copy.deepcopy(snapshot)
+    from_json.merge_snapshot(EnsembleSnapshot().update_from_event(json_event))
+    from_delta = copy.deepcopy(snapshot)
+    from_delta.merge_snapshot(EnsembleSnapshot().update_from_event(delta_event))
+
+    assert from_delta == from_json
+    assert from_delta.status == state.ENSEMBLE_STATE_STARTED
+    assert from_delta.get_fm_step("3", "1")["status"] == (
+        state.FORWARD_MODEL_STATE_INIT
+    )
+
+
+def test_that_snapshot_delta_is_smaller_than_the_snapshot_update_event(snapshot):
+    update = _snapshot_update(snapshot, _EVENTS)
+    json_event = event_to_json(
+        EESnapshotUpdate(snapshot=update.to_dict(), ensemble="1")
+    ).encode("utf-8")
+    assert len(encode_snapshot_update(update, "1")) < len(json_event) / 2
+
+
+def test_that_snapshot_delta_keeps_ids_and_statuses_that_are_not_interned():
+    update = EnsembleSnapshot()
+    update.update_realization("real-a", "Custom status")
+    update.update_fm_step("007", "step", FMStepSnapshot(status="Other"))
+
+    decoded = decode_snapshot_update(encode_snapshot_update(update, None))
+    assert decoded.snapshot == {
+        "reals": {
+            "real-a": {"status": "Custom status"},
+            "007": {"fm_steps": {"step": {"status": "Other"}}},
+        }
+    }
+
+
+def test_that_changes_from_only_keeps_changed_fields(snapshot):
+    snapshot.update_fm_step(
+        "0", "0", FMStepSnapshot(status=state.FORWARD_MODEL_STATE_RUNNING)
+    )
+    update = EnsembleSnapshot()
+    update.update_fm_step(
+        "0",
+        "0",
+        FMStepSnapshot(
+            status=state.FORWARD_MODEL_STATE_RUNNING,
+            index="0",
+            current_memory_usage=10,
+        ),
+    )
+    update.update_fm_step(
+        "0", "1", FMStepSnapshot(status="Unknown", index="1", name="forward_model1")
+    )
+    update.update_realization("1", "Unknown")
+    update._ensemble_state = snapshot.status
+
+    changes = update.changes_from(snapshot)
+    assert changes.get_all_fm_steps() == {("0", "0"): {"current_memory_usage": 10}}
+    assert not changes.reals
+    assert changes.status is None
+
+    merged = copy.deepcopy(snapshot).merge_snapshot(update)
+    assert copy.deepcopy(snapshot).merge_snapshot(changes) == merged
@@ -100,3 +100,54 @@ def test_that_text_export_and_import_are_inverses(array, name, tmp_path):
         atol=1e-6,
     )
     assert not np.isnan(result).any()
+
+
+@pytest.mark.parametrize("chunk_size", [1, 7, 1 << 24])
+def test_that_grdecl_import_expands_repeats_and_skips_comments(tmp_path, chunk_size):
+    (tmp_path / "test.grdecl").write_text(
+        "-- A comment\n"
+        "OTHER\n 9 9 /\n"
+        "PORO -- values on the keyword line are ignored 5\n"
+        " 1.0 3*0.5 -- a comment 7 /\n"
+        "2*1e-1\n"
+        " -2.5E+01 /\n"
+        "PERMX\n 1 /\n",
+        encoding="utf-8",
+    )
+    values = import_grdecl(
+        tmp_path / "test.grdecl", "PORO", (7, 1, 1), chunk_size=chunk_size
+    )
+    assert values.dtype == np.float32
+    assert_allclose(values.ravel(), [1.0, 0.5, 0.5, 0.5, 0.1, 0.1, -25.0])
+
+
+def test_that_grdecl_import_reads_values_in_fortran_order(tmp_path):
+    (tmp_path / "test.grdecl").write_text("PORO\n 0 1 2 3 4 5 /\n")
+    values = import_grdecl(tmp_path / "test.grdecl", "PORO", (1, 2, 3))
+    np.testing.assert_equal(values, np.arange(6).reshape((1, 2, 3), order="F"))
+
+
+def test_that_grdecl_import_with_wrong_number_of_values_fails(tmp_path):
+    (tmp_path / "test.grdecl").write_text("PORO\n 1 2*2 /\n")
+    with pytest.raises(ValueError, match="PORO .* has 3 values, expected 2"):
+        import_grdecl(tmp_path / "test.grdecl", "PORO", (2, 1, 1))
+
+
+def test_that_grdecl_import_with_non_numeric_values_fails(tmp_path):
+    (tmp_path / "test.grdecl").write_text("PORO\n 1 abc /\n")
+    with pytest.raises(ValueError, match="Could not read values of PORO"):
+        import_grdecl(tmp_path / "test.grdecl", "PORO", (2, 1, 1))
+
+
+@pytest.mark.parametrize("size", [1, 5, 6, 7, 60001])
+def test_that_text_export_writes_six_values_per_line(tmp_path, size):
+    values = np.linspace(-1, 1, size, dtype=np.float32)
+    export_grdecl(values.reshape((size, 1, 1)), tmp_path / "test.grdecl", "PORO", False)
+
+    expected = "PORO\n"
+    for i, v in enumerate(values):
+        expected += f" {v:3e}"
+        if i % 6 == 5:
+            expected += "\n"
+    expected += " /\n"
+    assert (tmp_path / "test.grdecl").read_text(encoding="utf-8") == expected
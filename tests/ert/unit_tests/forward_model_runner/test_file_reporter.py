@@ -154,6 +154,25 @@ def test_report_with_running_message_argument(reporter):
         assert '"cpu_seconds": 1.1' in content, "status.json missing cpu_seconds"
 
 
+@pytest.mark.usefixtures("use_tmpdir")
+def test_status_json_is_only_dumped_on_transitions_without_running_status():
+    reporter = File(dump_running_status=False)
+    fmstep1 = ForwardModelStep({"name": "fmstep1"}, 0)
+    reporter.report(Init([fmstep1], 1, 19))
+    os.remove(STATUS_json)
+
+    reporter.report(
+        Running(fmstep1, ProcessTreeStatus(max_rss=100, rss=10, cpu_seconds=1.1))
+    )
+    assert not os.path.exists(STATUS_json)
+
+    reporter.report(Exited(fmstep1, 0))
+    with open(STATUS_json, encoding="utf-8") as f:
+        content = "".join(f.readlines())
+        assert '"max_memory_usage": 100' in content
+        assert '"status": "Success"' in content
+
+
 @pytest.mark.usefixtures("use_tmpdir")
 def test_report_with_successful_finish_message_argument(reporter):
     msg = Finish()
@@ -0,0 +1,114 @@
+from datetime import timedelta
+
+import pytest
+
+from _ert.forward_model_runner.forward_model_step import ForwardModelStep
+from _ert.forward_model_runner.reporting import TelemetryMode, filter_telemetry
+from _ert.forward_model_runner.reporting.message import (
+    Exited,
+    Finish,
+    Init,
+    ProcessTreeStatus,
+    Running,
+    Start,
+)
+from _ert.forward_model_runner.reporting.telemetry import HEARTBEAT_INTERVAL
+
+
+def running(step, rss, max_rss, cpu_seconds=0.0, seconds=0.0, start=None):
+    msg = Running(
+        step, ProcessTreeStatus(rss=rss, max_rss=max_rss, cpu_seconds=cpu_seconds)
+    )
+    if start is not None:
+        msg.timestamp = start.timestamp + timedelta(seconds=seconds)
+    return msg
+
+
+@pytest.fixture
+def step():
+    return ForwardModelStep({"name": "fmstep1"}, 0)
+
+
+def test_full_telemetry_reports_every_message(step):
+    messages = [
+        Init([step], 1, 19),
+        Start(step),
+        *[running(step, 10, 10) for _ in range(5)],
+        Exited(step, 0),
+        Finish(),
+    ]
+    assert list(filter_telemetry(messages, TelemetryMode.FULL)) == messages
+
+
+def test_peaks_telemetry_reports_the_first_sample_and_new_peaks(step):
+    start = Start(step)
+    first = running(step, 10, 10, 1.0)
+    new_peak = running(step, 50, 50, 5.0)
+    decreased = running(step, 20, 50, 6.0)
+    last = running(step, 30, 50, 8.0)
+    messages = [Init([step], 1, 19), start, first, new_peak, decreased, last]
+    messages += [Exited(step, 0), Finish()]
+
+    reported = list(filter_telemetry(messages, TelemetryMode.PEAKS))
+
+    assert reported == [*messages[:4], last, *messages[-2:]]
+    assert reported[4].memory_status.max_rss == 50
+    assert reported[4].memory_status.cpu_seconds == 8.0
+
+
+def test_peaks_telemetry_reports_the_first_sample_of_every_step():
+    step1 = ForwardModelStep({"name": "fmstep1"}, 0)
+    step2 = ForwardModelStep({"name": "fmstep2"}, 1)
+    sample1 = running(step1, 100, 100)
+    sample2 = running(step2, 10, 10)
+    messages = [Start(step1), sample1, Exited(step1, 0), Start(step2), sample2]
+
+    reported = list(filter_telemetry(messages, TelemetryMode.PEAKS))
+
+    assert reported == messages
+
+
+def test_changes_telemetry_reports_samples_when_memory_changes(step):
+    start = Start(step)
+    first = running(step, 100, 100, start=start, seconds=1)
+    unchanged = running(step, 105, 100, start=start, seconds=2)
+    new_peak = running(step, 120, 120, start=start, seconds=3)
+    decreased = running(step, 50, 120, start=start, seconds=4)
+    last = running(step, 52, 120, start=start, seconds=5)
+    exited = Exited(step, 0)
+
+    reported = list(
+        filter_telemetry(
+            [start, first, unchanged, new_peak, decreased, last, exited],
+            TelemetryMode.CHANGES,
+        )
+    )
+
+    assert reported == [start, first, new_peak, decreased, last, exited]
+
+
+def test_changes_telemetry_reports_unchanged_samples_after_heartbeat(step):
+    start = Start(step)
+    first = running(step, 100, 100, start=start)
+    quiet = running(step, 100, 100, start=start, seconds=HEARTBEAT_INTERVAL / 2)
+    heartbeat = running(step, 100, 100, start=start, seconds=HEARTBEAT_INTERVAL)
+
+    reported = list(
+        filter_telemetry([start, first, quiet, heartbeat], TelemetryMode.CHANGES)
+    )
+
+    assert reported == [start, first, heartbeat]
+
+
+def test_unsent_samples_are_not_reported_for_the_next_step():
+    step1 = ForwardModelStep({"name": "fmstep1"}, 0)
+    step2 = ForwardModelStep({"name": "fmstep2"}, 1)
+    first = running(step1, 10, 10)
+    unsent = running(step1, 10, 10)
+    start2 = Start(step2)
+    messages = [Start(step1), first, unsent, start2, Exited(step2, 0)]
+
+    reported = list(filter_telemetry(messages, TelemetryMode.PEAKS))
+
+    assert unsent not in reported
+    assert start2 in reported
@@ -3,7 +3,14 @@
 from PyQt6.QtGui import QColor
 from pytestqt.qt_compat import qt_api
 
-from ert.ensemble_evaluator.state import COLOR_FAILED
+from ert.ensemble_evaluator.snapshot import EnsembleSnapshot, FMStepSnapshot
+from ert.ensemble_evaluator.state import (
+    COLOR_FAILED,
+    FORWARD_MODEL_STATE_FINISHED,
+    FORWARD_MODEL_STATE_START,
+    REALIZATION_STATE_FINISHED,
+    REALIZATION_STATE_RUNNING,
+)
 from ert.gui.model.snapshot import FMStepColorHint, SnapshotModel
 
 from .gui_models_utils import finish_snapshot
@@ -90,3 +97,33 @@ def test_snapshot_model_exec_hosts_propagated(
 
     first_real = model.index(0, 0, model.index(0, 0))
     assert first_real.internalPointer().data.exec_hosts == expected_value
+
+
+def test_only_changed_rows_are_emitted_as_ranges(full_snapshot):
+    model = SnapshotModel()
+    model._add_snapshot(SnapshotModel.prerender(full_snapshot), "0")
+    changed = []
+    model.dataChanged.connect(
+        lambda top_left, bottom_right: changed.append(
+            (
+                top_left.parent().internalPointer().id_,
+                top_left.row(),
+                bottom_right.row(),
+            )
+        )
+    )
+
+    update = EnsembleSnapshot()
+    for real_id in ["1", "2", "5"]:
+        update.update_realization(real_id, status=REALIZATION_STATE_FINISHED)
+    update.update_realization("3", status=REALIZATION_STATE_RUNNING)
+    for fm_step_id in ["0", "2"]:
+        update.update_fm_step(
+            "7", fm_step_id, FMStepSnapshot(status=FORWARD_MODEL_STATE_FINISHED)
+        )
+    update.update_fm_step(
+        "8", "1", FMStepSnapshot(status=FORWARD_MODEL_STATE_START, error="error")
+    )
+    model._update_snapshot(SnapshotModel.prerender(update), "0")
+
+    assert sorted(changed) == [("0", 1, 2), ("0", 5, 5), ("7", 0, 0), ("7", 2, 2)]
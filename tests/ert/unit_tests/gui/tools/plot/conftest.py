@@ -4,7 +4,7 @@
 from contextlib import contextmanager
 from unittest.mock import MagicMock
 
-import pandas as pd
+import polars as pl
 import pytest
 
 from ert.gui.tools.plot.plot_api import PlotApi
@@ -46,21 +46,23 @@ def session(project: str):
         yield api
 
 
+def _arrow_stream(data):
+    num_realizations = len(next(iter(data.values())))
+    records = pl.DataFrame({"Realization": range(num_realizations), **data})
+    stream = io.BytesIO()
+    records.write_ipc_stream(stream)
+    return stream.getvalue()
+
+
 def mocked_requests_get(*args, **kwargs):
     summary_data = {
         "2010-01-20 00:00:00": [0.1, 0.2, 0.3, 0.4],
         "2010-02-20 00:00:00": [0.2, 0.21, 0.19, 0.18],
     }
-    summary_df = pd.DataFrame(summary_data)
-    summary_stream = io.BytesIO()
-    summary_df.to_parquet(summary_stream)
-    summary_parquet_data = summary_stream.getvalue()
+    summary_records = _arrow_stream(summary_data)
 
     parameter_data = {"0": [0.1, 0.2, 0.3]}
-    parameter_df = pd.DataFrame(parameter_data)
-    parameter_stream = io.BytesIO()
-    parameter_df.to_parquet(parameter_stream)
-    parameter_parquet_data = parameter_stream.getvalue()
+    parameter_records = _arrow_stream(parameter_data)
 
     gen_data = {
         "0": [0.1, 0.2, 0.3],
@@ -70,20 +72,14 @@ def mocked_requests_get(*args, **kwargs):
         "4": [0.1, 0.2, 0.3],
         "5": [0.1, 0.2, 0.3],
     }
-    gen_df = pd.DataFrame(gen_data)
-    gen_stream = io.BytesIO()
-    gen_df.to_parquet(gen_stream)
-    gen_parquet_data = gen_stream.getvalue()
+    gen_records = _arrow_stream(gen_data)
 
     history_data = {
         "0": [1.0, 0.2, 1.0, 1.0, 1.0],
         "1": [1.1, 0.2, 1.1, 1.1, 1.1],
         "2": [1.2, 1.2, 1.2, 1.2, 1.3],
     }
-    history_df = pd.DataFrame(history_data)
-    history_stream = io.BytesIO()
-    history_df.to_parquet(history_stream)
-    history_parquet_data = history_stream.getvalue()
+    history_records = _arrow_stream(history_data)
 
     ensemble = {
         "/ensembles/ens_id_1": {"name": "ensemble_1", "experiment_name": "experiment"},
@@ -277,12 +273,12 @@ def mocked_requests_get(*args, **kwargs):
     }
 
     records = {
-        "/ensembles/ens_id_3/records/FOPR": summary_parquet_data,
-        "/ensembles/ens_id_3/records/BPR%25253A1%25252C3%25252C8": summary_parquet_data,
-        "/ensembles/ens_id_3/records/SNAKE_OIL_PARAM%25253ABPR_138_PERSISTENCE": parameter_parquet_data,
-        "/ensembles/ens_id_3/records/SNAKE_OIL_PARAM%25253AOP1_DIVERGENCE_SCALE": parameter_parquet_data,
-        "/ensembles/ens_id_3/records/SNAKE_OIL_WPR_DIFF@199": gen_parquet_data,
-        "/ensembles/ens_id_3/records/FOPRH": history_parquet_data,
+        "/ensembles/ens_id_3/records/FOPR": summary_records,
+        "/ensembles/ens_id_3/records/BPR%25253A1%25252C3%25252C8": summary_records,
+        "/ensembles/ens_id_3/records/SNAKE_OIL_PARAM%25253ABPR_138_PERSISTENCE": parameter_records,
+        "/ensembles/ens_id_3/records/SNAKE_OIL_PARAM%25253AOP1_DIVERGENCE_SCALE": parameter_records,
+        "/ensembles/ens_id_3/records/SNAKE_OIL_WPR_DIFF@199": gen_records,
+        "/ensembles/ens_id_3/records/FOPRH": history_records,
     }
 
     experiments = [
@@ -26,8 +26,15 @@ def get_parser() -> argparse.ArgumentParser:
     return parser
 
 
-def bjobs_formatter(jobstats: list[Job]) -> str:
-    return "".join([f"{job.job_id}^{job.job_state}^-\n" for job in jobstats])
+def bjobs_formatter(jobstats: list[Job], job_index: bool = False) -> str:
+    if not job_index:
+        return "".join([f"{job.job_id}^{job.job_state}^-\n" for job in jobstats])
+    lines = []
+    for job in jobstats:
+        # The elements of job arrays are listed by array id and index
+        array_id, _, index = job.job_id.removesuffix("]").partition("[")
+        lines.append(f"{array_id}^{job.job_state}^-^{index or 0}\n")
+    return "".join(lines)
 
 
 def read(path: Path, default: str | None = None) -> str | None:
@@ -59,7 +66,7 @@ def main() -> None:
 
         jobs_output.append(Job(job_id=job, job_state=state))
 
-    print(bjobs_formatter(jobs_output))
+    print(bjobs_formatter(jobs_output, job_index="jobindex" in args.o))
 
 
 if __name__ == "__main__":
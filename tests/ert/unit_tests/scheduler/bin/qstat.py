@@ -25,6 +25,7 @@ def parse_args() -> Namespace:
     ap.add_argument("jobs", nargs="*")
     ap.add_argument("-w", action="store_true")
     ap.add_argument("-E", action="store_true")
+    ap.add_argument("-t", action="store_true")
     return ap.parse_args()
 
 
@@ -50,7 +51,8 @@ def main() -> None:
 
         state = "Q"
         if returncode is not None:
-            state = random.choice("EF")
+            # Finished subjobs of job arrays are expired
+            state = "X" if "[" in job else random.choice("EF")
         elif pid is not None:
             state = "R"
 
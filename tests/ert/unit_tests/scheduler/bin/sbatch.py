@@ -20,6 +20,7 @@ def get_parser() -> argparse.ArgumentParser:
     parser.add_argument("--parsable", action="store_true")
     parser.add_argument("--output", type=str)
     parser.add_argument("--error", type=str)
+    parser.add_argument("--array", type=str)
     parser.add_argument("script", type=str)
     return parser
 
@@ -30,25 +31,42 @@ def main() -> None:
     jobid = random.randint(1, 2**15)
     jobdir = Path(os.getenv("PYTEST_TMP_PATH", "."))
     (jobdir / "mock_jobs").mkdir(parents=True, exist_ok=True)
-    (jobdir / "mock_jobs" / f"{jobid}.script").write_text(args.script, encoding="utf-8")
-    (jobdir / "mock_jobs" / f"{jobid}.name").write_text(args.job_name, encoding="utf-8")
-    env_file = jobdir / "mock_jobs" / f"{jobid}.env"
-
-    if args.ntasks:
-        env_file.write_text(
-            f"export SLURM_JOB_CPUS_PER_NODE={args.ntasks}\n"
-            f"export SLURM_CPUS_ON_NODE={args.ntasks}",
-            encoding="utf-8",
-        )
+
+    if args.array:
+        # Only the 0-N form of --array is mocked, each element becomes a job
+        # with id {jobid}_{index}
+        first, last = (int(index) for index in args.array.split("-"))
+        elements = [
+            (f"{jobid}_{index}", f"export SLURM_ARRAY_TASK_ID={index}\n")
+            for index in range(first, last + 1)
+        ]
     else:
-        env_file.touch()
-
-    subprocess.Popen(
-        [str(Path(__file__).parent / "runner"), f"{jobdir}/mock_jobs/{jobid}"],
-        start_new_session=True,
-        stdout=open(args.output, "w", encoding="utf-8"),  # noqa: SIM115
-        stderr=open(args.error, "w", encoding="utf-8"),  # noqa: SIM115
-    )
+        elements = [(str(jobid), "")]
+
+    for job, array_env in elements:
+        (jobdir / "mock_jobs" / f"{job}.script").write_text(
+            args.script, encoding="utf-8"
+        )
+        (jobdir / "mock_jobs" / f"{job}.name").write_text(
+            args.job_name, encoding="utf-8"
+        )
+        env_file = jobdir / "mock_jobs" / f"{job}.env"
+
+        if args.ntasks:
+            env_file.write_text(
+                array_env + f"export SLURM_JOB_CPUS_PER_NODE={args.ntasks}\n"
+                f"export SLURM_CPUS_ON_NODE={args.ntasks}",
+                encoding="utf-8",
+            )
+        else:
+            env_file.write_text(array_env, encoding="utf-8")
+
+        subprocess.Popen(
+            [str(Path(__file__).parent / "runner"), f"{jobdir}/mock_jobs/{job}"],
+            start_new_session=True,
+            stdout=open(args.output, "w", encoding="utf-8"),  # noqa: SIM115
+            stderr=open(args.error, "w", encoding="utf-8"),  # noqa: SIM115
+        )
 
     if args.parsable:
         print(jobid)
@@ -7,7 +7,17 @@
 
 import pytest
 
-from ert.scheduler.driver import SIGNAL_OFFSET, Driver
+from ert.scheduler.driver import (
+    MAX_ARRAY_SIZE,
+    MAX_SWEEP_PERIOD,
+    SIGNAL_OFFSET,
+    Driver,
+    FailedSubmit,
+    SubmitBatcher,
+    SubmitRequest,
+    array_groups,
+    create_array_submit_script,
+)
 from ert.scheduler.local_driver import LocalDriver
 from ert.scheduler.lsf_driver import LsfDriver
 from ert.scheduler.openpbs_driver import OpenPBSDriver
@@ -241,3 +251,127 @@ async def test_poll_ignores_filenotfounderror(driver: Driver, caplog):
     )
     assert "No such file or directory" in str(caplog.text)
     assert "/usr/bin/foo" in str(caplog.text)
+
+
+async def test_that_notify_finished_wakes_up_a_waiting_poll(driver: Driver):
+    driver._poll_period = 100
+    waiting = asyncio.create_task(driver._wait_for_next_poll(1))
+    await asyncio.sleep(0)
+    assert not waiting.done()
+
+    driver.notify_finished(0)
+    await asyncio.wait_for(waiting, timeout=1)
+
+
+def test_that_the_poll_period_backs_off_with_the_number_of_jobs_once_notified(
+    driver: Driver,
+):
+    driver._poll_period = 2
+    assert driver._sweep_period(1000) == 2
+
+    driver.notify_finished(0)
+    # Notified jobs are polled at the poll period until reported finished
+    assert driver._sweep_period(1000) == 2
+
+    driver._job_finished(0)
+    assert driver._sweep_period(0) == 2
+    assert driver._sweep_period(100) == 4
+    assert driver._sweep_period(10000) == MAX_SWEEP_PERIOD
+
+
+def test_that_array_groups_split_on_program_resources_and_size():
+    requests = [
+        SubmitRequest(iens, "sleep", num_cpu=1 + iens % 2)
+        for iens in range(2 * MAX_ARRAY_SIZE + 2)
+    ]
+    requests.append(SubmitRequest(len(requests), "true"))
+    groups = list(array_groups(requests))
+
+    assert [len(group) for group in groups] == [MAX_ARRAY_SIZE, 1, MAX_ARRAY_SIZE, 1, 1]
+    for group in groups:
+        assert len({(r.executable, r.num_cpu) for r in group}) == 1
+
+
+async def test_that_array_submit_script_runs_the_element_of_the_index(tmp_path):
+    requests = [
+        SubmitRequest(iens, "sh", ("-c", f"echo {iens}"), runpath=tmp_path / str(iens))
+        for iens in range(3)
+    ]
+    for request in requests:
+        request.runpath.mkdir()
+    script = tmp_path / "array.sh"
+    script.write_text(
+        create_array_submit_script(
+            "INDEX", requests, "", [("out", "err")] * len(requests)
+        ),
+        encoding="utf-8",
+    )
+
+    for index in [1, 2]:
+        process = await asyncio.create_subprocess_exec(
+            "bash", str(script), env={**os.environ, "INDEX": str(index)}
+        )
+        assert await process.wait() == 0
+        assert (tmp_path / str(index) / "out").read_text(encoding="utf-8") == (
+            f"{index}\n"
+        )
+    assert not (tmp_path / "0" / "out").exists()
+
+    process = await asyncio.create_subprocess_exec(
+        "bash",
+        str(script),
+        env={**os.environ, "INDEX": "3"},
+        stderr=asyncio.subprocess.PIPE,
+    )
+    _, stderr = await process.communicate()
+    assert process.returncode == 1
+    assert b"Unknown array index 3" in stderr
+
+
+async def test_that_submit_batcher_submits_concurrent_submits_together():
+    batches = []
+
+    async def submit_batch(requests):
+        batches.append([request.iens for request in requests])
+        return {1: FailedSubmit("no capacity")}
+
+    async def kill(iens):
+        pass
+
+    batcher = SubmitBatcher(submit_batch, kill, window=0.01)
+    results = await asyncio.gather(
+        *(batcher.submit(SubmitRequest(iens, "sleep")) for iens in range(3)),
+        return_exceptions=True,
+    )
+    assert batches == [[0, 1, 2]]
+    assert results[0] is None
+    assert isinstance(results[1], FailedSubmit)
+    assert results[2] is None
+
+    await batcher.submit(SubmitRequest(3, "sleep"))
+    assert batches == [[0, 1, 2], [3]]
+
+
+async def test_that_submit_batcher_kills_submits_cancelled_during_the_batch():
+    submitting = asyncio.Event()
+    release = asyncio.Event()
+    killed = []
+
+    async def submit_batch(requests):
+        submitting.set()
+        await release.wait()
+        return {}
+
+    async def kill(iens):
+        killed.append(iens)
+
+    batcher = SubmitBatcher(submit_batch, kill, window=0)
+    submit = asyncio.create_task(batcher.submit(SubmitRequest(0, "sleep")))
+    await submitting.wait()
+    submit.cancel()
+    release.set()
+    with pytest.raises(asyncio.CancelledError):
+        await submit
+    for _ in range(3):
+        await asyncio.sleep(0)
+    assert killed == [0]
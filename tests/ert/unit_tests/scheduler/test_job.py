@@ -1,4 +1,5 @@
 import asyncio
+import concurrent.futures
 import logging
 import shutil
 from functools import partial
@@ -30,6 +31,7 @@ def create_scheduler():
     sch.driver = AsyncMock()
     sch._manifest_queue = None
     sch._cancelled = False
+    sch._update_jobs_json = MagicMock(return_value=None)
     return sch
 
 
@@ -229,6 +231,71 @@ async def test_realization_memory_is_propagated_to_driver(realization: Realizati
     )
 
 
+@pytest.mark.usefixtures("use_tmpdir")
+@pytest.mark.asyncio
+async def test_job_is_submitted_when_its_runpath_is_ready(realization: Realization):
+    realization.runpath_ready = concurrent.futures.Future()
+    scheduler = create_scheduler()
+    job = Job(scheduler, realization)
+    job_run_task = asyncio.create_task(
+        job.run(asyncio.Semaphore(), asyncio.Lock(), asyncio.Lock(), max_submit=1)
+    )
+    await asyncio.sleep(0.1)
+    scheduler.driver.submit.assert_not_called()
+
+    scheduler._update_jobs_json.assert_not_called()
+
+    realization.runpath_ready.set_result(None)
+    job.started.set()
+    job.returncode.set_result(0)
+    await job_run_task
+    scheduler._update_jobs_json.assert_called_once_with(
+        realization.iens, realization.run_arg.runpath
+    )
+    scheduler.driver.submit.assert_called_once()
+
+
+@pytest.mark.asyncio
+async def test_job_fails_without_submitting_when_its_jobs_json_is_not_updated(
+    realization: Realization, monkeypatch
+):
+    realization.runpath_ready = concurrent.futures.Future()
+    realization.runpath_ready.set_result(None)
+    scheduler = create_scheduler()
+    scheduler._update_jobs_json.return_value = "Could not update jobs.json"
+    monkeypatch.setattr(
+        scheduler.driver,
+        "read_stdout_and_stderr_files",
+        lambda *args: "",
+    )
+    job = Job(scheduler, realization)
+    await job.run(asyncio.Semaphore(), asyncio.Lock(), asyncio.Lock(), max_submit=1)
+
+    scheduler.driver.submit.assert_not_called()
+    await assert_scheduler_events(scheduler, [JobState.WAITING, JobState.FAILED])
+    assert "Could not update jobs.json" in job._message
+
+
+@pytest.mark.asyncio
+async def test_job_fails_without_submitting_when_its_runpath_is_not_created(
+    realization: Realization, monkeypatch
+):
+    realization.runpath_ready = concurrent.futures.Future()
+    realization.runpath_ready.set_exception(ValueError("bad template"))
+    scheduler = create_scheduler()
+    monkeypatch.setattr(
+        scheduler.driver,
+        "read_stdout_and_stderr_files",
+        lambda *args: "",
+    )
+    job = Job(scheduler, realization)
+    await job.run(asyncio.Semaphore(), asyncio.Lock(), asyncio.Lock(), max_submit=1)
+
+    scheduler.driver.submit.assert_not_called()
+    await assert_scheduler_events(scheduler, [JobState.WAITING, JobState.FAILED])
+    assert "bad template" in job._message
+
+
 @pytest.mark.asyncio
 async def test_when_waiting_for_disk_sync_times_out_an_error_is_logged(
     realization: Realization, monkeypatch
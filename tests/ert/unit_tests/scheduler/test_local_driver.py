@@ -5,7 +5,8 @@
 
 import pytest
 
-from ert.scheduler import local_driver
+from ert.config.queue_config import LocalQueueOptions
+from ert.scheduler import create_driver, local_driver
 from ert.scheduler.driver import SIGNAL_OFFSET
 from ert.scheduler.event import FinishedEvent, StartedEvent
 from ert.scheduler.local_driver import LocalDriver
@@ -141,3 +142,47 @@ async def test_path_as_argument_is_valid(tmp_path):
     assert await driver.event_queue.get() == FinishedEvent(iens=42, returncode=0)
 
     assert Path("testfile").exists()
+
+
+@pytest.mark.timeout(10)
+async def test_that_realizations_wait_for_the_memory_they_book():
+    driver = LocalDriver(memory_limit=100)
+
+    await driver.submit(1, "/usr/bin/env", "sleep", "10", realization_memory=60)
+    await driver.submit(2, "/usr/bin/env", "true", realization_memory=30)
+    assert await driver.event_queue.get() == StartedEvent(iens=1)
+    assert await driver.event_queue.get() == StartedEvent(iens=2)
+    assert await driver.event_queue.get() == FinishedEvent(iens=2, returncode=0)
+
+    waiting = asyncio.create_task(
+        driver.submit(3, "/usr/bin/env", "true", realization_memory=60)
+    )
+    await asyncio.sleep(0.1)
+    assert not waiting.done()
+
+    await driver.kill(1)
+    await waiting
+    assert await driver.event_queue.get() == FinishedEvent(
+        iens=1, returncode=signal.SIGTERM + SIGNAL_OFFSET
+    )
+    assert await driver.event_queue.get() == StartedEvent(iens=3)
+    assert await driver.event_queue.get() == FinishedEvent(iens=3, returncode=0)
+
+
+async def test_that_a_realization_booking_more_than_the_limit_runs_alone():
+    driver = LocalDriver(memory_limit=100)
+
+    await driver.submit(1, "/usr/bin/env", "true", realization_memory=200)
+    assert await driver.event_queue.get() == StartedEvent(iens=1)
+    assert await driver.event_queue.get() == FinishedEvent(iens=1, returncode=0)
+
+
+@pytest.mark.parametrize("predictive_scheduling", [True, False])
+def test_that_only_predictive_scheduling_limits_the_memory_of_the_local_driver(
+    predictive_scheduling,
+):
+    driver = create_driver(
+        LocalQueueOptions(predictive_scheduling=predictive_scheduling)
+    )
+    assert isinstance(driver, LocalDriver)
+    assert (driver._memory_limit is not None) == predictive_scheduling
@@ -188,6 +188,48 @@ async def test_submit_with_default_queue():
     assert "-q" not in Path("captured_bsub_args").read_text(encoding="utf-8")
 
 
+@pytest.mark.usefixtures("capturing_bsub")
+async def test_that_concurrent_submits_are_submitted_as_one_job_array(tmp_path):
+    driver = LsfDriver(job_arrays=True)
+    await asyncio.gather(
+        *(driver.submit(iens, "sleep", name=f"job{iens}") for iens in range(3))
+    )
+    bsub_args = Path("captured_bsub_args").read_text(encoding="utf-8")
+    assert "-J job0[1-3]" in bsub_args
+    assert "/dev/null" not in bsub_args
+    assert driver._iens2jobid == {0: "1[1]", 1: "1[2]", 2: "1[3]"}
+
+    # The output and job report of each element goes to its own files
+    (outputs_dir,) = tmp_path.glob(".lsf_submit_*.outputs")
+    assert f"-o {outputs_dir}/%I.LSF-stdout" in bsub_args
+    assert f"-e {outputs_dir}/%I.LSF-stderr" in bsub_args
+    for index in range(1, 4):
+        assert (outputs_dir / f"{index}.LSF-stdout").readlink() == (
+            tmp_path / f"job{index - 1}.LSF-stdout"
+        )
+
+
+@pytest.mark.usefixtures("capturing_bsub")
+async def test_that_a_single_submit_with_job_arrays_is_not_an_array():
+    driver = LsfDriver(job_arrays=True)
+    await driver.submit(0, "sleep", name="myjobname")
+    bsub_args = Path("captured_bsub_args").read_text(encoding="utf-8")
+    assert "-J myjobname " in bsub_args
+    assert "/dev/null" not in bsub_args
+    assert driver._iens2jobid == {0: "1"}
+
+
+@pytest.mark.usefixtures("capturing_bsub")
+async def test_that_concurrent_submits_without_job_arrays_are_separate_jobs():
+    driver = LsfDriver(job_arrays=False)
+    await asyncio.gather(
+        *(driver.submit(iens, "sleep", name=f"job{iens}") for iens in range(3))
+    )
+    assert "[" not in Path("captured_bsub_args").read_text(encoding="utf-8")
+    assert set(driver._iens2jobid) == {0, 1, 2}
+    assert all("[" not in job_id for job_id in driver._iens2jobid.values())
+
+
 @pytest.mark.usefixtures("capturing_bsub")
 async def test_submit_with_project_code():
     queue_config_dict = {
@@ -930,14 +972,15 @@ async def test_poll_once_by_bhist_requires_aged_data(
 
 
 @pytest.mark.parametrize(
-    "bkill_output",
+    "job_id, bkill_output",
     [
-        "Job <1> is being terminated",
-        "Job <1> is being signaled",
+        ("1", "Job <1> is being terminated"),
+        ("1", "Job <1> is being signaled"),
+        ("1[2]", "Job <1[2]> is being terminated"),
     ],
 )
 async def test_kill_does_not_log_error_on_accepted_bkill_outputs(
-    bkill_output, tmp_path, caplog, capsys
+    job_id, bkill_output, tmp_path, caplog, capsys
 ):
     bkill_path = tmp_path / "bkill"
     bkill_path.write_text(f"#!/bin/sh\necho '{bkill_output}'; exit 0")
@@ -945,7 +988,7 @@ async def test_kill_does_not_log_error_on_accepted_bkill_outputs(
     driver = LsfDriver(bkill_cmd=bkill_path)
 
     async def mock_submit(*args, **kwargs):
-        driver._iens2jobid[0] = "1"
+        driver._iens2jobid[0] = job_id
         driver._submit_locks[0] = asyncio.Lock()
 
     driver.submit = mock_submit
@@ -1044,6 +1087,40 @@ async def test_lsf_stdout_file(tmp_path, job_name):
     assert "yay" in lsf_stdout
 
 
+@pytest.mark.integration_test
+async def test_lsf_job_array_elements_run_in_their_own_runpath(tmp_path):
+    driver = LsfDriver(job_arrays=True)
+    for iens in range(3):
+        (tmp_path / str(iens)).mkdir()
+    await asyncio.gather(
+        *(
+            driver.submit(
+                iens,
+                "sh",
+                "-c",
+                f"echo {iens}",
+                name=f"job{iens}",
+                runpath=tmp_path / str(iens),
+            )
+            for iens in range(3)
+        )
+    )
+    assert all("[" in job_id for job_id in driver._iens2jobid.values())
+
+    finished: dict[int, int] = {}
+
+    async def record_finished(iens, returncode):
+        finished[iens] = returncode
+
+    await poll(driver, {0, 1, 2}, finished=record_finished)
+    assert finished == {0: 0, 1: 0, 2: 0}
+    for iens in range(3):
+        stdout = tmp_path / str(iens) / f"job{iens}.LSF-stdout"
+        lsf_stdout = stdout.read_text(encoding="utf-8")
+        assert "Sender: " in lsf_stdout, "The LSF job report should be kept"
+        assert lsf_stdout.splitlines()[-1] == str(iens)
+
+
 @pytest.mark.integration_test
 async def test_lsf_dumps_stderr_to_file(tmp_path, job_name):
     os.chdir(tmp_path)
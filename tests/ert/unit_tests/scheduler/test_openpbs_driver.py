@@ -15,6 +15,7 @@
 
 from ert.cli.main import ErtCliError
 from ert.mode_definitions import ENSEMBLE_EXPERIMENT_MODE
+from ert.scheduler.driver import FailedSubmit
 from ert.scheduler.openpbs_driver import (
     JOB_STATES,
     QDEL_JOB_HAS_FINISHED,
@@ -53,7 +54,7 @@ async def test_events_produced_from_jobstate_updates(jobstate_sequence: list[str
     finished = False
     if "R" in jobstate_sequence:
         started = True
-    if "F" in jobstate_sequence or "E" in jobstate_sequence:
+    if {"E", "F", "X"} & set(jobstate_sequence):
         finished = True
 
     driver = OpenPBSDriver()
@@ -72,7 +73,7 @@ async def mocked_submit(self, iens, *_args, **_kwargs):
         jobstate = _parse_jobs_dict({"1": {"job_state": statestr, "Exit_status": 0}})[
             "1"
         ]
-        if statestr in {"E", "F"} and "1" in driver._non_finished_job_ids:
+        if statestr in {"E", "F", "X"} and "1" in driver._non_finished_job_ids:
             driver._non_finished_job_ids.remove("1")
             driver._finished_job_ids.add("1")
         await driver._process_job_update("1", jobstate)
@@ -120,6 +121,20 @@ def capturing_qsub(monkeypatch, tmp_path):
     qsub_path.chmod(qsub_path.stat().st_mode | stat.S_IEXEC)
 
 
+@pytest.fixture
+def capturing_array_qsub(monkeypatch, tmp_path):
+    os.chdir(tmp_path)
+    bin_path = tmp_path / "bin"
+    bin_path.mkdir()
+    monkeypatch.setenv("PATH", f"{bin_path}:{os.environ['PATH']}")
+    qsub_path = bin_path / "qsub"
+    qsub_path.write_text(
+        "#!/bin/sh\necho $@ > captured_qsub_args; echo '1[].server'",
+        encoding="utf-8",
+    )
+    qsub_path.chmod(qsub_path.stat().st_mode | stat.S_IEXEC)
+
+
 def parse_resource_string(qsub_args: str) -> dict[str, str]:
     resources = {}
 
@@ -179,6 +194,88 @@ async def test_cluster_label():
     assert "-l foobar" in Path("captured_qsub_args").read_text(encoding="utf-8")
 
 
+@pytest.mark.usefixtures("capturing_array_qsub")
+async def test_that_concurrent_submits_are_submitted_as_one_job_array():
+    driver = OpenPBSDriver(job_arrays=True)
+    await asyncio.gather(
+        *(driver.submit(iens, "sleep", name=f"job{iens}") for iens in range(3))
+    )
+    qsub_args = shlex.split(Path("captured_qsub_args").read_text(encoding="utf-8"))
+    assert qsub_args[qsub_args.index("-J") + 1] == "0-2"
+    assert "-Njob0" in qsub_args
+    # PBS Professional rejects job arrays that are not rerunnable
+    assert "-ry" in qsub_args
+    assert "-rn" not in qsub_args
+    assert driver._iens2jobid == {
+        0: "1[0].server",
+        1: "1[1].server",
+        2: "1[2].server",
+    }
+
+
+@pytest.mark.usefixtures("capturing_array_qsub")
+async def test_that_a_single_submit_with_job_arrays_is_not_an_array():
+    driver = OpenPBSDriver(job_arrays=True)
+    await driver.submit(0, "sleep", name="sleepy")
+    qsub_args = shlex.split(Path("captured_qsub_args").read_text(encoding="utf-8"))
+    assert "-J" not in qsub_args
+    assert "-rn" in qsub_args
+
+
+@pytest.mark.usefixtures("capturing_qsub")
+async def test_that_a_job_array_reply_without_an_array_id_fails_the_submits():
+    driver = OpenPBSDriver(job_arrays=True)
+    results = await asyncio.gather(
+        *(driver.submit(iens, "sleep", name=f"job{iens}") for iens in range(2)),
+        return_exceptions=True,
+    )
+    assert all(isinstance(result, FailedSubmit) for result in results)
+    assert "Could not understand '1' from qsub -J" in str(results[0])
+    assert driver._iens2jobid == {}
+
+
+@pytest.mark.usefixtures("capturing_qsub")
+async def test_that_concurrent_submits_without_job_arrays_are_separate_jobs():
+    driver = OpenPBSDriver(job_arrays=False)
+    await asyncio.gather(
+        *(driver.submit(iens, "sleep", name=f"job{iens}") for iens in range(2))
+    )
+    assert "-J" not in Path("captured_qsub_args").read_text(encoding="utf-8")
+    assert set(driver._iens2jobid) == {0, 1}
+
+
+@pytest.mark.integration_test
+async def test_openpbs_job_array_subjobs_run_in_their_own_runpath(tmp_path):
+    driver = OpenPBSDriver(job_arrays=True)
+    for iens in range(3):
+        (tmp_path / str(iens)).mkdir()
+    await asyncio.gather(
+        *(
+            driver.submit(
+                iens,
+                "sh",
+                "-c",
+                f"echo {iens} > out",
+                name=f"job{iens}",
+                runpath=tmp_path / str(iens),
+            )
+            for iens in range(3)
+        )
+    )
+    assert all("[" in job_id for job_id in driver._iens2jobid.values())
+
+    finished: dict[int, int] = {}
+
+    async def record_finished(iens, returncode):
+        finished[iens] = returncode
+
+    await poll(driver, {0, 1, 2}, finished=record_finished)
+    assert finished == {0: 0, 1: 0, 2: 0}
+    for iens in range(3):
+        out = tmp_path / str(iens) / "out"
+        assert out.read_text(encoding="utf-8").strip() == str(iens)
+
+
 @pytest.mark.integration_test
 @pytest.mark.parametrize(
     "qstat_script, started_expected",
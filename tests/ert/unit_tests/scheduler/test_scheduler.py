@@ -1,16 +1,24 @@
 import asyncio
+import concurrent.futures
 import itertools
 import json
 import random
 import shutil
+import threading
 import time
+from datetime import datetime, timedelta
 from functools import partial
 from pathlib import Path
-from unittest.mock import AsyncMock
+from unittest.mock import AsyncMock, MagicMock
 
+import polars as pl
 import pytest
 
 from _ert.events import (
+    ForwardModelStepFailure,
+    ForwardModelStepRunning,
+    ForwardModelStepStart,
+    ForwardModelStepSuccess,
     Id,
     RealizationFailed,
     RealizationStoppedLongRunning,
@@ -149,6 +157,7 @@ async def test_add_dispatch_information_to_jobs_file(
         ens_id=test_ens_id,
         ee_uri=test_ee_uri,
         ee_token=test_ee_token,
+        telemetry="PEAKS",
     )
 
     for realization in realizations:
@@ -163,10 +172,45 @@ async def test_add_dispatch_information_to_jobs_file(
         assert content["real_id"] == realization.iens
         assert content["dispatch_url"] == test_ee_uri
         assert content["ee_token"] == test_ee_token
+        assert content["telemetry"] == "PEAKS"
         assert type(content["jobList"]) is list
         assert len(content["jobList"]) == 0
 
 
+async def test_that_dispatch_information_waits_for_runpaths_being_created(
+    realization, mock_driver
+):
+    realization.runpath_ready = concurrent.futures.Future()
+    sch = scheduler.Scheduler(
+        mock_driver(), realizations=[realization], ee_uri="tcp://test_ee_uri.com/121/"
+    )
+
+    # The runpath is not written yet, which is not a reason to unschedule it
+    sch.add_dispatch_information_to_jobs_file()
+    assert sch._jobs[realization.iens].state != JobState.ABORTED
+    assert not (Path(realization.run_arg.runpath) / "jobs.json").exists()
+
+
+@pytest.mark.parametrize("compact_jobs_json", [True, False])
+async def test_that_dispatch_information_is_written_compact_when_asked_for(
+    realization, mock_driver, compact_jobs_json
+):
+    sch = scheduler.Scheduler(
+        mock_driver(),
+        realizations=[realization],
+        ee_uri="tcp://test_ee_uri.com/121/",
+        compact_jobs_json=compact_jobs_json,
+    )
+    create_jobs_json(realization)
+
+    sch.add_dispatch_information_to_jobs_file()
+
+    job_file_path = Path(realization.run_arg.runpath) / "jobs.json"
+    content = job_file_path.read_text(encoding="utf-8")
+    assert ("\n" not in content) == compact_jobs_json
+    assert json.loads(content)["dispatch_url"] == "tcp://test_ee_uri.com/121/"
+
+
 @pytest.mark.parametrize("max_submit", [1, 2, 3])
 async def test_that_max_submit_was_reached(realization, max_submit, mock_driver):
     retries = 0
@@ -291,6 +335,210 @@ async def wait():
         assert max_running_observed == ensemble_size
 
 
+@pytest.mark.flaky(reruns=3)
+@pytest.mark.parametrize("internalization_workers", [1, 2, 4])
+async def test_that_results_are_internalized_concurrently_by_worker_threads(
+    internalization_workers, mock_driver, monkeypatch, storage, tmp_path
+):
+    ensemble_size = 3 * internalization_workers
+    lock = threading.Lock()
+    running = 0
+    max_running_observed = 0
+    thread_names = set()
+
+    def internalize():
+        nonlocal running, max_running_observed
+        with lock:
+            running += 1
+            max_running_observed = max(max_running_observed, running)
+            thread_names.add(threading.current_thread().name)
+        time.sleep(0.05)
+        with lock:
+            running -= 1
+
+    async def mocked_forward_model_ok(*args, executor, **kwargs):
+        await asyncio.get_running_loop().run_in_executor(executor, internalize)
+        return LoadResult(LoadStatus.LOAD_SUCCESSFUL, "")
+
+    monkeypatch.setattr(job, "forward_model_ok", mocked_forward_model_ok)
+    ensemble = storage.create_experiment().create_ensemble(
+        name="foo", ensemble_size=ensemble_size
+    )
+    realizations = [
+        create_stub_realization(ensemble, tmp_path, iens)
+        for iens in range(ensemble_size)
+    ]
+
+    sch = scheduler.Scheduler(
+        mock_driver(), realizations, internalization_workers=internalization_workers
+    )
+
+    assert await sch.execute() == Id.ENSEMBLE_SUCCEEDED
+    assert max_running_observed == internalization_workers
+    assert all(name.startswith("internalization") for name in thread_names)
+
+
+async def test_that_started_internalizations_finish_before_the_scheduler_returns(
+    realization, mock_driver, monkeypatch
+):
+    started = threading.Event()
+    finished = threading.Event()
+
+    def internalize():
+        started.set()
+        time.sleep(0.2)
+        finished.set()
+
+    async def mocked_forward_model_ok(*args, executor, **kwargs):
+        await asyncio.get_running_loop().run_in_executor(executor, internalize)
+        return LoadResult(LoadStatus.LOAD_SUCCESSFUL, "")
+
+    monkeypatch.setattr(job, "forward_model_ok", mocked_forward_model_ok)
+    sch = scheduler.Scheduler(mock_driver(), [realization])
+    scheduler_task = asyncio.create_task(sch.execute())
+
+    assert await asyncio.to_thread(started.wait, 5)
+    await sch.cancel_all_jobs()
+    assert await scheduler_task == Id.ENSEMBLE_CANCELLED
+    assert finished.is_set()
+
+
+async def test_that_the_driver_is_notified_when_the_forward_model_finishes(
+    realization, mock_driver, monkeypatch
+):
+    realization.fm_steps = [MagicMock(), MagicMock()]
+    driver = mock_driver()
+    notified: list[int] = []
+    monkeypatch.setattr(driver, "notify_finished", notified.append)
+    manifest_queue = asyncio.Queue()
+    sch = scheduler.Scheduler(driver, [realization], manifest_queue=manifest_queue)
+    consumer = asyncio.create_task(sch._dispatch_event_consumer())
+
+    await manifest_queue.put(ForwardModelStepSuccess(real="0", fm_step="0"))
+    await manifest_queue.join()
+    assert notified == []
+
+    await manifest_queue.put(ForwardModelStepSuccess(real="0", fm_step="1"))
+    await manifest_queue.join()
+    assert notified == [0]
+
+    await manifest_queue.put(
+        ForwardModelStepFailure(real="0", fm_step="0", error_msg="failed")
+    )
+    await manifest_queue.join()
+    assert notified == [0, 0]
+    consumer.cancel()
+
+
+async def test_that_the_resource_usage_of_the_steps_is_saved_with_the_ensemble(
+    realization, mock_driver
+):
+    step = MagicMock()
+    step.name = "step"
+    realization.fm_steps = [step]
+    manifest_queue = asyncio.Queue()
+    sch = scheduler.Scheduler(
+        mock_driver(),
+        [realization],
+        manifest_queue=manifest_queue,
+        predictive_scheduling=True,
+    )
+    consumer = asyncio.create_task(sch._dispatch_event_consumer())
+
+    start = datetime.now()
+    for event in [
+        ForwardModelStepStart(real="0", fm_step="0", time=start),
+        ForwardModelStepRunning(real="0", fm_step="0", max_memory_usage=300),
+        ForwardModelStepRunning(real="0", fm_step="0", max_memory_usage=200),
+        ForwardModelStepSuccess(
+            real="0", fm_step="0", time=start + timedelta(seconds=5)
+        ),
+    ]:
+        await manifest_queue.put(event)
+    await manifest_queue.join()
+    consumer.cancel()
+    sch._save_resource_usage()
+
+    usage = realization.run_arg.ensemble_storage.load_resource_usage()
+    assert usage.to_dicts() == [
+        {
+            "realization": 0,
+            "fm_step": 0,
+            "name": "step",
+            "runtime": 5.0,
+            "max_memory_usage": 300,
+        }
+    ]
+
+
+async def test_that_no_resource_usage_is_saved_without_predictive_scheduling(
+    realization, mock_driver
+):
+    manifest_queue = asyncio.Queue()
+    sch = scheduler.Scheduler(
+        mock_driver(), [realization], manifest_queue=manifest_queue
+    )
+    consumer = asyncio.create_task(sch._dispatch_event_consumer())
+    await manifest_queue.put(
+        ForwardModelStepSuccess(real="0", fm_step="0", time=datetime.now())
+    )
+    await manifest_queue.join()
+    consumer.cancel()
+    sch._save_resource_usage()
+
+    assert realization.run_arg.ensemble_storage.load_resource_usage() is None
+
+
+async def test_that_predictive_scheduling_submits_the_longest_running_first(
+    mock_driver, storage, tmp_path
+):
+    gigabyte = 1024**3
+    experiment = storage.create_experiment()
+    prior = experiment.create_ensemble(name="prior", ensemble_size=3)
+    prior.save_resource_usage(
+        pl.DataFrame(
+            {
+                "realization": [0, 1, 1, 2],
+                "fm_step": [0, 0, 1, 0],
+                "name": ["a", "a", "b", "a"],
+                "runtime": [1.0, 2.0, 2.0, 3.0],
+                "max_memory_usage": [gigabyte, 2 * gigabyte, gigabyte, 16 * gigabyte],
+            },
+            schema_overrides={"realization": pl.UInt16, "fm_step": pl.UInt16},
+        )
+    )
+    posterior = experiment.create_ensemble(
+        name="posterior", ensemble_size=4, iteration=1, prior_ensemble=prior
+    )
+    realizations = [
+        create_stub_realization(posterior, tmp_path, iens) for iens in range(4)
+    ]
+    for real in realizations:
+        real.realization_memory = 8 * gigabyte
+    submitted: list[int] = []
+
+    async def init(iens, *args, **kwargs):
+        submitted.append(iens)
+
+    sch = scheduler.Scheduler(
+        mock_driver(init=init),
+        realizations,
+        max_running=1,
+        predictive_scheduling=True,
+    )
+
+    assert await sch.execute() == Id.ENSEMBLE_SUCCEEDED
+    # Realization 3 has no observed usage, and is expected to run for the
+    # average runtime of the others
+    assert submitted == [1, 2, 3, 0]
+    assert [real.realization_memory for real in realizations] == [
+        int(1.25 * gigabyte),
+        int(2.5 * gigabyte),
+        8 * gigabyte,
+        8 * gigabyte,
+    ]
+
+
 @pytest.mark.integration_test
 @pytest.mark.timeout(6)
 async def test_max_runtime_while_killing(realization, mock_driver):
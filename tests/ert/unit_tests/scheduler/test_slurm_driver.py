@@ -84,6 +84,28 @@ async def test_submit_sets_out():
     )
 
 
+@pytest.mark.usefixtures("capturing_sbatch")
+async def test_that_concurrent_submits_are_submitted_as_one_job_array():
+    driver = SlurmDriver(job_arrays=True)
+    await asyncio.gather(
+        *(driver.submit(iens, "sleep", name=f"job{iens}") for iens in range(3))
+    )
+    sbatch_args = Path("captured_sbatch_args").read_text(encoding="utf-8")
+    assert "--array=0-2" in sbatch_args
+    assert "--output=/dev/null" in sbatch_args
+    assert driver._iens2jobid == {0: "1_0", 1: "1_1", 2: "1_2"}
+
+
+@pytest.mark.usefixtures("capturing_sbatch")
+async def test_that_a_single_submit_with_job_arrays_is_not_an_array():
+    driver = SlurmDriver(job_arrays=True)
+    await driver.submit(0, "sleep", name="myjobname")
+    sbatch_args = Path("captured_sbatch_args").read_text(encoding="utf-8")
+    assert "--array" not in sbatch_args
+    assert "--output=myjobname.stdout" in sbatch_args
+    assert driver._iens2jobid == {0: "1"}
+
+
 @pytest.mark.usefixtures("capturing_sbatch")
 @given(num_cpu=st.integers(min_value=1))
 async def test_numcpu_sets_ntasks(num_cpu):
@@ -281,6 +303,37 @@ async def test_slurm_stdout_file(tmp_path, job_name):
     assert "yay" in slurm_stdout
 
 
+async def test_slurm_job_array_elements_run_in_their_own_runpath(tmp_path):
+    driver = SlurmDriver(job_arrays=True)
+    for iens in range(3):
+        (tmp_path / str(iens)).mkdir()
+    await asyncio.gather(
+        *(
+            driver.submit(
+                iens,
+                "sh",
+                "-c",
+                f"echo {iens}",
+                name=f"job{iens}",
+                runpath=tmp_path / str(iens),
+            )
+            for iens in range(3)
+        )
+    )
+    assert all("_" in job_id for job_id in driver._iens2jobid.values())
+
+    finished: dict[int, int] = {}
+
+    async def record_finished(iens, returncode):
+        finished[iens] = returncode
+
+    await poll(driver, {0, 1, 2}, finished=record_finished)
+    assert finished == {0: 0, 1: 0, 2: 0}
+    for iens in range(3):
+        stdout = tmp_path / str(iens) / f"job{iens}.stdout"
+        assert stdout.read_text(encoding="utf-8").strip() == str(iens)
+
+
 async def test_slurm_dumps_stderr_to_file(tmp_path, job_name):
     os.chdir(tmp_path)
     driver = SlurmDriver()
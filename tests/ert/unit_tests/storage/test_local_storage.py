@@ -1,8 +1,10 @@
+import itertools
 import json
 import os
 import shutil
 import stat
 import tempfile
+import threading
 from dataclasses import dataclass, field
 from datetime import datetime, timedelta
 from pathlib import Path
@@ -14,6 +16,7 @@
 import numpy as np
 import orjson
 import polars as pl
+import pyarrow.parquet as pq
 import pytest
 import xarray as xr
 from hypothesis import assume, given, note, settings
@@ -35,10 +38,21 @@
 from ert.config.gen_kw_config import TransformFunctionDefinition
 from ert.config.general_observation import GenObservation
 from ert.config.observation_vector import ObsVector
-from ert.storage import ErtStorageException, LocalEnsemble, open_storage
+from ert.storage import (
+    ErtStorageException,
+    LocalEnsemble,
+    local_ensemble,
+    open_storage,
+)
+from ert.storage.ensemble_parameter_store import (
+    EnsembleParameterStore,
+    ParameterLayout,
+)
 from ert.storage.local_storage import _LOCAL_STORAGE_VERSION
+from ert.storage.migration import to10
 from ert.storage.mode import ModeError
 from ert.storage.realization_storage_state import RealizationStorageState
+from ert.storage.write_behind import WriteBehind
 from tests.ert.unit_tests.config.egrid_generator import egrids
 from tests.ert.unit_tests.config.summary_generator import summaries, summary_variables
 
@@ -197,6 +211,203 @@ def test_that_saving_empty_parameters_fails_nicely(tmp_path):
             prior.save_parameters("PARAMETER", 0, empty_data)
 
 
+def test_that_responses_are_saved_in_row_groups_sorted_by_key(tmp_path, monkeypatch):
+    monkeypatch.setattr(local_ensemble, "RESPONSE_ROW_GROUP_SIZE", 2)
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(
+            responses=[SummaryConfig(keys=["*"], input_files=["not_relevant"])]
+        )
+        ensemble = storage.create_ensemble(experiment, ensemble_size=1, name="prior")
+        keys = ["FOPR", "FGPR", "FOPR", "FWPR", "FGPR", "FOPR"]
+        ensemble.save_response(
+            "summary",
+            pl.DataFrame(
+                {
+                    "response_key": keys,
+                    "time": pl.Series(
+                        [datetime(2000, 1, i) for i in range(1, 7)]
+                    ).dt.cast_time_unit("ms"),
+                    "values": pl.Series(range(6), dtype=pl.Float32),
+                }
+            ),
+            0,
+        )
+
+        metadata = pq.read_metadata(
+            ensemble.mount_point / "realization-0" / "summary.parquet"
+        )
+        assert metadata.num_row_groups == 3
+        assert pl.read_parquet(
+            ensemble.mount_point / "realization-0" / "summary.parquet"
+        )["response_key"].to_list() == 2 * ["FGPR"] + 3 * ["FOPR"] + ["FWPR"]
+
+        key_column = metadata.schema.names.index("response_key")
+        key_ranges = [
+            (statistics.min, statistics.max)
+            for statistics in (
+                metadata.row_group(i).column(key_column).statistics
+                for i in range(metadata.num_row_groups)
+            )
+        ]
+        assert key_ranges == [("FGPR", "FGPR"), ("FOPR", "FOPR"), ("FOPR", "FWPR")]
+
+        fopr = ensemble.load_responses("FOPR", (0,), columns=["time", "values"])
+        assert fopr.columns == ["time", "values"]
+        assert fopr["values"].to_list() == [0.0, 2.0, 5.0]
+
+
+def test_that_the_row_groups_of_responses_have_disjoint_key_ranges(
+    tmp_path, monkeypatch
+):
+    monkeypatch.setattr(local_ensemble, "RESPONSE_ROW_GROUP_SIZE", 16)
+    rng = np.random.default_rng(0)
+    keys = rng.permutation(np.repeat([f"WOPR:W{i}" for i in range(50)], 10))
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(responses=[GenDataConfig(keys=["R"])])
+        ensemble = storage.create_ensemble(experiment, ensemble_size=1, name="prior")
+        ensemble.save_response(
+            "gen_data",
+            pl.DataFrame(
+                {
+                    "response_key": keys,
+                    "report_step": pl.Series(np.zeros(len(keys)), dtype=pl.UInt16),
+                    "index": pl.Series(np.arange(len(keys)), dtype=pl.UInt16),
+                    "values": pl.Series(np.arange(len(keys)), dtype=pl.Float32),
+                }
+            ),
+            0,
+        )
+        path = ensemble.mount_point / "realization-0" / "gen_data.parquet"
+
+        metadata = pq.read_metadata(path)
+        key_column = metadata.schema.names.index("response_key")
+        key_ranges = [
+            (statistics.min, statistics.max)
+            for statistics in (
+                metadata.row_group(i).column(key_column).statistics
+                for i in range(metadata.num_row_groups)
+            )
+        ]
+        assert len(key_ranges) == len(keys) // 16 + 1
+        for (_, previous_max), (next_min, _) in itertools.pairwise(key_ranges):
+            assert previous_max <= next_min
+
+        # The rows of each key keep the order they were saved in
+        responses = pl.read_parquet(path)
+        for _, group in responses.group_by("response_key", maintain_order=True):
+            assert group["index"].to_list() == sorted(group["index"].to_list())
+
+
+def test_that_ensemble_state_is_kept_in_the_state_file(tmp_path):
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(responses=[GenDataConfig(keys=["R1"])])
+        ensemble = storage.create_ensemble(experiment, ensemble_size=3, name="prior")
+        ensemble.save_response(
+            "gen_data",
+            pl.DataFrame(
+                {
+                    "response_key": ["R1"],
+                    "report_step": pl.Series([0], dtype=pl.UInt16),
+                    "index": pl.Series([0], dtype=pl.UInt16),
+                    "values": pl.Series([1.0], dtype=pl.Float32),
+                }
+            ),
+            1,
+        )
+        ensemble.set_failure(2, RealizationStorageState.LOAD_FAILURE, "failed")
+        expected_state = [
+            {RealizationStorageState.PARAMETERS_LOADED},
+            {
+                RealizationStorageState.PARAMETERS_LOADED,
+                RealizationStorageState.RESPONSES_LOADED,
+            },
+            {
+                RealizationStorageState.PARAMETERS_LOADED,
+                RealizationStorageState.LOAD_FAILURE,
+            },
+        ]
+        assert ensemble.get_ensemble_state() == expected_state
+
+    with open_storage(tmp_path, mode="r") as storage:
+        ensemble = storage.get_ensemble(ensemble.id)
+        with patch.object(Path, "exists", side_effect=AssertionError("probed")):
+            ensemble.refresh_ensemble_state()
+            assert ensemble.get_ensemble_state() == expected_state
+        assert ensemble.has_data() == [1]
+
+    # Ensembles saved without a state file have their state recreated
+    (ensemble.mount_point / "state.json").unlink()
+    with open_storage(tmp_path, mode="w") as storage:
+        ensemble = storage.get_ensemble(ensemble.id)
+        assert ensemble.get_ensemble_state() == expected_state
+        assert (ensemble.mount_point / "state.json").exists()
+
+
+@pytest.mark.parametrize("write_behind", [True, False])
+def test_that_the_state_file_is_written_once_per_write_behind_context(
+    tmp_path, monkeypatch, write_behind
+):
+    monkeypatch.setenv("ERT_STORAGE_WRITE_BEHIND", "1" if write_behind else "0")
+    def gen_data(value):
+        return pl.DataFrame(
+            {
+                "response_key": ["R1"],
+                "report_step": pl.Series([0], dtype=pl.UInt16),
+                "index": pl.Series([0], dtype=pl.UInt16),
+                "values": pl.Series([value], dtype=pl.Float32),
+            }
+        )
+
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(responses=[GenDataConfig(keys=["R1"])])
+        ensemble = storage.create_ensemble(experiment, ensemble_size=3, name="prior")
+        state_file = ensemble.mount_point / "state.json"
+        with patch.object(
+            storage,
+            "_ordered_write_transaction",
+            wraps=storage._ordered_write_transaction,
+        ) as write:
+            with storage.write_behind_context():
+                for realization in range(3):
+                    ensemble.save_response("gen_data", gen_data(1.0), realization)
+                assert write.call_count == 0
+                # Until it is written, the state is probed by other processes
+                assert not state_file.exists()
+                assert ensemble.has_data() == [0, 1, 2]
+            assert write.call_count == 1
+
+        assert orjson.loads(state_file.read_bytes())["responses"] == {
+            "gen_data": [0, 1, 2]
+        }
+        ensemble.set_failure(0, RealizationStorageState.LOAD_FAILURE, "failed")
+        assert orjson.loads(state_file.read_bytes())["failures"] == {
+            "0": RealizationStorageState.LOAD_FAILURE.value
+        }
+
+
+def test_that_each_ensemble_has_its_own_state_lock(tmp_path):
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment()
+        first = storage.create_ensemble(experiment, ensemble_size=1, name="first")
+        second = storage.create_ensemble(experiment, ensemble_size=1, name="second")
+        first_lock = storage._ensemble_state_lock(first.id)
+        assert first_lock is storage._ensemble_state_lock(first.id)
+        assert first_lock is not storage._ensemble_state_lock(second.id)
+
+        saved = threading.Event()
+
+        def save_failure():
+            second.set_failure(0, RealizationStorageState.LOAD_FAILURE)
+            saved.set()
+
+        with first_lock:
+            thread = threading.Thread(target=save_failure)
+            thread.start()
+            assert saved.wait(timeout=10)
+        thread.join()
+        assert second.has_failure(0)
+
+
 def test_that_loading_parameter_via_response_api_fails(tmp_path):
     uniform_parameter = GenKwConfig(
         name="PARAMETER",
@@ -254,6 +465,288 @@ def test_that_load_parameters_throws_exception(tmp_path):
             ensemble.load_parameters("I_DONT_EXIST", 1)
 
 
+@pytest.mark.parametrize("layout", list(ParameterLayout))
+def test_that_parameters_round_trip_in_both_layouts(tmp_path, layout):
+    parameter = GenKwConfig(
+        name="PARAMETER",
+        forward_init=False,
+        template_file="",
+        transform_function_definitions=[
+            TransformFunctionDefinition("KEY1", "UNIFORM", [0, 1]),
+            TransformFunctionDefinition("KEY2", "UNIFORM", [0, 1]),
+        ],
+        output_file="kw.txt",
+        update=True,
+    )
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(parameters=[parameter])
+        prior = storage.create_ensemble(
+            experiment, ensemble_size=4, name="prior", parameter_layout=layout
+        )
+        assert prior.parameter_layout == layout
+
+        for realization in [0, 1, 3]:
+            parameter.save_parameters(
+                prior, realization, np.array([realization, -realization], dtype=float)
+            )
+
+        assert prior.is_initalized() == [0, 1, 3]
+        assert prior.get_parameter_state(2) == {
+            "PARAMETER": RealizationStorageState.UNDEFINED
+        }
+        assert (
+            prior.load_parameters("PARAMETER", 3)["names"].values.tolist()
+            == ["KEY1", "KEY2"]
+        )
+        np.testing.assert_equal(
+            parameter.load_parameters(prior, np.array([0, 1, 3])),
+            [[0.0, 1.0, 3.0], [0.0, -1.0, -3.0]],
+        )
+        assert prior.load_parameters("PARAMETER")[
+            "realizations"
+        ].values.tolist() == [0, 1, 3]
+        with pytest.raises(KeyError, match="realization 2"):
+            prior.load_parameters("PARAMETER", 2)
+
+        posterior = storage.create_ensemble(
+            experiment, ensemble_size=4, name="posterior", prior_ensemble=prior
+        )
+        assert posterior.parameter_layout == layout
+
+    with open_storage(tmp_path, mode="r") as storage:
+        prior = storage.get_ensemble(prior.id)
+        assert prior.parameter_layout == layout
+        np.testing.assert_equal(
+            parameter.load_parameters(prior, np.array([1])), [[1.0], [-1.0]]
+        )
+
+
+def test_that_ensemble_layout_keeps_non_numeric_parameters_per_realization(
+    tmp_path,
+):
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(
+            parameters=[
+                GenKwConfig(
+                    name="DESIGN_MATRIX",
+                    forward_init=False,
+                    template_file=None,
+                    output_file=None,
+                    transform_function_definitions=[],
+                    update=False,
+                )
+            ]
+        )
+        ensemble = storage.create_ensemble(
+            experiment,
+            ensemble_size=1,
+            name="prior",
+            parameter_layout=ParameterLayout.ENSEMBLE,
+        )
+        ensemble.save_parameters(
+            "DESIGN_MATRIX",
+            0,
+            xr.Dataset(
+                {
+                    "values": ("names", ["a"]),
+                    "transformed_values": ("names", ["a"]),
+                    "names": ["KEY"],
+                }
+            ),
+        )
+        assert (ensemble.mount_point / "realization-0" / "DESIGN_MATRIX.nc").exists()
+        assert ensemble.load_parameters("DESIGN_MATRIX", 0)[
+            "values"
+        ].values.tolist() == ["a"]
+
+
+def test_default_parameter_layout_is_read_from_environment(tmp_path, monkeypatch):
+    monkeypatch.setenv("ERT_STORAGE_PARAMETER_LAYOUT", "ENSEMBLE")
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment()
+        ensemble = storage.create_ensemble(experiment, name="foo", ensemble_size=1)
+        assert ensemble.parameter_layout == ParameterLayout.ENSEMBLE
+
+
+def test_that_migrating_with_an_unknown_parameter_layout_uses_the_default(
+    tmp_path, monkeypatch, caplog
+):
+    monkeypatch.setenv("ERT_STORAGE_PARAMETER_LAYOUT", "unknown")
+    ensemble = tmp_path / "ensembles" / "foo"
+    ensemble.mkdir(parents=True)
+    (ensemble / "index.json").write_text(
+        json.dumps({"experiment_id": "bar", "ensemble_size": 1}), encoding="utf-8"
+    )
+    to10.migrate(tmp_path)
+    index = json.loads((ensemble / "index.json").read_text(encoding="utf-8"))
+    assert index["parameter_layout"] == ParameterLayout.REALIZATION
+    assert "Unknown ERT_STORAGE_PARAMETER_LAYOUT 'unknown'" in caplog.text
+
+
+def test_that_overwritten_parameters_stay_saved_in_the_ensemble_layout(tmp_path):
+    store = EnsembleParameterStore(tmp_path / "parameters", 3, tmp_path / "swp")
+    for value in [1.0, 2.0]:
+        store.save("GROUP", 1, xr.Dataset({"values": ("x", np.full(2, value))}))
+        assert store.has_realization("GROUP", 1)
+    assert not store.has_realization("GROUP", 0)
+    assert store.realization_mask("GROUP").tolist() == [False, True, False]
+    np.testing.assert_equal(
+        store.load("GROUP", np.array([1]))["values"].values, [[2.0, 2.0]]
+    )
+
+
+def test_that_writes_behind_are_on_disk_when_the_context_exits(
+    tmp_path, monkeypatch
+):
+    monkeypatch.setenv("ERT_STORAGE_WRITE_BEHIND", "1")
+    parameter = GenKwConfig(
+        name="PARAMETER",
+        forward_init=False,
+        template_file="",
+        transform_function_definitions=[
+            TransformFunctionDefinition("KEY1", "UNIFORM", [0, 1]),
+        ],
+        output_file="kw.txt",
+        update=True,
+    )
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(parameters=[parameter])
+        ensemble = storage.create_ensemble(experiment, name="foo", ensemble_size=3)
+        with storage.write_behind_context():
+            for realization in range(3):
+                parameter.save_parameters(
+                    ensemble, realization, np.array([float(realization)])
+                )
+            for value in range(10):
+                ensemble.save_observation_scaling_factors(
+                    pl.DataFrame({"value": [value]})
+                )
+            with storage.write_behind_context():
+                pass
+            assert storage._writer is not None
+
+        assert storage._writer is None
+        assert ensemble.is_initalized() == [0, 1, 2]
+        np.testing.assert_equal(
+            parameter.load_parameters(ensemble, np.array([0, 1, 2])),
+            [[0.0, 1.0, 2.0]],
+        )
+        assert ensemble.load_observation_scaling_factors()["value"].to_list() == [9]
+        assert not list((storage.path / "swp").iterdir())
+
+
+def test_that_state_files_are_on_disk_when_writes_behind_are_flushed(
+    tmp_path, monkeypatch
+):
+    monkeypatch.setenv("ERT_STORAGE_WRITE_BEHIND", "1")
+    with open_storage(tmp_path, mode="w") as storage:
+        ensemble = storage.create_experiment(
+            responses=[GenDataConfig(keys=["WOPR"])]
+        ).create_ensemble(name="foo", ensemble_size=1)
+        with storage.write_behind_context():
+            ensemble.save_response(
+                "gen_data",
+                pl.DataFrame(
+                    {
+                        "response_key": ["WOPR"],
+                        "report_step": pl.Series([0], dtype=pl.UInt16),
+                        "index": pl.Series([0], dtype=pl.UInt16),
+                        "values": pl.Series([1.0], dtype=pl.Float32),
+                    }
+                ),
+                0,
+            )
+            assert not (ensemble.mount_point / "state.json").exists()
+            storage.flush()
+            state = json.loads((ensemble.mount_point / "state.json").read_text())
+            assert state["responses"] == {"gen_data": [0]}
+
+
+def test_that_write_behind_errors_are_raised_on_flush(tmp_path):
+    writer = WriteBehind(tmp_path / "swp")
+    writer.write(tmp_path / "missing" / "file", b"data")
+    writer.write(tmp_path / "file", b"data")
+    with pytest.raises(FileNotFoundError):
+        writer.flush()
+    assert (tmp_path / "file").read_bytes() == b"data"
+    writer.flush()
+    writer.close()
+    assert not list((tmp_path / "swp").iterdir())
+
+
+def test_that_writes_after_a_failed_write_in_a_batch_are_not_put_in_place(
+    tmp_path,
+):
+    writer = WriteBehind(tmp_path / "swp")
+    writer._write_batch(
+        [
+            (tmp_path / "before", b"data"),
+            (tmp_path / "failed", "not bytes"),
+            (tmp_path / "after", b"data"),
+        ]
+    )
+    with pytest.raises(TypeError):
+        writer.flush()
+    assert (tmp_path / "before").read_bytes() == b"data"
+    assert not (tmp_path / "failed").exists()
+    assert not (tmp_path / "after").exists()
+    writer.close()
+    assert not list((tmp_path / "swp").iterdir())
+
+
+def test_that_write_behind_errors_do_not_replace_the_error_of_the_context(
+    tmp_path, monkeypatch
+):
+    monkeypatch.setenv("ERT_STORAGE_WRITE_BEHIND", "1")
+    with open_storage(tmp_path, mode="w") as storage:
+        ensemble = storage.create_experiment().create_ensemble(
+            name="foo", ensemble_size=1
+        )
+        with (
+            pytest.raises(ValueError, match="error in the context"),
+            storage.write_behind_context(),
+        ):
+            assert storage._writer is not None
+            storage._writer.write(tmp_path / "missing" / "file", b"data")
+            ensemble.save_observation_scaling_factors(pl.DataFrame({"value": [1]}))
+            raise ValueError("error in the context")
+        assert storage._writer is None
+
+
+def test_that_sparse_cross_correlations_are_loaded_across_batches(tmp_path):
+    with open_storage(tmp_path, mode="w") as storage:
+        ensemble = storage.create_experiment().create_ensemble(
+            name="prior", ensemble_size=5
+        )
+        with pytest.raises(FileNotFoundError, match="STREAMING_LOCALIZATION"):
+            ensemble.load_sparse_cross_correlations("COEFFS")
+
+        for batch, (parameter, parameter_index) in enumerate([("a", 0), ("b", 1)]):
+            ensemble.save_sparse_cross_correlations(
+                "COEFFS",
+                batch,
+                pl.DataFrame(
+                    {
+                        "parameter_index": pl.Series(
+                            [parameter_index, parameter_index], dtype=pl.UInt32
+                        ),
+                        "parameter": [parameter, parameter],
+                        "observation_key": ["OBS1", "OBS2"],
+                        "index": ["0", "1"],
+                        "correlation": pl.Series([0.5, -0.9], dtype=pl.Float32),
+                    }
+                ),
+            )
+
+        assert len(ensemble.load_sparse_cross_correlations("COEFFS")) == 4
+        assert ensemble.load_sparse_cross_correlations(
+            "COEFFS", parameters=["b"]
+        )["parameter_index"].to_list() == [1, 1]
+        assert ensemble.load_sparse_cross_correlations(
+            "COEFFS", parameters=[0], observations=["OBS2"]
+        )["correlation"].to_list() == pytest.approx([-0.9])
+
+
 def test_open_empty_read(tmp_path):
     with open_storage(tmp_path / "empty", mode="r") as storage:
         assert _ensembles(storage) == []
@@ -740,6 +1233,65 @@ def test_asof_joining_summary(tmp_path, perturb_observations, perturb_responses)
         )
 
 
+@pytest.mark.parametrize("realization_chunk_size", [1, 2, 100])
+def test_that_observations_and_responses_are_aligned_in_chunks(
+    tmp_path, realization_chunk_size
+):
+    gen_data_observations = pl.DataFrame(
+        {
+            "observation_key": ["OBS1", "OBS1", "OBS2"],
+            "response_key": ["R1", "R1", "R2"],
+            "report_step": pl.Series([0, 0, 1], dtype=pl.UInt16),
+            "index": pl.Series([0, 1, 0], dtype=pl.UInt16),
+            "observations": pl.Series([1.0, 2.0, 3.0], dtype=pl.Float32),
+            "std": pl.Series([0.1, 0.2, 0.3], dtype=pl.Float32),
+        }
+    )
+    with open_storage(tmp_path, mode="w") as storage:
+        experiment = storage.create_experiment(
+            responses=[GenDataConfig(keys=["R1", "R2"], report_steps_list=[[0], [1]])],
+            observations={"gen_data": gen_data_observations},
+        )
+        ensemble = storage.create_ensemble(experiment, ensemble_size=5, name="prior")
+        for realization in range(5):
+            ensemble.save_response(
+                "gen_data",
+                pl.DataFrame(
+                    {
+                        "response_key": ["R1", "R1", "R1", "R2"],
+                        "report_step": pl.Series([0, 0, 0, 1], dtype=pl.UInt16),
+                        "index": pl.Series([0, 1, 2, 0], dtype=pl.UInt16),
+                        "values": pl.Series(
+                            np.array([1.0, 2.0, 3.0, 4.0]) * realization,
+                            dtype=pl.Float32,
+                        ),
+                    }
+                ),
+                realization,
+            )
+
+        active = np.array([4, 0, 2, 3])
+        aligned = ensemble.get_observations_and_responses(
+            ["OBS1", "OBS2"], active, realization_chunk_size=realization_chunk_size
+        )
+        assert aligned.columns == [
+            "response_key",
+            "index",
+            "observation_key",
+            "observations",
+            "std",
+            "0",
+            "2",
+            "3",
+            "4",
+        ]
+        assert aligned["index"].to_list() == ["0, 0", "0, 1", "1, 0"]
+        np.testing.assert_equal(
+            aligned.select(aligned.columns[5:]).to_numpy(),
+            np.outer([1.0, 2.0, 4.0], [0, 2, 3, 4]),
+        )
+
+
 def test_saving_everest_metadata_to_ensemble(tmp_path):
     with open_storage(tmp_path, mode="w") as storage:
         experiment = storage.create_experiment(
@@ -1192,7 +1744,10 @@ def save_summary(self, model_ensemble: Ensemble, data):
             raise AssertionError() from e
         storage_ensemble.save_response(summary.response_type, ds, self.iens_to_edit)
 
-        model_ensemble.response_values[summary.name] = ds
+        # Responses are stored sorted by response key
+        model_ensemble.response_values[summary.name] = ds.sort(
+            "response_key", maintain_order=True
+        )
 
         model_experiment = self.model[storage_experiment.id]
         response_keys = set(ds["response_key"].unique())
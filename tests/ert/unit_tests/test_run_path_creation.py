@@ -9,6 +9,7 @@
 import pytest
 import xtgeo
 
+from ert import enkf_main
 from ert.callbacks import forward_model_ok
 from ert.config import (
     ConfigValidationError,
@@ -21,6 +22,7 @@
 from ert.load_status import LoadStatus
 from ert.run_arg import create_run_arguments
 from ert.runpaths import Runpaths
+from ert.trace import trace, tracer
 from tests.ert.unit_tests.config.egrid_generator import simple_grid
 from tests.ert.unit_tests.config.summary_generator import simple_smspec, simple_unsmry
 
@@ -99,6 +101,18 @@ def test_jobs_json_is_backed_up(make_run_path):
     )
 
 
+@pytest.mark.usefixtures("use_tmpdir")
+def test_that_jobs_json_continues_the_trace_of_the_caller(make_run_path):
+    ert_config = ErtConfig.from_file_contents(config_contents.format(parameters=""))
+    with tracer.start_as_current_span("test") as span:
+        make_run_path(ert_config)
+    jobs = orjson.loads(
+        Path("simulations/realization-0/iter-0/jobs.json").read_bytes()
+    )
+    trace_id = trace.format_trace_id(span.get_span_context().trace_id)
+    assert trace_id in jobs["global_environment"]["TRACEPARENT"]
+
+
 @pytest.mark.usefixtures("use_tmpdir")
 def test_that_run_template_replace_symlink_does_not_write_to_source(
     prior_ensemble, run_args, run_paths
@@ -494,6 +508,146 @@ def test_write_runpath_file(storage, itr, run_paths):
     assert list(exp_runpaths) == list(dumped_runpaths)
 
 
+@pytest.mark.usefixtures("use_tmpdir")
+@pytest.mark.parametrize("compact_jobs_json", [True, False])
+def test_templates_are_read_once_for_all_realizations(
+    storage, run_paths, monkeypatch, compact_jobs_json
+):
+    Path("shared.tmpl").write_text("case: <CASE>", encoding="utf-8")
+    Path("per_real.tmpl").write_text("<CASE> <IENS>", encoding="utf-8")
+    ert_config = ErtConfig.from_file_contents(
+        dedent(
+            """            NUM_REALIZATIONS 4
+            DEFINE <CASE> my_case
+            RUN_TEMPLATE shared.tmpl shared.txt
+            RUN_TEMPLATE per_real.tmpl <IENS>.txt
+            """
+        )
+    )
+    prior_ensemble = storage.create_ensemble(
+        storage.create_experiment(), name="prior", ensemble_size=4
+    )
+    run_path = run_paths(ert_config)
+    run_args = create_run_arguments(run_path, [True, False, True, True], prior_ensemble)
+
+    read_files = []
+    read_text = Path.read_text
+
+    def counting_read_text(self, *args, **kwargs):
+        read_files.append(self.name)
+        return read_text(self, *args, **kwargs)
+
+    monkeypatch.setattr(Path, "read_text", counting_read_text)
+    ready = []
+    create_run_path(
+        run_args=run_args,
+        ensemble=prior_ensemble,
+        user_config_file=ert_config.user_config_file,
+        env_vars=ert_config.env_vars,
+        env_pr_fm_step=ert_config.env_pr_fm_step,
+        forward_model_steps=ert_config.forward_model_steps,
+        substitutions=ert_config.substitutions,
+        templates=ert_config.ert_templates,
+        parameters_file="parameters",
+        runpaths=run_path,
+        compact_jobs_json=compact_jobs_json,
+        on_runpath_ready=ready.append,
+    )
+    monkeypatch.undo()
+
+    assert sorted(read_files) == ["per_real.tmpl", "shared.tmpl"]
+    assert sorted(ready) == [0, 2, 3]
+    assert not Path(run_args[1].runpath).exists()
+    for run_arg in run_args[2:]:
+        runpath = Path(run_arg.runpath)
+        assert (runpath / "shared.txt").read_text() == "case: my_case"
+        assert (runpath / f"{run_arg.iens}.txt").read_text() == (
+            f"my_case {run_arg.iens}"
+        )
+        jobs_json = (runpath / "jobs.json").read_bytes()
+        assert (b"\n" not in jobs_json) == compact_jobs_json
+        assert orjson.loads(jobs_json)["run_id"] == run_arg.run_id
+
+
+@pytest.mark.usefixtures("use_tmpdir")
+@pytest.mark.parametrize(
+    "batch_size, max_workers, expected_batches",
+    [
+        (2, None, [[0, 1], [2, 3], [4]]),
+        (2, 1, [[0, 1], [2, 3], [4]]),
+        (None, 5, [[0], [1], [2], [3], [4]]),
+        (None, 2, [[0, 1, 2], [3, 4]]),
+    ],
+)
+def test_parameters_are_loaded_once_per_batch_of_realizations(
+    storage, run_paths, monkeypatch, batch_size, max_workers, expected_batches
+):
+    Path("template.txt").write_text("MY_KEYWORD <MY_KEYWORD>", encoding="utf-8")
+    Path("prior.txt").write_text("MY_KEYWORD NORMAL 0 1", encoding="utf-8")
+    ert_config = ErtConfig.from_file_contents(
+        dedent(
+            """            NUM_REALIZATIONS 5
+            GEN_KW KW_NAME template.txt kw.txt prior.txt
+            """
+        )
+    )
+    prior_ensemble = storage.create_ensemble(
+        storage.create_experiment(
+            parameters=ert_config.ensemble_config.parameter_configuration
+        ),
+        name="prior",
+        ensemble_size=5,
+    )
+    sample_prior(prior_ensemble, range(5))
+    run_path = run_paths(ert_config)
+    run_args = create_run_arguments(run_path, [True] * 5, prior_ensemble)
+
+    loaded = []
+    load_parameters = prior_ensemble.load_parameters
+
+    def counting_load_parameters(group, realizations=None):
+        loaded.append(np.atleast_1d(realizations).tolist())
+        return load_parameters(group, realizations)
+
+    monkeypatch.setattr(prior_ensemble, "load_parameters", counting_load_parameters)
+    create_run_path(
+        run_args=run_args,
+        ensemble=prior_ensemble,
+        user_config_file=ert_config.user_config_file,
+        env_vars=ert_config.env_vars,
+        env_pr_fm_step=ert_config.env_pr_fm_step,
+        forward_model_steps=ert_config.forward_model_steps,
+        substitutions=ert_config.substitutions,
+        templates=ert_config.ert_templates,
+        parameters_file="parameters",
+        runpaths=run_path,
+        max_workers=max_workers,
+        batch_size=batch_size,
+    )
+    monkeypatch.undo()
+
+    assert sorted(loaded) == expected_batches
+    values = prior_ensemble.load_parameters("KW_NAME")["transformed_values"].values
+    for run_arg in run_args:
+        runpath = Path(run_arg.runpath)
+        value = values[run_arg.iens, 0]
+        assert (runpath / "kw.txt").read_text() == f"MY_KEYWORD {value:.6g}"
+        assert orjson.loads((runpath / "parameters.json").read_bytes()) == {
+            "KW_NAME": {"MY_KEYWORD": pytest.approx(value)}
+        }
+
+
+@pytest.mark.parametrize(
+    "num_realizations, max_workers, expected",
+    [(0, 4, 1), (5, 4, 2), (200, 4, 50), (10_000, 32, enkf_main.RUNPATH_BATCH_SIZE)],
+)
+def test_that_runpath_batches_are_spread_over_the_workers_up_to_a_cap(
+    num_realizations, max_workers, expected
+):
+    batch_size = enkf_main._runpath_batch_size(num_realizations, max_workers)
+    assert batch_size == expected
+
+
 @pytest.mark.usefixtures("use_tmpdir")
 def test_assert_export(make_run_path):
     ert_config = ErtConfig.from_file_contents(
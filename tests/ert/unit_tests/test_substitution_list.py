@@ -5,7 +5,7 @@
 
 from ert.config import ErtConfig
 from ert.config.parsing import ConfigKeys
-from ert.substitutions import Substitutions
+from ert.substitutions import Substitutions, has_substitution_keys
 
 from .config.config_dict_generator import config_generators
 
@@ -73,3 +73,38 @@ def test_substitutions():
     assert subst_list.get("nosuchkey") is None
     assert subst_list.get(513) is None
     assert subst_list == {"<Key>": "Value", "<Key2>": "Value2"}
+
+
+@pytest.mark.parametrize(
+    "template",
+    [
+        "<IENS>-<ITER>",
+        "<GEO_ID>/<A>",
+        "<A>:<B>",
+        "<C><IENS>",
+        "no keys",
+        "<UNKNOWN>",
+    ],
+)
+@pytest.mark.parametrize("realization, iteration", [(0, 0), (3, 1)])
+def test_substituting_without_real_iter_first_gives_the_same_result(
+    template, realization, iteration
+):
+    substitutions = Substitutions(
+        {
+            "<A>": "a<IENS>",
+            "<B>": "<A>b",
+            "<C>": "<",
+            "<IENS>": "user_defined",
+            f"<GEO_ID_{realization}_{iteration}>": "geo",
+        }
+    )
+    shared = substitutions.without_real_iter().substitute(template)
+    assert substitutions.substitute_real_iter(
+        shared, realization, iteration
+    ) == substitutions.substitute_real_iter(template, realization, iteration)
+
+
+def test_has_substitution_keys():
+    assert has_substitution_keys("a <KEY> b")
+    assert not has_substitution_keys("a < KEY b")
@@ -0,0 +1,88 @@
+import polars as pl
+from polars.testing import assert_frame_equal
+
+from everest.everest_storage import (
+    BatchStorageData,
+    BatchTable,
+    OptimizationStorageData,
+)
+
+
+def _batch_objectives(batch_id):
+    return pl.DataFrame(
+        {
+            "batch_id": pl.Series([batch_id], dtype=pl.UInt32),
+            "total_objective_value": pl.Series([float(batch_id)], dtype=pl.Float64),
+        }
+    )
+
+
+def test_that_batch_tables_read_the_batches_added_since_the_last_read(tmp_path):
+    writer = BatchTable(tmp_path / "batch_objectives")
+    reader = BatchTable(tmp_path / "batch_objectives")
+    for batch_id in range(3):
+        writer.append(batch_id, _batch_objectives(batch_id))
+
+    assert reader.batch_ids() == [0, 1, 2]
+    assert_frame_equal(reader.read(1), _batch_objectives(1))
+    assert set(reader._partitions) == {1}
+
+    writer.append(3, _batch_objectives(3))
+    assert_frame_equal(reader.read(3), _batch_objectives(3))
+    assert reader.read(4) is None
+    assert not reader.has_batch(4)
+
+
+def test_that_batch_tables_can_be_queried_for_a_slice_of_the_batches(tmp_path):
+    table = BatchTable(tmp_path / "batch_objectives")
+    assert table.scan() is None
+    for batch_id in range(5):
+        table.append(batch_id, _batch_objectives(batch_id))
+
+    assert (
+        table.scan([1, 3, 7])
+        .filter(pl.col("total_objective_value") > 1)
+        .collect()["batch_id"]
+        .to_list()
+    ) == [3]
+    assert table.scan().collect()["batch_id"].to_list() == [0, 1, 2, 3, 4]
+
+
+def test_that_batch_tables_keep_a_bounded_number_of_partitions_in_memory(
+    tmp_path, monkeypatch
+):
+    monkeypatch.setattr(BatchTable, "MAX_CACHED_PARTITIONS", 2)
+    table = BatchTable(tmp_path / "batch_objectives")
+    for batch_id in range(4):
+        table.append(batch_id, _batch_objectives(batch_id))
+    assert list(table._partitions) == [2, 3]
+
+    assert_frame_equal(table.read(0), _batch_objectives(0))
+    assert list(table._partitions) == [3, 0]
+    table.read(3)
+    assert list(table._partitions) == [0, 3]
+    assert_frame_equal(table.read_all(), pl.concat(map(_batch_objectives, range(4))))
+
+
+def test_that_optimization_storage_scans_batches_stored_before_batch_tables(
+    tmp_path,
+):
+    data = OptimizationStorageData(tmp_path / "optimizer")
+    for batch_id in range(3):
+        batch_dir = tmp_path / "ensembles" / f"batch_{batch_id}" / "optimizer"
+        batch_dir.mkdir(parents=True)
+        data.batches.append(BatchStorageData(batch_dir, data.tables, batch_id))
+    _batch_objectives(0).write_parquet(
+        data.batches[0]._path / "batch_objectives.parquet"
+    )
+    for batch in data.batches[1:]:
+        data.tables["batch_objectives"].append(
+            batch.batch_id, _batch_objectives(batch.batch_id)
+        )
+
+    def scanned_batch_ids(*batch_ids):
+        return data.scan("batch_objectives", *batch_ids).collect()["batch_id"]
+
+    assert scanned_batch_ids().to_list() == [0, 1, 2]
+    assert scanned_batch_ids([0, 2]).to_list() == [0, 2]
+    assert data.scan("batch_constraints") is None
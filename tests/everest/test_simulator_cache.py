@@ -1,4 +1,6 @@
+from pathlib import Path
 from queue import SimpleQueue
+from typing import Any
 
 import numpy as np
 import polars as pl
@@ -10,6 +12,7 @@
 from ert.run_models.event import EverestCacheHitEvent
 from ert.run_models.everest_run_model import EverestRunModel
 from everest.config import EverestConfig
+from everest.everest_storage import EvaluationCache
 
 
 @pytest.mark.integration_test
@@ -147,3 +150,144 @@ def test_cached_result_lookup():
             "flat_index": 4,
         },
     ]
+
+
+def _simulation_results(batch, distances):
+    return pl.DataFrame(
+        {
+            "batch": pl.Series([batch] * len(distances), dtype=pl.Int32),
+            "model_realization": pl.Series([0] * len(distances), dtype=pl.UInt16),
+            "perturbation": pl.Series([-1] * len(distances), dtype=pl.Int32),
+            "realization": pl.Series(range(len(distances)), dtype=pl.UInt16),
+            "distance": pl.Series(distances, dtype=pl.Float64),
+            "point.x": pl.Series([0.1] * len(distances), dtype=pl.Float64),
+        }
+    )
+
+
+def test_that_the_evaluation_cache_persists_results_of_the_same_config(tmp_path):
+    cache = EvaluationCache(tmp_path / "evaluation_cache", "config", "first")
+    assert cache.results() is None
+
+    cache.add(_simulation_results(0, [1.0, np.nan]))
+    cache.add(_simulation_results(1, [2.0]))
+    EvaluationCache(tmp_path / "evaluation_cache", "other config", "first").add(
+        _simulation_results(2, [3.0])
+    )
+
+    results = cache.results()
+    assert results.columns == [
+        *_simulation_results(0, []).columns,
+        "from_earlier_optimization",
+    ]
+    assert results["batch"].to_list() == [0, 1]
+    assert results["distance"].to_list() == [1.0, 2.0]
+    assert not results["from_earlier_optimization"].any()
+
+    cache_hits = EverestRunModel.find_cached_results(
+        np.array([[0.1]]), [0], results, ["point.x"]
+    )
+    assert set(cache_hits["batch"].to_list()) == {0, 1}
+
+
+def test_that_the_evaluation_cache_tells_results_of_earlier_optimizations(tmp_path):
+    EvaluationCache(tmp_path / "evaluation_cache", "config", "first").add(
+        _simulation_results(0, [1.0])
+    )
+    cache = EvaluationCache(tmp_path / "evaluation_cache", "config", "second")
+    cache.add(_simulation_results(0, [2.0]))
+
+    results = cache.results()
+    assert results["batch"].to_list() == [0, 0]
+    assert results["from_earlier_optimization"].to_list() == [True, False]
+
+
+def test_that_the_evaluation_cache_is_kept_for_changes_to_the_optimization():
+    config = EverestConfig.with_defaults()
+    config_hash = EvaluationCache.config_hash(config)
+
+    other_optimization = config.model_dump(exclude_none=True)
+    other_optimization["optimization"] = {"max_batch_num": 5}
+    assert (
+        EvaluationCache.config_hash(EverestConfig.model_validate(other_optimization))
+        == config_hash
+    )
+
+    other_model = config.model_dump(exclude_none=True)
+    other_model["model"] = {"realizations": [0, 1]}
+    assert (
+        EvaluationCache.config_hash(EverestConfig.model_validate(other_model))
+        != config_hash
+    )
+
+
+def _controls(*names: str, initial_guess: float = 0.5) -> list[dict[str, Any]]:
+    return [
+        {
+            "name": "default_group",
+            "type": "generic_control",
+            "initial_guess": initial_guess,
+            "variables": [{"name": name, "min": 0, "max": 1} for name in names],
+        }
+    ]
+
+
+@pytest.mark.parametrize(
+    "names",
+    [
+        pytest.param(("x", "y", "z"), id="added_control"),
+        pytest.param(("x", "w"), id="renamed_control"),
+        pytest.param(("x",), id="removed_control"),
+    ],
+)
+def test_that_the_evaluation_cache_is_not_shared_by_configs_with_other_controls(
+    names,
+):
+    config = EverestConfig.with_defaults(controls=_controls("x", "y"))
+    other_config = EverestConfig.with_defaults(controls=_controls(*names))
+    assert EvaluationCache.config_hash(other_config) != EvaluationCache.config_hash(
+        config
+    )
+
+
+def test_that_the_evaluation_cache_is_kept_for_a_new_initial_guess():
+    config = EverestConfig.with_defaults(controls=_controls("x", "y"))
+    other_config = EverestConfig.with_defaults(
+        controls=_controls("x", "y", initial_guess=0.25)
+    )
+    assert EvaluationCache.config_hash(other_config) == EvaluationCache.config_hash(
+        config
+    )
+
+
+def test_that_the_evaluation_cache_is_invalidated_by_changed_installed_files(
+    tmp_path, monkeypatch
+):
+    monkeypatch.chdir(tmp_path)
+    Path("data_0").mkdir()
+    Path("data_0/input.txt").write_text("1", encoding="utf-8")
+    Path("template.tmpl").write_text("{{ x }}", encoding="utf-8")
+    Path("jobs").mkdir()
+    Path("jobs/SCRIPT").write_text("EXECUTABLE script.py\n", encoding="utf-8")
+    Path("jobs/script.py").write_text("print(1)", encoding="utf-8")
+    config_dict = EverestConfig.with_defaults().model_dump(exclude_none=True)
+    config_dict["model"] = {"realizations": [0]}
+    config_dict["install_data"] = [{"source": "data_<GEO_ID>", "target": "data"}]
+    config_dict["install_templates"] = [
+        {"template": "template.tmpl", "output_file": "out.txt"}
+    ]
+    config_dict["install_jobs"] = [{"name": "script", "source": "jobs/SCRIPT"}]
+    config = EverestConfig.model_validate(config_dict)
+    config_hash = EvaluationCache.config_hash(config)
+    assert EvaluationCache.file_digests(config).keys() == {
+        "data_0",
+        "template.tmpl",
+        "jobs/SCRIPT",
+        "jobs/script.py",
+    }
+    assert EvaluationCache.config_hash(config) == config_hash
+
+    for path in ["data_0/input.txt", "template.tmpl", "jobs/script.py"]:
+        Path(path).write_text("changed", encoding="utf-8")
+        assert EvaluationCache.config_hash(config) != config_hash
+        config_hash = EvaluationCache.config_hash(config)